@@ -36,5 +36,6 @@
 #include "level_set_shape.h"
 #include "multi_polygon_shape.h"
 #include "transform_shape.h"
+#include "transformed_level_set_shape.h"
 
 #endif // ALL_GEOMETRIES_H
\ No newline at end of file
@@ -27,8 +27,6 @@ void LevelSet::initializeDataForSingularPackage(LevelSetDataPackage *data_pkg, R
     auto &phi = data_pkg->getPackageData(phi_);
     auto &near_interface_id = data_pkg->getPackageData(near_interface_id_);
     auto &phi_gradient = data_pkg->getPackageData(phi_gradient_);
-    auto &kernel_weight = data_pkg->getPackageData(kernel_weight_);
-    auto &kernel_gradient = data_pkg->getPackageData(kernel_gradient_);
 
     data_pkg->for_each_data(
         [&](int i, int j)
@@ -36,8 +34,6 @@ void LevelSet::initializeDataForSingularPackage(LevelSetDataPackage *data_pkg, R
             phi[i][j] = far_field_level_set;
             near_interface_id[i][j] = far_field_level_set < 0.0 ? -2 : 2;
             phi_gradient[i][j] = Vecd::Ones();
-            kernel_weight[i][j] = far_field_level_set < 0.0 ? 0 : 1.0;
-            kernel_gradient[i][j] = Vec2d::Zero();
         });
 }
 //=================================================================================================//
@@ -49,6 +45,8 @@ void LevelSet::finishDataPackages()
                           tagACellIsInnerPackage(Arrayi(i, j));
                       });
 
+    sortInnerDataPackages();
+
     mesh_parallel_for(MeshRange(Arrayi::Zero(), all_cells_),
                       [&](size_t i, size_t j)
                       {
@@ -56,13 +54,50 @@ void LevelSet::finishDataPackages()
                       });
 
     updateLevelSetGradient();
-    updateKernelIntegrals();
+    initializeKernelIntegrals();
+}
+//=================================================================================================//
+void LevelSet::prepareKernelIntegralsInCell(const Arrayi &cell_index)
+{
+    LevelSetDataPackage *cell_pkg = DataPackageFromCellIndex(cell_index);
+    if (!cell_pkg->isInnerPackage())
+        return;
+
+    KernelIntegralsInACell &kernel_integrals = *kernel_integrals_in_cells_.PackageFromCellIndex(cell_index);
+    tbb::collaborative_call_once(
+        *kernel_integrals.is_prepared_,
+        [&]()
+        {
+            mesh_for_each(
+                Arrayi::Zero().max(cell_index - Arrayi::Ones()),
+                all_cells_.min(cell_index + 2 * Arrayi::Ones()),
+                [&](int l, int m)
+                {
+                    LevelSetDataPackage *data_pkg = DataPackageFromCellIndex(Arrayi(l, m));
+                    if (data_pkg->isInnerPackage())
+                        computeKernelIntegralsForAPackage(data_pkg);
+                });
+
+            LevelSetDataPackage *kernel_pkg = KernelIntegralPackage(cell_pkg);
+            for (int l = 0; l != pkg_addrs_size; ++l)
+                for (int m = 0; m != pkg_addrs_size; ++m)
+                {
+                    std::pair<int, int> x_pair = CellShiftAndDataIndex(l);
+                    std::pair<int, int> y_pair = CellShiftAndDataIndex(m);
+                    Arrayi neighbor_cell = cell_index + Arrayi(x_pair.first, y_pair.first);
+
+                    kernel_pkg->assignPackageDataAddress(
+                        Arrayi(l, m),
+                        KernelIntegralPackage(DataPackageFromCellIndex(neighbor_cell)),
+                        Arrayi(x_pair.second, y_pair.second));
+                }
+        });
 }
 //=================================================================================================//
 bool LevelSet::isWithinCorePackage(Vecd position)
 {
     Arrayi cell_index = CellIndexFromPosition(position);
-    return data_pkg_addrs_[cell_index[0]][cell_index[1]]->isCorePackage();
+    return DataPackageFromCellIndex(cell_index)->isCorePackage();
 }
 //=============================================================================================//
 bool LevelSet::isInnerPackage(const Arrayi &cell_index)
@@ -72,7 +107,7 @@ bool LevelSet::isInnerPackage(const Arrayi &cell_index)
         all_cells_.min(cell_index + 2 * Array2i::Ones()),
         [&](int l, int m)
         {
-            return data_pkg_addrs_[l][m]->isCorePackage();
+            return DataPackageFromCellIndex(Arrayi(l, m))->isCorePackage();
         });
 }
 //=================================================================================================//
@@ -233,7 +268,7 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                         {
                             std::pair<int, int> x_pair = CellShiftAndDataIndex(i + x);
                             std::pair<int, int> y_pair = CellShiftAndDataIndex(j + y);
-                            LevelSetDataPackage *neighbor_pkg = data_pkg_addrs_[l + x_pair.first][m + y_pair.first];
+                            LevelSetDataPackage *neighbor_pkg = DataPackageFromCellIndex(Arrayi(l + x_pair.first, m + y_pair.first));
                             auto &neighbor_phi = neighbor_pkg->getPackageData(phi_);
                             auto &neighbor_phi_gradient = neighbor_pkg->getPackageData(phi_gradient_);
                             auto &neighbor_near_interface_id = neighbor_pkg->getPackageData(near_interface_id_);
@@ -259,7 +294,7 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                         {
                             std::pair<int, int> x_pair = CellShiftAndDataIndex(i + x);
                             std::pair<int, int> y_pair = CellShiftAndDataIndex(j + y);
-                            LevelSetDataPackage *neighbor_pkg = data_pkg_addrs_[l + x_pair.first][m + y_pair.first];
+                            LevelSetDataPackage *neighbor_pkg = DataPackageFromCellIndex(Arrayi(l + x_pair.first, m + y_pair.first));
                             auto &neighbor_phi = neighbor_pkg->getPackageData(phi_);
                             auto &neighbor_phi_gradient = neighbor_pkg->getPackageData(phi_gradient_);
                             auto &neighbor_near_interface_id = neighbor_pkg->getPackageData(near_interface_id_);
@@ -366,7 +401,7 @@ void LevelSet::writeMeshFieldToPlt(std::ofstream &output_file)
     {
         for (int i = 0; i != number_of_operation[0]; ++i)
         {
-            output_file << DataValueFromGlobalIndex(kernel_weight_, Arrayi(i, j))
+            output_file << probeKernelIntegralPackage(kernel_weight_, global_mesh_.GridPositionFromIndex(Arrayi(i, j)))
                         << " ";
         }
         output_file << " \n";
@@ -376,7 +411,7 @@ void LevelSet::writeMeshFieldToPlt(std::ofstream &output_file)
     {
         for (int i = 0; i != number_of_operation[0]; ++i)
         {
-            output_file << DataValueFromGlobalIndex(kernel_gradient_, Arrayi(i, j))[0]
+            output_file << probeKernelIntegralPackage(kernel_gradient_, global_mesh_.GridPositionFromIndex(Arrayi(i, j)))[0]
                         << " ";
         }
         output_file << " \n";
@@ -386,7 +421,7 @@ void LevelSet::writeMeshFieldToPlt(std::ofstream &output_file)
     {
         for (int i = 0; i != number_of_operation[0]; ++i)
         {
-            output_file << DataValueFromGlobalIndex(kernel_gradient_, Arrayi(i, j))[1]
+            output_file << probeKernelIntegralPackage(kernel_gradient_, global_mesh_.GridPositionFromIndex(Arrayi(i, j)))[1]
                         << " ";
         }
         output_file << " \n";
@@ -27,11 +27,13 @@ void CellLinkedList ::deleteMeshDataMatrix()
 //=================================================================================================//
 void CellLinkedList::clearCellLists()
 {
-    mesh_parallel_for(MeshRange(Array2i::Zero(), all_cells_),
+    mesh_parallel_for(active_cells_,
                       [&](int i, int j)
                       {
                           cell_index_lists_[i][j].clear();
+                          cell_data_lists_[i][j].clear();
                       });
+    active_cells_ = MeshRange(Array2i::Zero(), Array2i::Zero());
 }
 //=================================================================================================//
 void CellLinkedList::UpdateCellListData(BaseParticles &base_particles)
@@ -39,7 +41,7 @@ void CellLinkedList::UpdateCellListData(BaseParticles &base_particles)
     StdLargeVec<Vecd> &pos = base_particles.pos_;
     StdLargeVec<Real> &Vol = base_particles.Vol_;
     mesh_parallel_for(
-        MeshRange(Array2i::Zero(), all_cells_),
+        active_cells_,
         [&](int i, int j)
         {
             cell_data_lists_[i][j].clear();
@@ -57,7 +59,7 @@ void CellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
     // clear the data
     clearSplitCellLists(split_cell_lists);
     mesh_parallel_for(
-        MeshRange(Array2i::Zero(), all_cells_),
+        active_cells_,
         [&](int i, int j)
         {
             size_t real_particles_in_cell = cell_index_lists_[i][j].size();
@@ -79,6 +81,7 @@ void CellLinkedList ::InsertListDataEntry(
     size_t particle_index, const Vecd &particle_position, Real volumetric)
 {
     Array2i cellpos = CellIndexFromPosition(particle_position);
+    extendActiveCells(cellpos);
     cell_data_lists_[cellpos[0]][cellpos[1]].emplace_back(
         std::make_tuple(particle_index, particle_position, volumetric));
 }
@@ -11,42 +11,24 @@ namespace SPH
 //=================================================================================================//
 void ParticleGenerator<Lattice>::initializeGeometricVariables()
 {
-    BaseMesh mesh(domain_bounds_, lattice_spacing_, 0);
     Real particle_volume = lattice_spacing_ * lattice_spacing_;
-    Arrayi number_of_lattices = mesh.AllCellsFromAllGridPoints(mesh.AllGridPoints());
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
-        {
-            Vecd particle_position = mesh.CellPositionFromIndex(Arrayi(i, j));
-            if (initial_shape_.checkNotFar(particle_position, lattice_spacing_))
-            {
-                if (initial_shape_.checkContain(particle_position))
-                {
-                    initializePositionAndVolumetricMeasure(particle_position, particle_volume);
-                }
-            }
-        }
+    StdVec<Vecd> lattice_positions = findLatticePositionsInShape();
+    pos_.reserve(pos_.size() + lattice_positions.size());
+    Vol_.reserve(Vol_.size() + lattice_positions.size());
+    unsorted_id_.reserve(unsorted_id_.size() + lattice_positions.size());
+    for (size_t n = 0; n != lattice_positions.size(); ++n)
+    {
+        initializePositionAndVolumetricMeasure(lattice_positions[n], particle_volume);
+    }
 }
 //=================================================================================================//
 void ParticleGenerator<Surface, Lattice, ReducedOrder>::initializeGeometricVariables()
 {
     // Calculate the total volume and
     // count the number of cells inside the body volume, where we might put particles.
-    std::unique_ptr<BaseMesh> mesh(new BaseMesh(domain_bounds_, lattice_spacing_, 0));
-    Arrayi number_of_lattices = mesh->AllCellsFromAllGridPoints(mesh->AllGridPoints());
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
-        {
-            Vecd particle_position = mesh->CellPositionFromIndex(Arrayi(i, j));
-            if (initial_shape_.checkNotFar(particle_position, lattice_spacing_))
-            {
-                if (initial_shape_.checkContain(particle_position))
-                {
-                    all_cells_++;
-                    total_volume_ += lattice_spacing_ * lattice_spacing_;
-                }
-            }
-        }
+    StdVec<Vecd> lattice_positions = findLatticePositionsInShape();
+    all_cells_ = lattice_positions.size();
+    total_volume_ = Real(all_cells_) * lattice_spacing_ * lattice_spacing_;
     Real number_of_particles = total_volume_ / avg_particle_volume_ + 0.5;
     planned_number_of_particles_ = int(number_of_particles);
 
@@ -60,24 +42,17 @@ void ParticleGenerator<Surface, Lattice, ReducedOrder>::initializeGeometricVaria
     std::uniform_real_distribution<Real> unif(0, 1);
 
     // Add a particle in each interval, randomly. We will skip the last intervals if we already reach the number of particles
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
+    for (size_t n = 0; n != lattice_positions.size(); ++n)
+    {
+        Vecd &particle_position = lattice_positions[n];
+        Real random_real = unif(rng);
+        // If the random_real is smaller than the interval, add a particle, only if we haven't reached the max. number of particles.
+        if (random_real <= interval && base_particles_.total_real_particles_ < planned_number_of_particles_)
         {
-            Vecd particle_position = mesh->CellPositionFromIndex(Arrayi(i, j));
-            if (initial_shape_.checkNotFar(particle_position, lattice_spacing_))
-            {
-                if (initial_shape_.checkContain(particle_position))
-                {
-                    Real random_real = unif(rng);
-                    // If the random_real is smaller than the interval, add a particle, only if we haven't reached the max. number of particles
-                    if (random_real <= interval && base_particles_.total_real_particles_ < planned_number_of_particles_)
-                    {
-                        initializePositionAndVolumetricMeasure(particle_position, avg_particle_volume_ / thickness_);
-                        initializeSurfaceProperties(initial_shape_.findNormalDirection(particle_position), thickness_);
-                    }
-                }
-            }
+            initializePositionAndVolumetricMeasure(particle_position, avg_particle_volume_ / thickness_);
+            initializeSurfaceProperties(initial_shape_.findNormalDirection(particle_position), thickness_);
         }
+    }
 }
 //=================================================================================================//
 } // namespace SPH
@@ -33,9 +33,11 @@
 #include "complex_shape.h"
 #include "mapping_shape.h"
 #include "geometric_shape.h"
+#include "height_field_shape.h"
 #include "image_shape.h"
 #include "level_set_shape.h"
 #include "transform_shape.h"
+#include "transformed_level_set_shape.h"
 #include "triangle_mesh_shape.h"
 
 #endif // ALL_GEOMETRIES_H
\ No newline at end of file
@@ -0,0 +1,405 @@
+#include "height_field_shape.h"
+
+#include <cctype>
+#include <sstream>
+
+namespace SPH
+{
+//=================================================================================================//
+void HeightFieldShape::initializeHeightField(const Array2i &number_of_nodes, const Vec2d &lower_corner,
+                                             const Vec2d &spacing, Real base_elevation)
+{
+    number_of_nodes_ = number_of_nodes;
+    lower_corner_ = lower_corner;
+    spacing_ = spacing;
+    base_elevation_ = base_elevation;
+
+    if (!isValid() || (size_t)number_of_nodes_.prod() != elevation_.size())
+    {
+        std::cout << "\n Error: the height field raster is not valid!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    min_elevation_ = MaxReal;
+    max_elevation_ = -MaxReal;
+    for (size_t n = 0; n != elevation_.size(); ++n)
+    {
+        min_elevation_ = SMIN(min_elevation_, elevation_[n]);
+        max_elevation_ = SMAX(max_elevation_, elevation_[n]);
+    }
+    std::cout << "height field with " << number_of_nodes_[0] << " x " << number_of_nodes_[1]
+              << " nodes, elevation range [" << min_elevation_ << ", " << max_elevation_ << "]" << std::endl;
+
+    int number_of_cells_x = number_of_nodes_[0] - 1;
+    int number_of_cells_y = number_of_nodes_[1] - 1;
+    number_of_tiles_ = Array2i((number_of_cells_x + tile_size_ - 1) / tile_size_,
+                               (number_of_cells_y + tile_size_ - 1) / tile_size_);
+    tile_min_elevation_.resize(number_of_tiles_.prod());
+    tile_max_elevation_.resize(number_of_tiles_.prod());
+    parallel_for(
+        IndexRange(0, number_of_tiles_.prod()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                int tile_i = (int)n % number_of_tiles_[0];
+                int tile_j = (int)n / number_of_tiles_[0];
+                Real tile_min = MaxReal;
+                Real tile_max = -MaxReal;
+                int upper_i = SMIN((tile_i + 1) * tile_size_, number_of_cells_x);
+                int upper_j = SMIN((tile_j + 1) * tile_size_, number_of_cells_y);
+                for (int j = tile_j * tile_size_; j <= upper_j; ++j)
+                    for (int i = tile_i * tile_size_; i <= upper_i; ++i)
+                    {
+                        tile_min = SMIN(tile_min, NodeElevation(i, j));
+                        tile_max = SMAX(tile_max, NodeElevation(i, j));
+                    }
+                tile_min_elevation_[n] = tile_min;
+                tile_max_elevation_[n] = tile_max;
+            }
+        },
+        ap);
+    /** bounds are cached here as queries may come concurrently later. */
+    getBounds();
+}
+//=================================================================================================//
+bool HeightFieldShape::isValid()
+{
+    return number_of_nodes_[0] > 1 && number_of_nodes_[1] > 1 &&
+                   spacing_[0] > 0.0 && spacing_[1] > 0.0
+               ? true
+               : false;
+}
+//=================================================================================================//
+Vec3d HeightFieldShape::NodePosition(int i, int j)
+{
+    return Vec3d(lower_corner_[0] + (Real)i * spacing_[0],
+                 lower_corner_[1] + (Real)j * spacing_[1], NodeElevation(i, j));
+}
+//=================================================================================================//
+Array2i HeightFieldShape::CellIndexFromPosition(Real x, Real y)
+{
+    int i = (int)std::floor((x - lower_corner_[0]) / spacing_[0]);
+    int j = (int)std::floor((y - lower_corner_[1]) / spacing_[1]);
+    return Array2i(clamp(i, 0, number_of_nodes_[0] - 2), clamp(j, 0, number_of_nodes_[1] - 2));
+}
+//=================================================================================================//
+Real HeightFieldShape::getElevation(Real x, Real y)
+{
+    Array2i cell = CellIndexFromPosition(x, y);
+    Real u = clamp((x - lower_corner_[0]) / spacing_[0] - (Real)cell[0], Real(0), Real(1));
+    Real v = clamp((y - lower_corner_[1]) / spacing_[1] - (Real)cell[1], Real(0), Real(1));
+    Real h00 = NodeElevation(cell[0], cell[1]);
+    Real h10 = NodeElevation(cell[0] + 1, cell[1]);
+    Real h01 = NodeElevation(cell[0], cell[1] + 1);
+    Real h11 = NodeElevation(cell[0] + 1, cell[1] + 1);
+    return u >= v ? h00 + u * (h10 - h00) + v * (h11 - h10)
+                  : h00 + v * (h01 - h00) + u * (h11 - h01);
+}
+//=================================================================================================//
+bool HeightFieldShape::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
+{
+    BoundingBox bounds = getBounds();
+    for (int k = 0; k != 2; ++k)
+    {
+        if (probe_point[k] < bounds.first_[k] || probe_point[k] > bounds.second_[k])
+            return false;
+    }
+
+    Real elevation = getElevation(probe_point[0], probe_point[1]);
+    if (BOUNDARY_INCLUDED == true)
+        return probe_point[2] <= elevation && probe_point[2] >= base_elevation_;
+    else
+        return probe_point[2] < elevation && probe_point[2] > base_elevation_;
+}
+//=================================================================================================//
+Vec3d HeightFieldShape::findClosestPointOnTriangle(const Vec3d &probe_point,
+                                                   const Vec3d &a, const Vec3d &b, const Vec3d &c)
+{
+    Vec3d ab = b - a;
+    Vec3d ac = c - a;
+    Vec3d ap = probe_point - a;
+    Real d1 = ab.dot(ap);
+    Real d2 = ac.dot(ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+        return a;
+
+    Vec3d bp = probe_point - b;
+    Real d3 = ab.dot(bp);
+    Real d4 = ac.dot(bp);
+    if (d3 >= 0.0 && d4 <= d3)
+        return b;
+
+    Real vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+        return a + d1 / (d1 - d3) * ab;
+
+    Vec3d cp = probe_point - c;
+    Real d5 = ab.dot(cp);
+    Real d6 = ac.dot(cp);
+    if (d6 >= 0.0 && d5 <= d6)
+        return c;
+
+    Real vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+        return a + d2 / (d2 - d6) * ac;
+
+    Real va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+
+    Real denominator = 1.0 / (va + vb + vc);
+    return a + ab * vb * denominator + ac * vc * denominator;
+}
+//=================================================================================================//
+Vec3d HeightFieldShape::findClosestPointInCell(const Vec3d &probe_point, int i, int j)
+{
+    Vec3d node_00 = NodePosition(i, j);
+    Vec3d node_10 = NodePosition(i + 1, j);
+    Vec3d node_01 = NodePosition(i, j + 1);
+    Vec3d node_11 = NodePosition(i + 1, j + 1);
+    Vec3d lower_triangle_point = findClosestPointOnTriangle(probe_point, node_00, node_10, node_11);
+    Vec3d upper_triangle_point = findClosestPointOnTriangle(probe_point, node_00, node_11, node_01);
+    return (probe_point - lower_triangle_point).squaredNorm() < (probe_point - upper_triangle_point).squaredNorm()
+               ? lower_triangle_point
+               : upper_triangle_point;
+}
+//=================================================================================================//
+Vec3d HeightFieldShape::findClosestPointOnBaseAndWalls(const Vec3d &probe_point)
+{
+    BoundingBox bounds = getBounds();
+    Real x = clamp(probe_point[0], bounds.first_[0], bounds.second_[0]);
+    Real y = clamp(probe_point[1], bounds.first_[1], bounds.second_[1]);
+
+    Vec3d closest_point(x, y, base_elevation_);
+    Real min_distance_sqr = (probe_point - closest_point).squaredNorm();
+    for (int side = 0; side != 2; ++side)
+    {
+        Real wall_x = side == 0 ? bounds.first_[0] : bounds.second_[0];
+        Real top_x = SMAX(getElevation(wall_x, y), base_elevation_);
+        Vec3d candidate_x(wall_x, y, clamp(probe_point[2], base_elevation_, top_x));
+        Real distance_sqr_x = (probe_point - candidate_x).squaredNorm();
+        if (distance_sqr_x < min_distance_sqr)
+        {
+            min_distance_sqr = distance_sqr_x;
+            closest_point = candidate_x;
+        }
+
+        Real wall_y = side == 0 ? bounds.first_[1] : bounds.second_[1];
+        Real top_y = SMAX(getElevation(x, wall_y), base_elevation_);
+        Vec3d candidate_y(x, wall_y, clamp(probe_point[2], base_elevation_, top_y));
+        Real distance_sqr_y = (probe_point - candidate_y).squaredNorm();
+        if (distance_sqr_y < min_distance_sqr)
+        {
+            min_distance_sqr = distance_sqr_y;
+            closest_point = candidate_y;
+        }
+    }
+    return closest_point;
+}
+//=================================================================================================//
+Vec3d HeightFieldShape::findClosestPoint(const Vec3d &probe_point)
+{
+    Vec3d closest_point = findClosestPointOnBaseAndWalls(probe_point);
+    Real min_distance_sqr = (probe_point - closest_point).squaredNorm();
+
+    auto squaredDistanceToBox = [&](const Vec3d &lower, const Vec3d &upper) -> Real
+    {
+        Real distance_sqr = 0.0;
+        for (int k = 0; k != 3; ++k)
+        {
+            Real gap = SMAX(lower[k] - probe_point[k], probe_point[k] - upper[k], Real(0));
+            distance_sqr += gap * gap;
+        }
+        return distance_sqr;
+    };
+
+    int number_of_cells_x = number_of_nodes_[0] - 1;
+    int number_of_cells_y = number_of_nodes_[1] - 1;
+    Array2i center_tile = CellIndexFromPosition(probe_point[0], probe_point[1]) / tile_size_;
+    Real tile_extent = (Real)tile_size_ * spacing_.minCoeff();
+    int max_ring = number_of_tiles_.maxCoeff();
+    /** Tiles in ring n are at least (n - 1) tile extents away from the probe point projected into the raster,
+     * hence the search stops once that lower bound exceeds the current closest distance. */
+    for (int ring = 0; ring <= max_ring; ++ring)
+    {
+        Real ring_distance = (Real)(ring - 1) * tile_extent;
+        if (ring_distance > 0.0 && ring_distance * ring_distance > min_distance_sqr)
+            break;
+
+        for (int tile_j = center_tile[1] - ring; tile_j <= center_tile[1] + ring; ++tile_j)
+        {
+            if (tile_j < 0 || tile_j >= number_of_tiles_[1])
+                continue;
+            bool is_edge_row = ABS(tile_j - center_tile[1]) == ring;
+            int step_i = is_edge_row || ring == 0 ? 1 : 2 * ring;
+            for (int tile_i = center_tile[0] - ring; tile_i <= center_tile[0] + ring; tile_i += step_i)
+            {
+                if (tile_i < 0 || tile_i >= number_of_tiles_[0])
+                    continue;
+
+                int tile_index = tile_j * number_of_tiles_[0] + tile_i;
+                int lower_i = tile_i * tile_size_;
+                int lower_j = tile_j * tile_size_;
+                int upper_i = SMIN(lower_i + tile_size_, number_of_cells_x);
+                int upper_j = SMIN(lower_j + tile_size_, number_of_cells_y);
+                Vec3d tile_lower(lower_corner_[0] + (Real)lower_i * spacing_[0],
+                                 lower_corner_[1] + (Real)lower_j * spacing_[1], tile_min_elevation_[tile_index]);
+                Vec3d tile_upper(lower_corner_[0] + (Real)upper_i * spacing_[0],
+                                 lower_corner_[1] + (Real)upper_j * spacing_[1], tile_max_elevation_[tile_index]);
+                if (squaredDistanceToBox(tile_lower, tile_upper) >= min_distance_sqr)
+                    continue;
+
+                for (int j = lower_j; j != upper_j; ++j)
+                    for (int i = lower_i; i != upper_i; ++i)
+                    {
+                        Real h00 = NodeElevation(i, j);
+                        Real h10 = NodeElevation(i + 1, j);
+                        Real h01 = NodeElevation(i, j + 1);
+                        Real h11 = NodeElevation(i + 1, j + 1);
+                        Vec3d cell_lower(lower_corner_[0] + (Real)i * spacing_[0],
+                                         lower_corner_[1] + (Real)j * spacing_[1], SMIN(h00, h10, h01, h11));
+                        Vec3d cell_upper(cell_lower[0] + spacing_[0], cell_lower[1] + spacing_[1],
+                                         SMAX(h00, h10, h01, h11));
+                        if (squaredDistanceToBox(cell_lower, cell_upper) >= min_distance_sqr)
+                            continue;
+
+                        Vec3d candidate = findClosestPointInCell(probe_point, i, j);
+                        Real distance_sqr = (probe_point - candidate).squaredNorm();
+                        if (distance_sqr < min_distance_sqr)
+                        {
+                            min_distance_sqr = distance_sqr;
+                            closest_point = candidate;
+                        }
+                    }
+            }
+        }
+    }
+    return closest_point;
+}
+//=================================================================================================//
+BoundingBox HeightFieldShape::findBounds()
+{
+    Vec3d lower_bound(lower_corner_[0], lower_corner_[1], SMIN(base_elevation_, min_elevation_));
+    Vec3d upper_bound(lower_corner_[0] + (Real)(number_of_nodes_[0] - 1) * spacing_[0],
+                      lower_corner_[1] + (Real)(number_of_nodes_[1] - 1) * spacing_[1],
+                      SMAX(base_elevation_, max_elevation_));
+    return BoundingBox(lower_bound, upper_bound);
+}
+//=================================================================================================//
+HeightFieldShapeASCII::HeightFieldShapeASCII(const std::string &file_path_name, Real base_elevation,
+                                             Vec3d translation, const std::string &shape_name)
+    : HeightFieldShape(shape_name)
+{
+    if (!fs::exists(file_path_name))
+    {
+        std::cout << "\n Error: the input file:" << file_path_name << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        throw;
+    }
+    std::ifstream input_file(file_path_name, std::ios::binary);
+    std::stringstream buffer;
+    buffer << input_file.rdbuf();
+    std::string content = buffer.str();
+
+    /** parse the header, i.e. the leading key-value pairs. */
+    std::map<std::string, Real> header;
+    const char *cursor = content.c_str();
+    char *end = nullptr;
+    while (true)
+    {
+        while (*cursor != '\0' && std::isspace(static_cast<unsigned char>(*cursor)))
+            ++cursor;
+        if (!std::isalpha(static_cast<unsigned char>(*cursor)))
+            break;
+        std::string key;
+        while (*cursor != '\0' && !std::isspace(static_cast<unsigned char>(*cursor)))
+            key.push_back((char)std::tolower(static_cast<unsigned char>(*cursor++)));
+        header[key] = (Real)std::strtod(cursor, &end);
+        cursor = end;
+    }
+
+    if (!header.count("ncols") || !header.count("nrows") ||
+        !(header.count("cellsize") || (header.count("dx") && header.count("dy"))))
+    {
+        std::cout << "\n Error: the ASCII grid header of " << file_path_name << " is incomplete!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    Array2i number_of_nodes((int)header["ncols"], (int)header["nrows"]);
+    Vec2d spacing = header.count("cellsize") ? Vec2d(header["cellsize"], header["cellsize"])
+                                             : Vec2d(header["dx"], header["dy"]);
+    /** corner-registered grids store cell-center values. */
+    Vec2d lower_corner(header.count("xllcenter") ? header["xllcenter"] : header["xllcorner"] + 0.5 * spacing[0],
+                       header.count("yllcenter") ? header["yllcenter"] : header["yllcorner"] + 0.5 * spacing[1]);
+    bool has_no_data = header.count("nodata_value") != 0;
+    Real no_data_value = has_no_data ? header["nodata_value"] : 0.0;
+
+    elevation_.resize(number_of_nodes.prod());
+    for (int row = 0; row != number_of_nodes[1]; ++row)
+    {
+        int j = number_of_nodes[1] - 1 - row;
+        for (int i = 0; i != number_of_nodes[0]; ++i)
+        {
+            Real value = (Real)std::strtod(cursor, &end);
+            if (end == cursor)
+            {
+                std::cout << "\n Error: the ASCII grid " << file_path_name << " has less values than expected!" << std::endl;
+                std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                exit(1);
+            }
+            cursor = end;
+            elevation_[j * number_of_nodes[0] + i] =
+                has_no_data && value == no_data_value ? base_elevation + translation[2] : value + translation[2];
+        }
+    }
+
+    Vec2d horizontal_translation(translation[0], translation[1]);
+    initializeHeightField(number_of_nodes, lower_corner + horizontal_translation, spacing,
+                          base_elevation + translation[2]);
+}
+//=================================================================================================//
+HeightFieldShapeRaw::HeightFieldShapeRaw(const std::string &file_path_name, const Array2i &number_of_nodes,
+                                         const Vec2d &lower_corner, const Vec2d &spacing, Real base_elevation,
+                                         Real no_data_value, const std::string &shape_name)
+    : HeightFieldShape(shape_name)
+{
+    if (!fs::exists(file_path_name))
+    {
+        std::cout << "\n Error: the input file:" << file_path_name << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        throw;
+    }
+    size_t total_nodes = number_of_nodes.prod();
+    if (fs::file_size(file_path_name) < total_nodes * sizeof(float))
+    {
+        std::cout << "\n Error: the raw raster " << file_path_name << " is smaller than expected!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    std::vector<float> raw_data(total_nodes);
+    std::ifstream input_file(file_path_name, std::ios::binary);
+    input_file.read(reinterpret_cast<char *>(raw_data.data()), total_nodes * sizeof(float));
+
+    elevation_.resize(total_nodes);
+    parallel_for(
+        IndexRange(0, total_nodes),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                int row = (int)n / number_of_nodes[0];
+                int i = (int)n % number_of_nodes[0];
+                int j = number_of_nodes[1] - 1 - row;
+                Real value = (Real)raw_data[n];
+                elevation_[j * number_of_nodes[0] + i] = value == no_data_value ? base_elevation : value;
+            }
+        },
+        ap);
+
+    initializeHeightField(number_of_nodes, lower_corner, spacing, base_elevation);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,140 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	height_field_shape.h
+ * @brief 	Terrain geometry defined by a gridded elevation raster (DEM).
+ * @details The shape is the solid column between a flat base elevation and the terrain surface.
+ *          The surface is the piecewise linear interpolation of the raster nodes,
+ *          two triangles per raster cell split along the diagonal from (i, j) to (i + 1, j + 1),
+ *          so that containment and closest point queries see exactly the same surface.
+ *          All queries are answered from the raster directly by grid lookups,
+ *          without building a triangle mesh or SimTK contact geometry.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef HEIGHT_FIELD_SHAPE_H
+#define HEIGHT_FIELD_SHAPE_H
+
+#include "base_geometry.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+namespace fs = std::filesystem;
+
+namespace SPH
+{
+/**
+ * @class HeightFieldShape
+ * @brief Base class for shapes given by elevation z = h(x, y) over a regular raster.
+ * @details Raster node (i, j) is located at lower_corner + (i * spacing[0], j * spacing[1]),
+ * with i along x (east) and j along y (north).
+ * checkContain is O(1). findClosestPoint visits only the raster cells in rings around the probe point
+ * which may still hold a closer surface point, hence near-O(1) for points close to the surface.
+ */
+class HeightFieldShape : public Shape
+{
+  public:
+    explicit HeightFieldShape(const std::string &shape_name)
+        : Shape(shape_name), number_of_nodes_(Array2i::Zero()), lower_corner_(Vec2d::Zero()),
+          spacing_(Vec2d::Ones()), base_elevation_(0.0), min_elevation_(0.0), max_elevation_(0.0),
+          number_of_tiles_(Array2i::Zero()){};
+    virtual ~HeightFieldShape(){};
+
+    virtual bool isValid() override;
+    virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
+    virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
+
+    /** Interpolated terrain elevation, the horizontal position is clamped into the raster extent. */
+    Real getElevation(Real x, Real y);
+    Array2i getNumberOfNodes() { return number_of_nodes_; };
+    Vec2d getSpacing() { return spacing_; };
+    Real getBaseElevation() { return base_elevation_; };
+
+  protected:
+    Array2i number_of_nodes_; /**< number of raster nodes along x and y. */
+    Vec2d lower_corner_;      /**< position of the raster node (0, 0). */
+    Vec2d spacing_;           /**< raster spacing along x and y. */
+    Real base_elevation_;     /**< bottom of the solid column. */
+    Real min_elevation_;
+    Real max_elevation_;
+    StdLargeVec<Real> elevation_; /**< node elevations, row-major with x fastest. */
+    /** Raster cells are grouped into square tiles with known elevation range,
+     * used to skip far away tiles in closest point search. */
+    static constexpr int tile_size_ = 16;
+    Array2i number_of_tiles_;
+    StdLargeVec<Real> tile_min_elevation_;
+    StdLargeVec<Real> tile_max_elevation_;
+
+    /** Set up the raster after the elevation data has been filled in by the derived class. */
+    void initializeHeightField(const Array2i &number_of_nodes, const Vec2d &lower_corner,
+                               const Vec2d &spacing, Real base_elevation);
+    Real NodeElevation(int i, int j) { return elevation_[j * number_of_nodes_[0] + i]; };
+    Vec3d NodePosition(int i, int j);
+    /** The cell containing the horizontal position, clamped to the valid cell range. */
+    Array2i CellIndexFromPosition(Real x, Real y);
+    /** Closest point on the two terrain triangles of a cell. */
+    Vec3d findClosestPointInCell(const Vec3d &probe_point, int i, int j);
+    Vec3d findClosestPointOnTriangle(const Vec3d &probe_point, const Vec3d &a, const Vec3d &b, const Vec3d &c);
+    /** Closest point on the base and the four side walls of the solid column. */
+    Vec3d findClosestPointOnBaseAndWalls(const Vec3d &probe_point);
+    virtual BoundingBox findBounds() override;
+};
+
+/**
+ * @class HeightFieldShapeASCII
+ * @brief Terrain from an ESRI ASCII grid (.asc) file.
+ * @details The header keys ncols, nrows, xllcorner/xllcenter, yllcorner/yllcenter,
+ * cellsize (or dx and dy) and the optional NODATA_value are recognized.
+ * Values are given row by row from north to south, as in the file format.
+ * No-data nodes are set to the base elevation, i.e. they carry no material.
+ * The translation is applied to the whole raster, including the base elevation.
+ */
+class HeightFieldShapeASCII : public HeightFieldShape
+{
+  public:
+    explicit HeightFieldShapeASCII(const std::string &file_path_name, Real base_elevation,
+                                   Vec3d translation = Vec3d::Zero(),
+                                   const std::string &shape_name = "HeightFieldShapeASCII");
+    virtual ~HeightFieldShapeASCII(){};
+};
+
+/**
+ * @class HeightFieldShapeRaw
+ * @brief Terrain from a headerless binary raster of 32-bit floats in native byte order.
+ * @details The values are stored row by row from north to south, the same ordering as the ASCII grid.
+ * Nodes with value no_data_value are set to the base elevation.
+ */
+class HeightFieldShapeRaw : public HeightFieldShape
+{
+  public:
+    explicit HeightFieldShapeRaw(const std::string &file_path_name, const Array2i &number_of_nodes,
+                                 const Vec2d &lower_corner, const Vec2d &spacing, Real base_elevation,
+                                 Real no_data_value = -9999.0,
+                                 const std::string &shape_name = "HeightFieldShapeRaw");
+    virtual ~HeightFieldShapeRaw(){};
+};
+} // namespace SPH
+
+#endif // HEIGHT_FIELD_SHAPE_H
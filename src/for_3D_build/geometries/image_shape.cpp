@@ -2,8 +2,284 @@
 
 #include "image_shape.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
 namespace SPH
 {
+namespace
+{
+/** Value used for an infinite squared distance, i.e. no feature voxel found yet. */
+constexpr float far_squared_distance = 1.0e20f;
+//=================================================================================================//
+void reportImageError(const std::string &message)
+{
+    std::cout << "\n Error: " << message << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+std::string trimSpaces(const std::string &text)
+{
+    size_t first = text.find_first_not_of(" \t\r");
+    size_t last = text.find_last_not_of(" \t\r");
+    return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+}
+//=================================================================================================//
+bool parseBoolean(const std::string &value)
+{
+    return value == "True" || value == "true" || value == "1";
+}
+//=================================================================================================//
+template <typename ValueType>
+double readVoxelValue(const char *bytes)
+{
+    ValueType value;
+    std::memcpy(&value, bytes, sizeof(ValueType));
+    return (double)value;
+}
+//=================================================================================================//
+using VoxelReader = double (*)(const char *);
+/** Element size and reader of a MetaImage element type. */
+std::pair<size_t, VoxelReader> getVoxelReader(const std::string &element_type)
+{
+    if (element_type == "MET_CHAR")
+        return {1, readVoxelValue<int8_t>};
+    if (element_type == "MET_UCHAR")
+        return {1, readVoxelValue<uint8_t>};
+    if (element_type == "MET_SHORT")
+        return {2, readVoxelValue<int16_t>};
+    if (element_type == "MET_USHORT")
+        return {2, readVoxelValue<uint16_t>};
+    if (element_type == "MET_INT" || element_type == "MET_LONG")
+        return {4, readVoxelValue<int32_t>};
+    if (element_type == "MET_UINT" || element_type == "MET_ULONG")
+        return {4, readVoxelValue<uint32_t>};
+    if (element_type == "MET_LONG_LONG")
+        return {8, readVoxelValue<int64_t>};
+    if (element_type == "MET_ULONG_LONG")
+        return {8, readVoxelValue<uint64_t>};
+    if (element_type == "MET_FLOAT")
+        return {4, readVoxelValue<float>};
+    if (element_type == "MET_DOUBLE")
+        return {8, readVoxelValue<double>};
+    reportImageError("the image element type " + element_type + " is not supported");
+    return {0, nullptr};
+}
+//=================================================================================================//
+/**
+ * One-dimensional squared distance transform of sampled function f with sample spacing h,
+ * by the lower envelope of parabolas (Felzenszwalb and Huttenlocher).
+ * Scratch arrays: vertex of n ints and envelope of n + 1 doubles.
+ */
+void transformLine(const StdVec<double> &f, int n, double h, StdVec<double> &d,
+                   StdVec<int> &vertex, StdVec<double> &envelope)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    int k = 0;
+    vertex[0] = 0;
+    envelope[0] = -infinity;
+    envelope[1] = infinity;
+    auto intersection = [&](int q, int p)
+    { return ((f[q] + h * h * q * q) - (f[p] + h * h * p * p)) / (2.0 * h * (q - p)); };
+    for (int q = 1; q < n; ++q)
+    {
+        double s = intersection(q, vertex[k]);
+        while (s <= envelope[k]) // envelope[0] is minus infinity
+        {
+            --k;
+            s = intersection(q, vertex[k]);
+        }
+        ++k;
+        vertex[k] = q;
+        envelope[k] = s;
+        envelope[k + 1] = infinity;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q)
+    {
+        while (envelope[k + 1] < h * q)
+            ++k;
+        double displacement = h * (q - vertex[k]);
+        d[q] = displacement * displacement + f[vertex[k]];
+    }
+}
+} // namespace
+//=================================================================================================//
+bool ImageDistanceShape::isValid()
+{
+    return number_of_voxels_.minCoeff() > 0 && distance_.size() == (size_t)number_of_voxels_.prod();
+}
+//=================================================================================================//
+void ImageDistanceShape::transformClassificationToDistance()
+{
+    if (!isValid())
+        reportImageError("the image volume is not valid!");
+
+    for (int axis = 0; axis != 3; ++axis)
+    {
+        int n = number_of_voxels_[axis];
+        int n_lower = number_of_voxels_[axis == 0 ? 1 : 0];
+        size_t stride = axis == 0 ? 1 : (axis == 1 ? (size_t)number_of_voxels_[0]
+                                                   : (size_t)number_of_voxels_[0] * number_of_voxels_[1]);
+        size_t number_of_lines = (size_t)number_of_voxels_.prod() / n;
+        double h = spacing_[axis];
+        parallel_for(
+            IndexRange(0, number_of_lines),
+            [&](const IndexRange &r)
+            {
+                StdVec<double> to_inside(n), to_outside(n), transformed_to_inside(n), transformed_to_outside(n);
+                StdVec<int> vertex(n);
+                StdVec<double> envelope(n + 1);
+                for (size_t line = r.begin(); line != r.end(); ++line)
+                {
+                    /** the two indices other than the axis, the lower one varies fastest. */
+                    int lower = (int)(line % n_lower);
+                    int upper = (int)(line / n_lower);
+                    size_t start = axis == 0   ? VoxelIndex(0, lower, upper)
+                                   : axis == 1 ? VoxelIndex(lower, 0, upper)
+                                               : VoxelIndex(lower, upper, 0);
+                    bool has_inside = false;
+                    bool has_outside = false;
+                    for (int q = 0; q != n; ++q)
+                    {
+                        float value = distance_[start + q * stride];
+                        to_inside[q] = value > 0.0f ? value : 0.0;
+                        to_outside[q] = value < 0.0f ? -value : 0.0;
+                        has_inside = has_inside || value < 0.0f;
+                        has_outside = has_outside || value > 0.0f;
+                    }
+                    if (has_outside)
+                        transformLine(to_inside, n, h, transformed_to_inside, vertex, envelope);
+                    if (has_inside)
+                        transformLine(to_outside, n, h, transformed_to_outside, vertex, envelope);
+                    for (int q = 0; q != n; ++q)
+                    {
+                        float &value = distance_[start + q * stride];
+                        value = value > 0.0f ? (float)SMIN(transformed_to_inside[q], (double)far_squared_distance)
+                                             : -(float)SMIN(transformed_to_outside[q], (double)far_squared_distance);
+                    }
+                }
+            },
+            ap);
+    }
+
+    /** The interface is assumed halfway between the centres of inside and outside voxels. */
+    Real half_spacing = 0.5 * spacing_.minCoeff();
+    Real largest_distance = (number_of_voxels_.cast<Real>() * spacing_.array()).matrix().norm();
+    parallel_for(
+        IndexRange(0, distance_.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                Real squared_distance = ABS((Real)distance_[n]);
+                Real distance = SMIN(sqrt(squared_distance), largest_distance) - half_spacing;
+                distance_[n] = distance_[n] > 0.0f ? (float)distance : -(float)distance;
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+Real ImageDistanceShape::probeSignedDistance(const Vec3d &probe_point)
+{
+    Vec3d image_coordinates = (rotation_.transpose() * (probe_point - offset_)).cwiseQuotient(spacing_);
+    Vec3d clamped_coordinates = image_coordinates;
+    Array3i lower_index = Array3i::Zero();
+    Vec3d weight = Vec3d::Zero();
+    for (int l = 0; l != 3; ++l)
+    {
+        Real upper_bound = Real(number_of_voxels_[l] - 1);
+        clamped_coordinates[l] = SMIN(SMAX(image_coordinates[l], Real(0)), upper_bound);
+        lower_index[l] = SMIN((int)floor(clamped_coordinates[l]), SMAX(number_of_voxels_[l] - 2, 0));
+        weight[l] = number_of_voxels_[l] > 1 ? clamped_coordinates[l] - Real(lower_index[l]) : 0.0;
+    }
+    Array3i upper_index = (lower_index + Array3i::Ones()).min(number_of_voxels_ - Array3i::Ones());
+
+    Real value = 0.0;
+    for (int k = 0; k != 2; ++k)
+        for (int j = 0; j != 2; ++j)
+            for (int i = 0; i != 2; ++i)
+            {
+                Real corner_weight = (i == 0 ? 1.0 - weight[0] : weight[0]) *
+                                     (j == 0 ? 1.0 - weight[1] : weight[1]) *
+                                     (k == 0 ? 1.0 - weight[2] : weight[2]);
+                value += corner_weight * (Real)distance_[VoxelIndex(i == 0 ? lower_index[0] : upper_index[0],
+                                                                    j == 0 ? lower_index[1] : upper_index[1],
+                                                                    k == 0 ? lower_index[2] : upper_index[2])];
+            }
+    /** Outside of the volume, combining the distances by Pythagoras gives a lower bound as the volume is convex,
+     * while their sum would exceed the distance to the surface. */
+    Real outside_distance = (image_coordinates - clamped_coordinates).cwiseProduct(spacing_).norm();
+    return value > 0.0 ? sqrt(value * value + outside_distance * outside_distance) : value + outside_distance;
+}
+//=================================================================================================//
+bool ImageDistanceShape::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
+{
+    Real value = probeSignedDistance(probe_point);
+    return BOUNDARY_INCLUDED ? value <= 0.0 : value < 0.0;
+}
+//=================================================================================================//
+Real ImageDistanceShape::findSignedDistance(const Vec3d &probe_point)
+{
+    return probeSignedDistance(probe_point);
+}
+//=================================================================================================//
+Vec3d ImageDistanceShape::findNormalDirection(const Vec3d &probe_point)
+{
+    return probeNormalDirection(probe_point);
+}
+//=================================================================================================//
+Vec3d ImageDistanceShape::probeNormalDirection(const Vec3d &probe_point)
+{
+    /** retried with a wider stencil at the rare points where the field is locally flat. */
+    for (Real step : {0.5 * spacing_.minCoeff(), 2.0 * spacing_.maxCoeff()})
+    {
+        Vec3d gradient = Vec3d::Zero();
+        for (int l = 0; l != 3; ++l)
+        {
+            Vec3d shift = step * Vec3d::Unit(l);
+            gradient[l] = probeSignedDistance(probe_point + shift) - probeSignedDistance(probe_point - shift);
+        }
+        if (gradient.norm() > TinyReal)
+            return gradient.normalized();
+    }
+    return Vec3d::UnitX();
+}
+//=================================================================================================//
+Vec3d ImageDistanceShape::findClosestPoint(const Vec3d &probe_point)
+{
+    /** A few projection steps along the normal, as the interpolated field is not an exact distance. */
+    Vec3d closest_point = probe_point;
+    for (int iteration = 0; iteration != 3; ++iteration)
+    {
+        Real distance = probeSignedDistance(closest_point);
+        closest_point -= distance * probeNormalDirection(closest_point);
+        if (ABS(distance) < 1.0e-3 * spacing_.minCoeff())
+            break;
+    }
+    return closest_point;
+}
+//=================================================================================================//
+BoundingBox ImageDistanceShape::findBounds()
+{
+    Vec3d lower_bound = MaxReal * Vec3d::Ones();
+    Vec3d upper_bound = -MaxReal * Vec3d::Ones();
+    for (int corner = 0; corner != 8; ++corner)
+    {
+        Vec3d voxel_index = Vec3d::Zero();
+        for (int l = 0; l != 3; ++l)
+            voxel_index[l] = (corner >> l) & 1 ? Real(number_of_voxels_[l] - 1) : 0.0;
+        Vec3d position = offset_ + rotation_ * voxel_index.cwiseProduct(spacing_);
+        lower_bound = lower_bound.cwiseMin(position);
+        upper_bound = upper_bound.cwiseMax(position);
+    }
+    return BoundingBox(lower_bound, upper_bound);
+}
+//=================================================================================================//
 //=================================================================================================//
 bool ImageShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
 {
@@ -36,9 +312,119 @@ BoundingBox ImageShape::findBounds()
 //=================================================================================================//
 ImageShapeFromFile::
     ImageShapeFromFile(const std::string &file_path_name, const std::string &shape_name)
-    : ImageShape(shape_name)
+    : ImageShapeFromFile(file_path_name, 0.0, false, shape_name) {}
+//=================================================================================================//
+ImageShapeFromFile::ImageShapeFromFile(const std::string &file_path_name, Real iso_value,
+                                       bool is_inside_above_iso, const std::string &shape_name)
+    : ImageDistanceShape(shape_name)
 {
-    image_.reset(new ImageMHD<float, 3>(file_path_name));
+    std::ifstream header_file(file_path_name);
+    if (!header_file.is_open())
+        reportImageError("the image header file:" + file_path_name + " is not exists");
+
+    std::string element_type = "MET_FLOAT";
+    std::string element_data_file;
+    bool is_byte_order_msb = false;
+    long header_size = 0;
+    std::string line;
+    while (std::getline(header_file, line))
+    {
+        size_t separator = line.find('=');
+        if (separator == std::string::npos)
+            continue;
+        std::string key = trimSpaces(line.substr(0, separator));
+        std::string value = trimSpaces(line.substr(separator + 1));
+        std::istringstream values(value);
+        if (key == "NDims" && std::stoi(value) != 3)
+            reportImageError("only three-dimensional images are supported");
+        else if (key == "DimSize")
+            values >> number_of_voxels_[0] >> number_of_voxels_[1] >> number_of_voxels_[2];
+        else if (key == "ElementSpacing")
+            values >> spacing_[0] >> spacing_[1] >> spacing_[2];
+        else if (key == "Offset" || key == "Position" || key == "Origin")
+            values >> offset_[0] >> offset_[1] >> offset_[2];
+        else if (key == "TransformMatrix" || key == "Rotation" || key == "Orientation")
+        {
+            for (int row = 0; row != 3; ++row)
+                for (int column = 0; column != 3; ++column)
+                    values >> rotation_(row, column);
+        }
+        else if (key == "CompressedData" && parseBoolean(value))
+            reportImageError("compressed image data is not supported");
+        else if (key == "BinaryDataByteOrderMSB" || key == "ElementByteOrderMSB")
+            is_byte_order_msb = parseBoolean(value);
+        else if (key == "HeaderSize")
+            header_size = std::stol(value);
+        else if (key == "ElementType")
+            element_type = value;
+        else if (key == "ElementDataFile")
+        {
+            element_data_file = value;
+            break; // for LOCAL data the header ends here
+        }
+    }
+    header_file.close();
+
+    if (element_data_file.empty() || element_data_file == "LIST")
+        reportImageError("the image header file:" + file_path_name + " gives no single data file");
+    if (element_data_file != "LOCAL")
+        element_data_file = (fs::path(file_path_name).parent_path() / element_data_file).string();
+    else
+    {
+        element_data_file = file_path_name;
+        header_size = -1;
+    }
+
+    std::pair<size_t, VoxelReader> voxel_reader = getVoxelReader(element_type);
+    size_t element_size = voxel_reader.first;
+    VoxelReader read_voxel = voxel_reader.second;
+    size_t total_voxels = (size_t)number_of_voxels_.prod();
+    MappedFile raw_file(element_data_file);
+    /** By the MetaImage convention, the data are at the end of the file for a header size of -1. */
+    size_t data_begin = header_size >= 0 ? (size_t)header_size : raw_file.Size() - SMIN(raw_file.Size(), total_voxels * element_size);
+    if (number_of_voxels_.minCoeff() <= 0 || raw_file.Size() < data_begin + total_voxels * element_size)
+        reportImageError("the data file:" + element_data_file + " is smaller than the image given in the header");
+    uint16_t byte_order_probe = 1;
+    bool is_host_msb = *reinterpret_cast<const unsigned char *>(&byte_order_probe) == 0;
+    bool is_swap_bytes = is_byte_order_msb != is_host_msb;
+    const char *data = raw_file.Data() + data_begin;
+
+    /** A floating point volume with the iso value zero is a signed distance map and is used directly,
+     * otherwise the voxels are classified and the distance is found by the transform. */
+    bool is_distance_map = (element_type == "MET_FLOAT" || element_type == "MET_DOUBLE") && iso_value == 0.0;
+
+    /** Classification slab by slab, voxels are only touched in file order within a slab. */
+    distance_.resize(total_voxels);
+    size_t slice_size = (size_t)number_of_voxels_[0] * number_of_voxels_[1];
+    parallel_for(
+        IndexRange(0, number_of_voxels_[2]),
+        [&](const IndexRange &r)
+        {
+            char swapped[8];
+            for (size_t n = r.begin() * slice_size; n != r.end() * slice_size; ++n)
+            {
+                const char *bytes = data + n * element_size;
+                if (is_swap_bytes)
+                {
+                    std::reverse_copy(bytes, bytes + element_size, swapped);
+                    bytes = swapped;
+                }
+                double value = read_voxel(bytes);
+                if (is_distance_map)
+                {
+                    distance_[n] = is_inside_above_iso ? -(float)value : (float)value;
+                    continue;
+                }
+                bool is_inside = is_inside_above_iso ? value > iso_value : value < iso_value;
+                distance_[n] = is_inside ? -far_squared_distance : far_squared_distance;
+            }
+        },
+        ap);
+
+    std::cout << "image volume with " << number_of_voxels_[0] << " x " << number_of_voxels_[1] << " x "
+              << number_of_voxels_[2] << " voxels of " << element_type << std::endl;
+    if (!is_distance_map)
+        transformClassificationToDistance();
 }
 //=================================================================================================//
 ImageShapeSphere::
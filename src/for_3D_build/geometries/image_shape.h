@@ -23,6 +23,9 @@
 /**
  * @file 	image_shape.h
  * @brief 	Geometry processing with image shape.
+ * @details Shapes from image volumes carry a signed distance field sampled at the voxel centres,
+ *          which answers the shape queries by trilinear lookups
+ *          and initializes the level set packages directly.
  * @author	Yijin Mao, Chi Zhang and Xiangyu Hu
  */
 
@@ -33,6 +36,7 @@
 
 #include "base_geometry.h"
 #include "image_mhd.h"
+#include "mapped_file.h"
 
 #include <filesystem>
 #include <fstream>
@@ -62,11 +66,73 @@ class ImageShape : public Shape
     virtual BoundingBox findBounds() override;
 };
 
-class ImageShapeFromFile : public ImageShape
+/**
+ * @class ImageDistanceShape
+ * @brief Shape given by a signed distance field sampled at the voxel centres of an image volume.
+ * @details Voxel (i, j, k) is located at offset + rotation * (i * spacing[0], j * spacing[1], k * spacing[2]),
+ * the MetaImage convention, and i is the fastest index of the field.
+ * The field is either given directly or computed from the inside or outside classification
+ * of the voxels by an exact Euclidean distance transform, separable into independent one-dimensional transforms
+ * along the rows, the columns and the stacks of the volume, each of which is run in parallel.
+ * The distances to the inside voxels of an outside voxel, and vice versa, are computed together
+ * in a single buffer whose sign marks the classification, so that one float per voxel is used.
+ */
+class ImageDistanceShape : public Shape
+{
+  public:
+    explicit ImageDistanceShape(const std::string &shape_name)
+        : Shape(shape_name), number_of_voxels_(Array3i::Zero()), offset_(Vec3d::Zero()),
+          spacing_(Vec3d::Ones()), rotation_(Mat3d::Identity()){};
+    virtual ~ImageDistanceShape(){};
+
+    virtual bool isValid() override;
+    virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
+    virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
+    virtual Real findSignedDistance(const Vec3d &probe_point) override;
+    virtual Vec3d findNormalDirection(const Vec3d &probe_point) override;
+
+    Array3i getNumberOfVoxels() { return number_of_voxels_; };
+    Vec3d getSpacing() { return spacing_; };
+
+  protected:
+    Array3i number_of_voxels_;
+    Vec3d offset_;
+    Vec3d spacing_;
+    Mat3d rotation_;
+    /** Before the transform: the sign gives the classification, negative inside.
+     * After the transform: the signed distance at the voxel centres, i fastest. */
+    StdLargeVec<float> distance_;
+
+    size_t VoxelIndex(int i, int j, int k) { return ((size_t)k * number_of_voxels_[1] + j) * number_of_voxels_[0] + i; };
+    /** Transform the classification in distance_ into the signed distance field. */
+    void transformClassificationToDistance();
+    /** Trilinear interpolation at the probe point. A point outside of the volume is given
+     * a lower bound of the distance through the closest voxel centre, as assumed when culling by the distance. */
+    Real probeSignedDistance(const Vec3d &probe_point);
+    /** Normalized gradient of the interpolated field by central differences. */
+    Vec3d probeNormalDirection(const Vec3d &probe_point);
+    virtual BoundingBox findBounds() override;
+};
+
+/**
+ * @class ImageShapeFromFile
+ * @brief Shape from a MetaImage (.mhd) header and its raw volume.
+ * @details The raw volume is memory mapped and classified slab by slab without a copy.
+ * The element types MET_(U)CHAR, MET_(U)SHORT, MET_(U)INT, MET_FLOAT and MET_DOUBLE
+ * in either byte order are recognized, compressed data is not supported.
+ * A voxel is inside if its value is below the iso value, which suits distance maps (iso value 0),
+ * or above it if is_inside_above_iso is set, which suits segmentation masks and intensity volumes.
+ * A MET_FLOAT or MET_DOUBLE volume with the iso value zero is taken as the signed distance itself,
+ * so that its surface is found within the voxels, otherwise the surface is taken halfway
+ * between the centres of inside and outside voxels.
+ */
+class ImageShapeFromFile : public ImageDistanceShape
 {
   public:
     explicit ImageShapeFromFile(const std::string &file_path_name,
                                 const std::string &shape_name = "ImageShapeFromFile");
+    ImageShapeFromFile(const std::string &file_path_name, Real iso_value, bool is_inside_above_iso,
+                       const std::string &shape_name = "ImageShapeFromFile");
     virtual ~ImageShapeFromFile(){};
 };
 
@@ -27,8 +27,6 @@ void LevelSet::initializeDataForSingularPackage(LevelSetDataPackage *data_pkg, R
     auto &phi = data_pkg->getPackageData(phi_);
     auto &near_interface_id = data_pkg->getPackageData(near_interface_id_);
     auto &phi_gradient = data_pkg->getPackageData(phi_gradient_);
-    auto &kernel_weight = data_pkg->getPackageData(kernel_weight_);
-    auto &kernel_gradient = data_pkg->getPackageData(kernel_gradient_);
 
     data_pkg->for_each_data(
         [&](int i, int j, int k)
@@ -36,8 +34,6 @@ void LevelSet::initializeDataForSingularPackage(LevelSetDataPackage *data_pkg, R
             phi[i][j][k] = far_field_level_set;
             near_interface_id[i][j][k] = far_field_level_set < 0.0 ? -2 : 2;
             phi_gradient[i][j][k] = Vecd::Ones();
-            kernel_weight[i][j][k] = far_field_level_set < 0.0 ? 0 : 1.0;
-            kernel_gradient[i][j][k] = Vec3d::Zero();
         });
 }
 //=================================================================================================//
@@ -49,6 +45,8 @@ void LevelSet::finishDataPackages()
                           tagACellIsInnerPackage(Arrayi(i, j, k));
                       });
 
+    sortInnerDataPackages();
+
     mesh_parallel_for(MeshRange(Arrayi::Zero(), all_cells_),
                       [&](size_t i, size_t j, size_t k)
                       {
@@ -56,13 +54,52 @@ void LevelSet::finishDataPackages()
                       });
 
     updateLevelSetGradient();
-    updateKernelIntegrals();
+    initializeKernelIntegrals();
+}
+//=================================================================================================//
+void LevelSet::prepareKernelIntegralsInCell(const Arrayi &cell_index)
+{
+    LevelSetDataPackage *cell_pkg = DataPackageFromCellIndex(cell_index);
+    if (!cell_pkg->isInnerPackage())
+        return;
+
+    KernelIntegralsInACell &kernel_integrals = *kernel_integrals_in_cells_.PackageFromCellIndex(cell_index);
+    tbb::collaborative_call_once(
+        *kernel_integrals.is_prepared_,
+        [&]()
+        {
+            mesh_for_each(
+                Arrayi::Zero().max(cell_index - Arrayi::Ones()),
+                all_cells_.min(cell_index + 2 * Arrayi::Ones()),
+                [&](int l, int m, int n)
+                {
+                    LevelSetDataPackage *data_pkg = DataPackageFromCellIndex(Arrayi(l, m, n));
+                    if (data_pkg->isInnerPackage())
+                        computeKernelIntegralsForAPackage(data_pkg);
+                });
+
+            LevelSetDataPackage *kernel_pkg = KernelIntegralPackage(cell_pkg);
+            for (int l = 0; l != pkg_addrs_size; ++l)
+                for (int m = 0; m != pkg_addrs_size; ++m)
+                    for (int n = 0; n != pkg_addrs_size; ++n)
+                    {
+                        std::pair<int, int> x_pair = CellShiftAndDataIndex(l);
+                        std::pair<int, int> y_pair = CellShiftAndDataIndex(m);
+                        std::pair<int, int> z_pair = CellShiftAndDataIndex(n);
+                        Arrayi neighbor_cell = cell_index + Arrayi(x_pair.first, y_pair.first, z_pair.first);
+
+                        kernel_pkg->assignPackageDataAddress(
+                            Arrayi(l, m, n),
+                            KernelIntegralPackage(DataPackageFromCellIndex(neighbor_cell)),
+                            Arrayi(x_pair.second, y_pair.second, z_pair.second));
+                    }
+        });
 }
 //=================================================================================================//
 bool LevelSet::isWithinCorePackage(Vecd position)
 {
     Arrayi cell_index = CellIndexFromPosition(position);
-    return data_pkg_addrs_[cell_index[0]][cell_index[1]][cell_index[2]]->isCorePackage();
+    return DataPackageFromCellIndex(cell_index)->isCorePackage();
 }
 //=============================================================================================//
 bool LevelSet::isInnerPackage(const Arrayi &cell_index)
@@ -72,7 +109,7 @@ bool LevelSet::isInnerPackage(const Arrayi &cell_index)
         all_cells_.min(cell_index + 2 * Array3i::Ones()),
         [&](int l, int m, int n)
         {
-            return data_pkg_addrs_[l][m][n]->isCorePackage();
+            return DataPackageFromCellIndex(Arrayi(l, m, n))->isCorePackage();
         });
 }
 //=================================================================================================//
@@ -236,7 +273,7 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                             std::pair<int, int> x_pair = CellShiftAndDataIndex(i + x);
                             std::pair<int, int> y_pair = CellShiftAndDataIndex(j + y);
                             std::pair<int, int> z_pair = CellShiftAndDataIndex(k + z);
-                            LevelSetDataPackage *neighbor_pkg = data_pkg_addrs_[l + x_pair.first][m + y_pair.first][n + z_pair.first];
+                            LevelSetDataPackage *neighbor_pkg = DataPackageFromCellIndex(Arrayi(l + x_pair.first, m + y_pair.first, n + z_pair.first));
                             auto &neighbor_phi = neighbor_pkg->getPackageData(phi_);
                             auto &neighbor_phi_gradient = neighbor_pkg->getPackageData(phi_gradient_);
                             auto &neighbor_near_interface_id = neighbor_pkg->getPackageData(near_interface_id_);
@@ -263,7 +300,7 @@ void LevelSet::redistanceInterfaceForAPackage(LevelSetDataPackage *core_data_pkg
                             std::pair<int, int> x_pair = CellShiftAndDataIndex(i + x);
                             std::pair<int, int> y_pair = CellShiftAndDataIndex(j + y);
                             std::pair<int, int> z_pair = CellShiftAndDataIndex(k + z);
-                            LevelSetDataPackage *neighbor_pkg = data_pkg_addrs_[l + x_pair.first][m + y_pair.first][n + z_pair.first];
+                            LevelSetDataPackage *neighbor_pkg = DataPackageFromCellIndex(Arrayi(l + x_pair.first, m + y_pair.first, n + z_pair.first));
                             auto &neighbor_phi = neighbor_pkg->getPackageData(phi_);
                             auto &neighbor_phi_gradient = neighbor_pkg->getPackageData(phi_gradient_);
                             auto &neighbor_near_interface_id = neighbor_pkg->getPackageData(near_interface_id_);
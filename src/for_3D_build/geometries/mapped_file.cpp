@@ -0,0 +1,95 @@
+#include "mapped_file.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+namespace fs = std::filesystem;
+
+namespace SPH
+{
+//=================================================================================================//
+MappedFile::MappedFile(const std::string &file_path_name)
+    : data_(nullptr), size_(0), is_mapped_(false)
+{
+    if (!fs::exists(file_path_name))
+    {
+        std::cout << "\n Error: the input file:" << file_path_name << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+#ifndef _WIN32
+    int file_descriptor = open(file_path_name.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor != -1 && fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0)
+    {
+        void *address = mmap(nullptr, (size_t)file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (address != MAP_FAILED)
+        {
+            data_ = static_cast<const char *>(address);
+            size_ = (size_t)file_status.st_size;
+            is_mapped_ = true;
+        }
+    }
+    if (file_descriptor != -1)
+        close(file_descriptor); // the mapping stays valid
+#endif
+    if (!is_mapped_)
+    {
+        std::ifstream input_file(file_path_name, std::ios::binary | std::ios::ate);
+        buffer_.resize((size_t)input_file.tellg());
+        input_file.seekg(0);
+        input_file.read(buffer_.data(), buffer_.size());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+}
+//=================================================================================================//
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(other.data_), size_(other.size_), is_mapped_(other.is_mapped_), buffer_(std::move(other.buffer_))
+{
+    if (!is_mapped_)
+        data_ = buffer_.data(); // the moved buffer keeps its storage
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.is_mapped_ = false;
+}
+//=================================================================================================//
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        data_ = other.data_;
+        size_ = other.size_;
+        is_mapped_ = other.is_mapped_;
+        buffer_ = std::move(other.buffer_);
+        if (!is_mapped_)
+            data_ = buffer_.data();
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.is_mapped_ = false;
+    }
+    return *this;
+}
+//=================================================================================================//
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+//=================================================================================================//
+void MappedFile::unmap()
+{
+#ifndef _WIN32
+    if (is_mapped_)
+        munmap(const_cast<char *>(data_), size_);
+#endif
+    is_mapped_ = false;
+}
+//=================================================================================================//
+} // namespace SPH
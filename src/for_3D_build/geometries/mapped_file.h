@@ -0,0 +1,65 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	mapped_file.h
+ * @brief 	Read-only access to the content of large input files without copying.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "sph_data_containers.h"
+
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class MappedFile
+ * @brief Read-only view of the content of a file, memory mapped on POSIX systems
+ * and read into a buffer otherwise.
+ * @details The mapping is owned by a single object, hence it can be moved but not copied.
+ */
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string &file_path_name);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    ~MappedFile();
+    const char *Data() const { return data_; };
+    size_t Size() const { return size_; };
+
+  protected:
+    const char *data_;
+    size_t size_;
+    bool is_mapped_;
+    StdVec<char> buffer_;
+
+    void unmap();
+};
+} // namespace SPH
+#endif // MAPPED_FILE_H
@@ -0,0 +1,383 @@
+#include "triangle_mesh_bvh.h"
+
+namespace SPH
+{
+//=================================================================================================//
+void TriangleMeshBVH::build(const StdVec<Vec3d> &vertices, const StdVec<Array3i> &faces)
+{
+    if (faces.empty())
+    {
+        std::cout << "\n Error: no face is given for the triangle mesh BVH!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    vertices_ = vertices;
+    faces_ = faces;
+
+    StdVec<Vec3d> face_centroids(faces_.size());
+    for (size_t n = 0; n != faces_.size(); ++n)
+        face_centroids[n] = (vertices_[faces_[n][0]] + vertices_[faces_[n][1]] + vertices_[faces_[n][2]]) / 3.0;
+
+    nodes_.clear();
+    nodes_.reserve(2 * faces_.size()); // a binary tree with single-face leaves at most
+    Node root;
+    root.first_ = 0;
+    root.face_count_ = (int)faces_.size();
+    updateNodeBounds(root);
+    nodes_.push_back(root);
+    subdivideNode(0, face_centroids, 0);
+}
+//=================================================================================================//
+BoundingBox TriangleMeshBVH::getBounds() const
+{
+    return BoundingBox(nodes_[0].lower_bound_, nodes_[0].upper_bound_);
+}
+//=================================================================================================//
+void TriangleMeshBVH::updateNodeBounds(Node &node)
+{
+    node.lower_bound_ = Vec3d::Constant(MaxReal);
+    node.upper_bound_ = Vec3d::Constant(-MaxReal);
+    for (int n = node.first_; n != node.first_ + node.face_count_; ++n)
+        for (int k = 0; k != 3; ++k)
+        {
+            node.lower_bound_ = node.lower_bound_.cwiseMin(vertices_[faces_[n][k]]);
+            node.upper_bound_ = node.upper_bound_.cwiseMax(vertices_[faces_[n][k]]);
+        }
+}
+//=================================================================================================//
+void TriangleMeshBVH::subdivideNode(int node_index, StdVec<Vec3d> &face_centroids, int depth)
+{
+    // the traversal stack holds at most one entry per level plus the root
+    int first = nodes_[node_index].first_;
+    int face_count = nodes_[node_index].face_count_;
+    if (face_count <= max_leaf_size_ || depth >= max_depth_ - 2)
+        return;
+
+    Vec3d centroid_lower = Vec3d::Constant(MaxReal);
+    Vec3d centroid_upper = Vec3d::Constant(-MaxReal);
+    for (int n = first; n != first + face_count; ++n)
+    {
+        centroid_lower = centroid_lower.cwiseMin(face_centroids[n]);
+        centroid_upper = centroid_upper.cwiseMax(face_centroids[n]);
+    }
+
+    auto surface_area = [](const Vec3d &lower, const Vec3d &upper)
+    {
+        Vec3d extent = upper - lower;
+        return 2.0 * (extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0]);
+    };
+
+    // binned SAH: evaluate the splits between bins along each axis
+    Real best_cost = MaxReal;
+    int best_axis = -1;
+    int best_split = 0;
+    for (int axis = 0; axis != 3; ++axis)
+    {
+        Real extent = centroid_upper[axis] - centroid_lower[axis];
+        if (extent <= 0.0)
+            continue;
+        Real bin_scale = (Real)number_of_bins_ / extent;
+
+        int bin_count[number_of_bins_] = {0};
+        Vec3d bin_lower[number_of_bins_];
+        Vec3d bin_upper[number_of_bins_];
+        for (int b = 0; b != number_of_bins_; ++b)
+        {
+            bin_lower[b] = Vec3d::Constant(MaxReal);
+            bin_upper[b] = Vec3d::Constant(-MaxReal);
+        }
+        for (int n = first; n != first + face_count; ++n)
+        {
+            int b = SMIN(number_of_bins_ - 1, (int)((face_centroids[n][axis] - centroid_lower[axis]) * bin_scale));
+            bin_count[b]++;
+            for (int k = 0; k != 3; ++k)
+            {
+                bin_lower[b] = bin_lower[b].cwiseMin(vertices_[faces_[n][k]]);
+                bin_upper[b] = bin_upper[b].cwiseMax(vertices_[faces_[n][k]]);
+            }
+        }
+
+        Real left_area[number_of_bins_ - 1];
+        int left_count[number_of_bins_ - 1];
+        Vec3d lower = Vec3d::Constant(MaxReal);
+        Vec3d upper = Vec3d::Constant(-MaxReal);
+        int count = 0;
+        for (int b = 0; b != number_of_bins_ - 1; ++b)
+        {
+            count += bin_count[b];
+            lower = lower.cwiseMin(bin_lower[b]);
+            upper = upper.cwiseMax(bin_upper[b]);
+            left_count[b] = count;
+            left_area[b] = count == 0 ? 0.0 : surface_area(lower, upper);
+        }
+        lower = Vec3d::Constant(MaxReal);
+        upper = Vec3d::Constant(-MaxReal);
+        count = 0;
+        for (int b = number_of_bins_ - 1; b != 0; --b)
+        {
+            count += bin_count[b];
+            lower = lower.cwiseMin(bin_lower[b]);
+            upper = upper.cwiseMax(bin_upper[b]);
+            Real right_area = count == 0 ? 0.0 : surface_area(lower, upper);
+            Real cost = (Real)left_count[b - 1] * left_area[b - 1] + (Real)count * right_area;
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = b;
+            }
+        }
+    }
+
+    Node &node = nodes_[node_index];
+    Real leaf_cost = (Real)face_count * surface_area(node.lower_bound_, node.upper_bound_);
+    if (best_axis < 0 || best_cost >= leaf_cost)
+        return;
+
+    // partition the faces and their centroids by the chosen split
+    Real bin_scale = (Real)number_of_bins_ / (centroid_upper[best_axis] - centroid_lower[best_axis]);
+    int i = first;
+    int j = first + face_count - 1;
+    while (i <= j)
+    {
+        int b = SMIN(number_of_bins_ - 1,
+                     (int)((face_centroids[i][best_axis] - centroid_lower[best_axis]) * bin_scale));
+        if (b < best_split)
+            ++i;
+        else
+        {
+            std::swap(faces_[i], faces_[j]);
+            std::swap(face_centroids[i], face_centroids[j]);
+            --j;
+        }
+    }
+    int left_face_count = i - first;
+    if (left_face_count == 0 || left_face_count == face_count)
+        return;
+
+    int left_child = (int)nodes_.size();
+    Node left, right;
+    left.first_ = first;
+    left.face_count_ = left_face_count;
+    right.first_ = i;
+    right.face_count_ = face_count - left_face_count;
+    updateNodeBounds(left);
+    updateNodeBounds(right);
+    nodes_.push_back(left);
+    nodes_.push_back(right);
+    nodes_[node_index].first_ = left_child;
+    nodes_[node_index].face_count_ = 0;
+
+    subdivideNode(left_child, face_centroids, depth + 1);
+    subdivideNode(left_child + 1, face_centroids, depth + 1);
+}
+//=================================================================================================//
+Vec3d TriangleMeshBVH::findClosestPointOnFace(const Vec3d &probe_point, int face_id) const
+{
+    const Vec3d &a = vertices_[faces_[face_id][0]];
+    const Vec3d &b = vertices_[faces_[face_id][1]];
+    const Vec3d &c = vertices_[faces_[face_id][2]];
+
+    Vec3d ab = b - a;
+    Vec3d ac = c - a;
+    Vec3d ap = probe_point - a;
+    Real d1 = ab.dot(ap);
+    Real d2 = ac.dot(ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+        return a;
+
+    Vec3d bp = probe_point - b;
+    Real d3 = ab.dot(bp);
+    Real d4 = ac.dot(bp);
+    if (d3 >= 0.0 && d4 <= d3)
+        return b;
+
+    Real vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+        return a + d1 / (d1 - d3) * ab;
+
+    Vec3d cp = probe_point - c;
+    Real d5 = ab.dot(cp);
+    Real d6 = ac.dot(cp);
+    if (d6 >= 0.0 && d5 <= d6)
+        return c;
+
+    Real vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+        return a + d2 / (d2 - d6) * ac;
+
+    Real va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+
+    Real denominator = 1.0 / (va + vb + vc + TinyReal);
+    return a + ab * vb * denominator + ac * vc * denominator;
+}
+//=================================================================================================//
+Real TriangleMeshBVH::squaredDistanceToBox(const Vec3d &probe_point, const Node &node) const
+{
+    Vec3d outside = (node.lower_bound_ - probe_point).cwiseMax(probe_point - node.upper_bound_).cwiseMax(0.0);
+    return outside.squaredNorm();
+}
+//=================================================================================================//
+Vec3d TriangleMeshBVH::findClosestPoint(const Vec3d &probe_point, int &face_id) const
+{
+    Real best_squared_distance = MaxReal;
+    Vec3d closest_point = probe_point;
+    face_id = -1;
+
+    int stack[max_depth_];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const Node &node = nodes_[stack[--stack_size]];
+        if (squaredDistanceToBox(probe_point, node) >= best_squared_distance)
+            continue;
+
+        if (node.face_count_ > 0)
+        {
+            for (int n = node.first_; n != node.first_ + node.face_count_; ++n)
+            {
+                Vec3d face_point = findClosestPointOnFace(probe_point, n);
+                Real squared_distance = (probe_point - face_point).squaredNorm();
+                if (squared_distance < best_squared_distance)
+                {
+                    best_squared_distance = squared_distance;
+                    closest_point = face_point;
+                    face_id = n;
+                }
+            }
+        }
+        else
+        {
+            int near_child = node.first_;
+            int far_child = node.first_ + 1;
+            Real near_distance = squaredDistanceToBox(probe_point, nodes_[near_child]);
+            Real far_distance = squaredDistanceToBox(probe_point, nodes_[far_child]);
+            if (far_distance < near_distance)
+            {
+                std::swap(near_child, far_child);
+                std::swap(near_distance, far_distance);
+            }
+            // the nearer child is pushed last so that it is visited first
+            if (far_distance < best_squared_distance)
+                stack[stack_size++] = far_child;
+            if (near_distance < best_squared_distance)
+                stack[stack_size++] = near_child;
+        }
+    }
+    return closest_point;
+}
+//=================================================================================================//
+bool TriangleMeshBVH::checkRayHitsBox(const Vec3d &origin, const Vec3d &inverse_direction, const Node &node) const
+{
+    Vec3d t_lower = (node.lower_bound_ - origin).cwiseProduct(inverse_direction);
+    Vec3d t_upper = (node.upper_bound_ - origin).cwiseProduct(inverse_direction);
+    Real t_enter = t_lower.cwiseMin(t_upper).maxCoeff();
+    Real t_exit = t_lower.cwiseMax(t_upper).minCoeff();
+    return t_exit >= SMAX(t_enter, Real(0));
+}
+//=================================================================================================//
+bool TriangleMeshBVH::checkRayHitsFace(const Vec3d &origin, const Vec3d &direction, int face_id) const
+{
+    const Vec3d &a = vertices_[faces_[face_id][0]];
+    Vec3d edge_1 = vertices_[faces_[face_id][1]] - a;
+    Vec3d edge_2 = vertices_[faces_[face_id][2]] - a;
+    Vec3d p = direction.cross(edge_2);
+    Real determinant = edge_1.dot(p);
+    if (fabs(determinant) < TinyReal) // ray parallel to the face
+        return false;
+
+    Real inverse_determinant = 1.0 / determinant;
+    Vec3d s = origin - a;
+    Real u = s.dot(p) * inverse_determinant;
+    if (u < 0.0 || u > 1.0)
+        return false;
+    Vec3d q = s.cross(edge_1);
+    Real v = direction.dot(q) * inverse_determinant;
+    if (v < 0.0 || u + v > 1.0)
+        return false;
+    return edge_2.dot(q) * inverse_determinant > 0.0;
+}
+//=================================================================================================//
+int TriangleMeshBVH::countRayCrossings(const Vec3d &origin, const Vec3d &direction) const
+{
+    Vec3d inverse_direction = direction.cwiseInverse();
+    int crossings = 0;
+
+    int stack[max_depth_];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const Node &node = nodes_[stack[--stack_size]];
+        if (!checkRayHitsBox(origin, inverse_direction, node))
+            continue;
+
+        if (node.face_count_ > 0)
+        {
+            for (int n = node.first_; n != node.first_ + node.face_count_; ++n)
+                if (checkRayHitsFace(origin, direction, n))
+                    crossings++;
+        }
+        else
+        {
+            stack[stack_size++] = node.first_ + 1;
+            stack[stack_size++] = node.first_;
+        }
+    }
+    return crossings;
+}
+//=================================================================================================//
+bool TriangleMeshBVH::checkContain(const Vec3d &probe_point) const
+{
+    const Node &root = nodes_[0];
+    if ((probe_point.array() < root.lower_bound_.array()).any() ||
+        (probe_point.array() > root.upper_bound_.array()).any())
+        return false;
+
+    // skew directions, so that rays along mesh edges or axis-aligned faces are unlikely
+    static const Vec3d ray_directions[3] = {Vec3d(1.0, 0.3178, 0.1471).normalized(),
+                                            Vec3d(-0.2413, 1.0, 0.5727).normalized(),
+                                            Vec3d(0.4371, -0.6611, 1.0).normalized()};
+    int odd_votes = 0;
+    for (int k = 0; k != 3; ++k)
+    {
+        odd_votes += countRayCrossings(probe_point, ray_directions[k]) % 2;
+        if (odd_votes == 2 || k + 1 - odd_votes == 2) // majority already decided
+            break;
+    }
+    return odd_votes >= 2;
+}
+//=================================================================================================//
+void TriangleMeshBVH::findClosestPoints(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<Vec3d> &closest_points) const
+{
+    closest_points.resize(probe_points.size());
+    parallel_for(
+        IndexRange(0, probe_points.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                int face_id;
+                closest_points[i] = findClosestPoint(probe_points[i], face_id);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void TriangleMeshBVH::checkContain(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<int> &is_contained) const
+{
+    is_contained.resize(probe_points.size());
+    parallel_for(
+        IndexRange(0, probe_points.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                is_contained[i] = checkContain(probe_points[i]) ? 1 : 0;
+        },
+        ap);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,97 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	triangle_mesh_bvh.h
+ * @brief 	Bounding volume hierarchy over the faces of a triangle mesh.
+ * @details The hierarchy is built once with the binned surface area heuristic (SAH)
+ *          and is read-only afterwards, so that closest point and containment queries
+ *          can be issued concurrently from many threads without locks.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef TRIANGLE_MESH_BVH_H
+#define TRIANGLE_MESH_BVH_H
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+namespace SPH
+{
+/**
+ * @class TriangleMeshBVH
+ * @brief SAH bounding volume hierarchy for closest point and inside/outside queries on a triangle mesh.
+ * @details Closest point queries traverse the nearer child first and prune nodes
+ * whose box is farther than the current best candidate.
+ * Containment is decided by the parity of ray crossings, voted over three skew ray directions,
+ * which is reliable for closed meshes at any distance from the surface
+ * and tolerant to rays grazing an edge or a vertex.
+ */
+class TriangleMeshBVH
+{
+  public:
+    TriangleMeshBVH(){};
+    ~TriangleMeshBVH(){};
+
+    /** Build the hierarchy, faces are given by the indices of their three vertices. */
+    void build(const StdVec<Vec3d> &vertices, const StdVec<Array3i> &faces);
+    bool isBuilt() const { return !nodes_.empty(); };
+    size_t NumberOfFaces() const { return faces_.size(); };
+    const StdVec<Vec3d> &getVertices() const { return vertices_; };
+    const StdVec<Array3i> &getFaces() const { return faces_; };
+    BoundingBox getBounds() const;
+
+    Vec3d findClosestPoint(const Vec3d &probe_point, int &face_id) const;
+    bool checkContain(const Vec3d &probe_point) const;
+    /** Batched queries, evaluated in parallel over the probe points. */
+    void findClosestPoints(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<Vec3d> &closest_points) const;
+    void checkContain(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<int> &is_contained) const;
+
+  protected:
+    /** A leaf node has a positive face count and holds the faces
+     * [first_, first_ + face_count_) of the reordered face list.
+     * An inner node has its two children at first_ and first_ + 1. */
+    struct Node
+    {
+        Vec3d lower_bound_;
+        Vec3d upper_bound_;
+        int first_;
+        int face_count_;
+    };
+    static constexpr int max_leaf_size_ = 4;
+    static constexpr int number_of_bins_ = 12;
+    static constexpr int max_depth_ = 64;
+
+    StdVec<Vec3d> vertices_;
+    StdVec<Array3i> faces_; /**< reordered so that each leaf holds a contiguous range. */
+    StdVec<Node> nodes_;
+
+    void subdivideNode(int node_index, StdVec<Vec3d> &face_centroids, int depth);
+    void updateNodeBounds(Node &node);
+    Vec3d findClosestPointOnFace(const Vec3d &probe_point, int face_id) const;
+    Real squaredDistanceToBox(const Vec3d &probe_point, const Node &node) const;
+    bool checkRayHitsBox(const Vec3d &origin, const Vec3d &inverse_direction, const Node &node) const;
+    bool checkRayHitsFace(const Vec3d &origin, const Vec3d &direction, int face_id) const;
+    int countRayCrossings(const Vec3d &origin, const Vec3d &direction) const;
+};
+} // namespace SPH
+#endif // TRIANGLE_MESH_BVH_H
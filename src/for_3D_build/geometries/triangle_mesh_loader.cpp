@@ -0,0 +1,385 @@
+#include "triangle_mesh_loader.h"
+
+#include "tbb/concurrent_hash_map.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+namespace fs = std::filesystem;
+
+namespace SPH
+{
+namespace
+{
+constexpr size_t text_chunk_size = 1 << 22; /**< bytes of text parsed by one task. */
+//=================================================================================================//
+/** Apply the function to the lines starting within [chunk_begin, chunk_end). */
+template <typename LineFunction>
+void for_each_line_in_chunk(const char *data, size_t size, size_t chunk_begin, size_t chunk_end,
+                            const LineFunction &line_function)
+{
+    size_t line_begin = chunk_begin;
+    while (line_begin != 0 && line_begin < size && data[line_begin - 1] != '\n')
+        ++line_begin; // the line belongs to the previous chunk
+    while (line_begin < chunk_end && line_begin < size)
+    {
+        size_t line_end = line_begin;
+        while (line_end < size && data[line_end] != '\n')
+            ++line_end;
+        line_function(data + line_begin, data + line_end);
+        line_begin = line_end + 1;
+    }
+}
+//=================================================================================================//
+const char *skipSpaces(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+    return p;
+}
+//=================================================================================================//
+/** Check whether the line continues with the keyword followed by a space, and skip it if so. */
+bool checkKeyword(const char *&p, const char *end, const char *keyword)
+{
+    size_t length = std::strlen(keyword);
+    if (size_t(end - p) <= length || std::strncmp(p, keyword, length) != 0 ||
+        (p[length] != ' ' && p[length] != '\t'))
+        return false;
+    p += length;
+    return true;
+}
+//=================================================================================================//
+/** The token is copied as the mapped file is not null terminated. */
+bool parseReal(const char *&p, const char *end, Real &value)
+{
+    p = skipSpaces(p, end);
+    char token[64];
+    size_t n = 0;
+    while (p < end && n != 63 && (std::isdigit((unsigned char)*p) || *p == '+' || *p == '-' ||
+                                  *p == '.' || *p == 'e' || *p == 'E'))
+        token[n++] = *p++;
+    token[n] = '\0';
+    if (n == 0)
+        return false;
+    value = (Real)std::strtod(token, nullptr);
+    return true;
+}
+//=================================================================================================//
+/** Parse the vertex index of an OBJ face corner, given as v, v/vt, v//vn or v/vt/vn. */
+bool parseCornerIndex(const char *&p, const char *end, long &index)
+{
+    p = skipSpaces(p, end);
+    char token[32];
+    size_t n = 0;
+    while (p < end && n != 31 && (std::isdigit((unsigned char)*p) || *p == '-'))
+        token[n++] = *p++;
+    token[n] = '\0';
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\r')
+        ++p; // texture and normal indices are not used
+    if (n == 0)
+        return false;
+    index = std::strtol(token, nullptr, 10);
+    return index != 0;
+}
+//=================================================================================================//
+struct VertexHashCompare
+{
+    static size_t hash(const Vec3d &vertex)
+    {
+        size_t result = 0;
+        for (int k = 0; k != 3; ++k) // negative zero is hashed as zero
+            result = result * 31 + std::hash<Real>()(vertex[k] == 0.0 ? Real(0) : vertex[k]);
+        return result;
+    }
+    static bool equal(const Vec3d &a, const Vec3d &b) { return a == b; }
+};
+//=================================================================================================//
+void reportLoadingError(const std::string &message)
+{
+    std::cout << "\n Error: " << message << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+} // namespace
+//=================================================================================================//
+TriangleMeshLoader::TriangleMeshLoader(const std::string &file_path_name)
+{
+    MappedFile file(file_path_name);
+    const char *data = file.Data();
+    size_t size = file.Size();
+
+    std::string extension = fs::path(file_path_name).extension().string();
+    for (char &c : extension)
+        c = (char)std::tolower((unsigned char)c);
+
+    if (extension == ".obj")
+    {
+        loadOBJ(data, size);
+    }
+    else
+    {
+        /** A binary STL is recognized by its size, as its header may also start with "solid". */
+        uint32_t number_of_faces = 0;
+        if (size >= 84)
+            std::memcpy(&number_of_faces, data + 80, 4);
+        const char *first_word = skipSpaces(data, data + size);
+        bool is_ascii = size_t(data + size - first_word) > 5 && std::strncmp(first_word, "solid", 5) == 0;
+        if (size >= 84 && 84 + 50 * size_t(number_of_faces) == size)
+            loadBinarySTL(data, size);
+        else if (is_ascii)
+            loadAsciiSTL(data, size);
+        else if (size >= 84 && 84 + 50 * size_t(number_of_faces) < size)
+            loadBinarySTL(data, size); // with trailing bytes
+        else
+            reportLoadingError("the file:" + file_path_name + " is neither a binary nor an ASCII STL file");
+    }
+
+    removeDegenerateFaces();
+    if (faces_.empty())
+        reportLoadingError("no valid triangle is found in the file:" + file_path_name);
+    std::cout << "num of faces:" << faces_.size() << std::endl;
+}
+//=================================================================================================//
+void TriangleMeshLoader::transform(const Mat3d &rotation, const Vec3d &translation, Real scale_factor)
+{
+    parallel_for(
+        IndexRange(0, vertices_.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                vertices_[i] = rotation * (scale_factor * vertices_[i]) + translation;
+        },
+        ap);
+}
+//=================================================================================================//
+void TriangleMeshLoader::loadBinarySTL(const char *data, size_t size)
+{
+    uint32_t number_of_faces;
+    std::memcpy(&number_of_faces, data + 80, 4);
+    StdVec<Vec3d> corners(3 * size_t(number_of_faces));
+    parallel_for(
+        IndexRange(0, number_of_faces),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                float values[12]; // normal and three vertices in little-endian single precision
+                std::memcpy(values, data + 84 + 50 * n, sizeof(values));
+                for (int k = 0; k != 3; ++k)
+                    corners[3 * n + k] = Vec3d(values[3 + 3 * k], values[4 + 3 * k], values[5 + 3 * k]);
+            }
+        },
+        ap);
+    mergeCorners(corners);
+}
+//=================================================================================================//
+void TriangleMeshLoader::loadAsciiSTL(const char *data, size_t size)
+{
+    size_t number_of_chunks = size / text_chunk_size + 1;
+    StdVec<StdVec<Vec3d>> chunk_corners(number_of_chunks);
+    parallel_for(
+        IndexRange(0, number_of_chunks),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                for_each_line_in_chunk(
+                    data, size, i * text_chunk_size, (i + 1) * text_chunk_size,
+                    [&](const char *line_begin, const char *line_end)
+                    {
+                        const char *p = skipSpaces(line_begin, line_end);
+                        Vec3d corner;
+                        if (checkKeyword(p, line_end, "vertex") &&
+                            parseReal(p, line_end, corner[0]) &&
+                            parseReal(p, line_end, corner[1]) &&
+                            parseReal(p, line_end, corner[2]))
+                            chunk_corners[i].push_back(corner);
+                    });
+        },
+        ap);
+
+    StdVec<size_t> chunk_offsets(number_of_chunks + 1, 0);
+    for (size_t i = 0; i != number_of_chunks; ++i)
+        chunk_offsets[i + 1] = chunk_offsets[i] + chunk_corners[i].size();
+    if (chunk_offsets.back() % 3 != 0)
+        reportLoadingError("the number of vertices in the ASCII STL file is not a multiple of three");
+
+    StdVec<Vec3d> corners(chunk_offsets.back());
+    parallel_for(
+        IndexRange(0, number_of_chunks),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                std::copy(chunk_corners[i].begin(), chunk_corners[i].end(), corners.begin() + chunk_offsets[i]);
+        },
+        ap);
+    mergeCorners(corners);
+}
+//=================================================================================================//
+void TriangleMeshLoader::loadOBJ(const char *data, size_t size)
+{
+    /** Negative (relative) indices are resolved within the chunk first,
+     * and shifted by the vertex offset of the chunk afterwards. */
+    struct ObjChunk
+    {
+        StdVec<Vec3d> vertices_;
+        StdVec<Array3i> faces_;
+        StdVec<int> relative_corners_; /**< bit k set if corner k is given relative to the chunk. */
+        bool is_valid_ = true;
+    };
+    size_t number_of_chunks = size / text_chunk_size + 1;
+    StdVec<ObjChunk> chunks(number_of_chunks);
+    parallel_for(
+        IndexRange(0, number_of_chunks),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                ObjChunk &chunk = chunks[i];
+                StdVec<long> corner_indices;
+                StdVec<bool> is_relative;
+                for_each_line_in_chunk(
+                    data, size, i * text_chunk_size, (i + 1) * text_chunk_size,
+                    [&](const char *line_begin, const char *line_end)
+                    {
+                        const char *p = skipSpaces(line_begin, line_end);
+                        if (checkKeyword(p, line_end, "v"))
+                        {
+                            Vec3d vertex;
+                            if (parseReal(p, line_end, vertex[0]) && parseReal(p, line_end, vertex[1]) &&
+                                parseReal(p, line_end, vertex[2]))
+                                chunk.vertices_.push_back(vertex);
+                            else
+                                chunk.is_valid_ = false;
+                        }
+                        else if (checkKeyword(p, line_end, "f"))
+                        {
+                            corner_indices.clear();
+                            is_relative.clear();
+                            long index;
+                            while (parseCornerIndex(p, line_end, index))
+                            {
+                                is_relative.push_back(index < 0);
+                                corner_indices.push_back(index < 0 ? long(chunk.vertices_.size()) + index : index - 1);
+                            }
+                            if (corner_indices.size() < 3)
+                                chunk.is_valid_ = false;
+                            for (size_t k = 1; k + 1 < corner_indices.size(); ++k)
+                            {
+                                chunk.faces_.push_back(Array3i(corner_indices[0], corner_indices[k], corner_indices[k + 1]));
+                                chunk.relative_corners_.push_back(int(is_relative[0]) | int(is_relative[k]) << 1 |
+                                                                  int(is_relative[k + 1]) << 2);
+                            }
+                        }
+                    });
+            }
+        },
+        ap);
+
+    StdVec<size_t> vertex_offsets(number_of_chunks + 1, 0);
+    StdVec<size_t> face_offsets(number_of_chunks + 1, 0);
+    for (size_t i = 0; i != number_of_chunks; ++i)
+    {
+        if (!chunks[i].is_valid_)
+            reportLoadingError("invalid vertex or face in the OBJ file");
+        vertex_offsets[i + 1] = vertex_offsets[i] + chunks[i].vertices_.size();
+        face_offsets[i + 1] = face_offsets[i] + chunks[i].faces_.size();
+    }
+
+    vertices_.resize(vertex_offsets.back());
+    faces_.resize(face_offsets.back());
+    int number_of_vertices = (int)vertices_.size();
+    std::atomic<bool> is_index_valid(true);
+    parallel_for(
+        IndexRange(0, number_of_chunks),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                ObjChunk &chunk = chunks[i];
+                std::copy(chunk.vertices_.begin(), chunk.vertices_.end(), vertices_.begin() + vertex_offsets[i]);
+                for (size_t n = 0; n != chunk.faces_.size(); ++n)
+                {
+                    Array3i face = chunk.faces_[n];
+                    for (int k = 0; k != 3; ++k)
+                    {
+                        if (chunk.relative_corners_[n] & (1 << k))
+                            face[k] += (int)vertex_offsets[i];
+                        if (face[k] < 0 || face[k] >= number_of_vertices)
+                            is_index_valid = false;
+                    }
+                    faces_[face_offsets[i] + n] = face;
+                }
+            }
+        },
+        ap);
+    if (!is_index_valid)
+        reportLoadingError("a face of the OBJ file refers to a vertex which does not exist");
+}
+//=================================================================================================//
+void TriangleMeshLoader::mergeCorners(const StdVec<Vec3d> &corners)
+{
+    /** Each corner is mapped to its first occurrence, independent of the insertion order. */
+    using CornerMap = tbb::concurrent_hash_map<Vec3d, size_t, VertexHashCompare>;
+    CornerMap corner_map(corners.size() / 6 + 1);
+    parallel_for(
+        IndexRange(0, corners.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                CornerMap::accessor accessor;
+                if (!corner_map.insert(accessor, CornerMap::value_type(corners[i], i)))
+                    accessor->second = SMIN(accessor->second, i);
+            }
+        },
+        ap);
+
+    StdVec<size_t> first_occurrence(corners.size());
+    parallel_for(
+        IndexRange(0, corners.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                CornerMap::const_accessor accessor;
+                corner_map.find(accessor, corners[i]);
+                first_occurrence[i] = accessor->second;
+            }
+        },
+        ap);
+
+    StdVec<int> vertex_index(corners.size(), -1);
+    vertices_.clear();
+    vertices_.reserve(corner_map.size());
+    for (size_t i = 0; i != corners.size(); ++i)
+        if (first_occurrence[i] == i)
+        {
+            vertex_index[i] = (int)vertices_.size();
+            vertices_.push_back(corners[i]);
+        }
+
+    faces_.resize(corners.size() / 3);
+    parallel_for(
+        IndexRange(0, faces_.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+                for (int k = 0; k != 3; ++k)
+                    faces_[n][k] = vertex_index[first_occurrence[3 * n + k]];
+        },
+        ap);
+}
+//=================================================================================================//
+void TriangleMeshLoader::removeDegenerateFaces()
+{
+    faces_.erase(std::remove_if(faces_.begin(), faces_.end(),
+                                [](const Array3i &face)
+                                { return face[0] == face[1] || face[1] == face[2] || face[2] == face[0]; }),
+                 faces_.end());
+}
+//=================================================================================================//
+} // namespace SPH
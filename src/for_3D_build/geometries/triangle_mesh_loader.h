@@ -0,0 +1,73 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	triangle_mesh_loader.h
+ * @brief 	Native loader of triangle meshes from binary STL, ASCII STL and OBJ files.
+ * @details The file is memory mapped and parsed in parallel chunks.
+ *          The corners of STL facets are merged into shared vertices with a concurrent hash map,
+ *          and the result is a compact indexed triangle list, which feeds TriangleMeshShape
+ *          without conversion to a SimTK polygonal mesh.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef TRIANGLE_MESH_LOADER_H
+#define TRIANGLE_MESH_LOADER_H
+
+#include "base_data_package.h"
+#include "mapped_file.h"
+#include "sph_data_containers.h"
+
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class TriangleMeshLoader
+ * @brief Load a triangle mesh, the format is decided by the file extension (.stl or .obj)
+ * and, for STL, by the file size and header.
+ * @details Faces with repeated vertices are removed. Polygonal OBJ faces are triangulated as fans.
+ */
+class TriangleMeshLoader
+{
+  public:
+    explicit TriangleMeshLoader(const std::string &file_path_name);
+    ~TriangleMeshLoader(){};
+
+    /** Applied as rotation * (scale_factor * vertex) + translation. */
+    void transform(const Mat3d &rotation, const Vec3d &translation, Real scale_factor);
+    StdVec<Vec3d> &getVertices() { return vertices_; };
+    StdVec<Array3i> &getFaces() { return faces_; };
+
+  protected:
+    StdVec<Vec3d> vertices_;
+    StdVec<Array3i> faces_;
+
+    void loadBinarySTL(const char *data, size_t size);
+    void loadAsciiSTL(const char *data, size_t size);
+    void loadOBJ(const char *data, size_t size);
+    /** Merge bit-wise identical corners, every three consecutive corners form a face. */
+    void mergeCorners(const StdVec<Vec3d> &corners);
+    void removeDegenerateFaces();
+};
+} // namespace SPH
+#endif // TRIANGLE_MESH_LOADER_H
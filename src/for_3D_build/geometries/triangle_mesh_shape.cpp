@@ -15,11 +15,47 @@ SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::generateTriangleMesh(co
     }
     std::cout << "num of faces:" << triangle_mesh->getNumFaces() << std::endl;
 
+    StdVec<Vec3d> vertices(triangle_mesh->getNumVertices());
+    for (size_t i = 0; i != vertices.size(); ++i)
+        vertices[i] = SimTKToEigen(triangle_mesh->getVertexPosition((int)i));
+    StdVec<Array3i> faces(triangle_mesh->getNumFaces());
+    for (size_t i = 0; i != faces.size(); ++i)
+        faces[i] = Array3i(triangle_mesh->getFaceVertex((int)i, 0),
+                           triangle_mesh->getFaceVertex((int)i, 1),
+                           triangle_mesh->getFaceVertex((int)i, 2));
+    bvh_.build(vertices, faces);
+
     return triangle_mesh;
 }
 //=================================================================================================//
+void TriangleMeshShape::loadTriangleMesh(const std::string &file_path_name, const Mat3d &rotation,
+                                         const Vec3d &translation, Real scale_factor)
+{
+    TriangleMeshLoader loader(file_path_name);
+    loader.transform(rotation, translation, scale_factor);
+    bvh_.build(loader.getVertices(), loader.getFaces());
+}
+//=================================================================================================//
 SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::getTriangleMesh()
 {
+    std::call_once(
+        triangle_mesh_generation_,
+        [&]()
+        {
+            if (triangle_mesh_ != nullptr || !bvh_.isBuilt())
+                return;
+            SimTK::PolygonalMesh poly_mesh;
+            for (const Vec3d &vertex : bvh_.getVertices())
+                poly_mesh.addVertex(SimTKVec3(vertex[0], vertex[1], vertex[2]));
+            SimTK::Array_<int> face_vertices(3);
+            for (const Array3i &face : bvh_.getFaces())
+            {
+                for (int k = 0; k != 3; ++k)
+                    face_vertices[k] = face[k];
+                poly_mesh.addFace(face_vertices);
+            }
+            triangle_mesh_ = triangle_mesh_ptr_keeper_.createPtr<SimTK::ContactGeometry::TriangleMesh>(poly_mesh);
+        });
     if (triangle_mesh_ == nullptr)
     {
         std::cout << "\n Error: TriangleMesh not setup yet! \n";
@@ -31,107 +67,46 @@ SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::getTriangleMesh()
 //=================================================================================================//
 bool TriangleMeshShape::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
 {
-    SimTKVec2 uv_coordinate;
-    bool inside = false; // note that direct prediction is not reliable sometime.
-    int face_id;
-
-    SimTKVec3 closest_pnt = triangle_mesh_->findNearestPoint(EigenToSimTK(probe_point), inside, face_id, uv_coordinate);
-    Vec3d from_face_to_pnt = probe_point - SimTKToEigen(closest_pnt);
-    Real distance_to_pnt = from_face_to_pnt.norm();
-    Vec3d direction_to_pnt = from_face_to_pnt / (distance_to_pnt + TinyReal);
-    Vec3d face_normal = SimTKToEigen(triangle_mesh_->getFaceNormal(face_id));
-    Real cosine_angle = face_normal.dot(direction_to_pnt);
-
-    int ite = 0;
-    while (fabs(cosine_angle) < Eps)
-    {
-        Vec3d jittered = probe_point; // jittering
-        for (int l = 0; l != probe_point.size(); ++l)
-            jittered[l] = probe_point[l] + rand_uniform(-0.5, 0.5) * (SqrtEps + distance_to_pnt * 0.1);
-        Vec3d from_face_to_jittered = jittered - SimTKToEigen(closest_pnt);
-        Vec3d direction_to_jittered = from_face_to_jittered / (from_face_to_jittered.norm() + TinyReal);
-        cosine_angle = face_normal.dot(direction_to_jittered);
-
-        ite++;
-        if (ite > 100)
-        {
-            std::cout << "\n Error: TriangleMeshShape::checkContain not able to achieve!  " << std::endl;
-            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-            exit(1);
-        }
-    }
-
-    return cosine_angle < 0.0 ? true : false;
+    return bvh_.checkContain(probe_point);
 }
 //=================================================================================================//
 Vecd TriangleMeshShape::findClosestPoint(const Vecd &probe_point)
 {
-    bool inside = false;
     int face_id;
-    SimTKVec2 norm;
-    SimTKVec3 closest_pnt = triangle_mesh_->findNearestPoint(SimTKVec3(probe_point[0], probe_point[1], probe_point[2]), inside, face_id, norm);
-    if (face_id < 0 && face_id > triangle_mesh_->getNumFaces())
+    Vec3d closest_point = bvh_.findClosestPoint(probe_point, face_id);
+    if (face_id < 0)
     {
         std::cout << "\n Error the nearest point is not valid" << std::endl;
         std::cout << __FILE__ << ':' << __LINE__ << std::endl;
         throw;
     }
-    return Vecd(closest_pnt[0], closest_pnt[1], closest_pnt[2]);
+    return closest_point;
+}
+//=================================================================================================//
+void TriangleMeshShape::checkContain(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<int> &is_contained)
+{
+    bvh_.checkContain(probe_points, is_contained);
+}
+//=================================================================================================//
+void TriangleMeshShape::findClosestPoints(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<Vec3d> &closest_points)
+{
+    bvh_.findClosestPoints(probe_points, closest_points);
 }
 //=================================================================================================//
 BoundingBox TriangleMeshShape::findBounds()
 {
-    int number_of_vertices = triangle_mesh_->getNumVertices();
-    // initial reference values
-    Vec3d lower_bound = SimTKToEigen(SimTKVec3(MaxReal));
-    Vec3d upper_bound = SimTKToEigen(SimTKVec3(MinReal));
-    for (int i = 0; i != number_of_vertices; ++i)
-    {
-        Vec3d vertex_position = SimTKToEigen(triangle_mesh_->getVertexPosition(i));
-        for (int j = 0; j != 3; ++j)
-        {
-            lower_bound[j] = SMIN(lower_bound[j], vertex_position[j]);
-            upper_bound[j] = SMAX(upper_bound[j], vertex_position[j]);
-        }
-    }
-    return BoundingBox(lower_bound, upper_bound);
+    return bvh_.getBounds();
 }
 //=================================================================================================//
 TriangleMeshShapeSTL::TriangleMeshShapeSTL(const std::string &filepathname, Vecd translation, Real scale_factor,
                                            const std::string &shape_name)
-    : TriangleMeshShape(shape_name)
-{
-    if (!fs::exists(filepathname))
-    {
-        std::cout << "\n Error: the input file:" << filepathname << " is not exists" << std::endl;
-        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-        throw;
-    }
-    SimTK::PolygonalMesh polymesh;
-    polymesh.loadStlFile(filepathname);
-    polymesh.scaleMesh(scale_factor);
-    triangle_mesh_ = generateTriangleMesh(polymesh.transformMesh(SimTKVec3(translation[0], translation[1], translation[2])));
-}
+    : TriangleMeshShapeSTL(filepathname, Mat3d::Identity(), translation, scale_factor, shape_name) {}
 //=================================================================================================//
 TriangleMeshShapeSTL::TriangleMeshShapeSTL(const std::string &filepathname, Mat3d rotation,
                                            Vec3d translation, Real scale_factor, const std::string &shape_name)
     : TriangleMeshShape(shape_name)
 {
-    if (!fs::exists(filepathname))
-    {
-        std::cout << "\n Error: the input file:" << filepathname << " is not exists" << std::endl;
-        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-        throw;
-    }
-    SimTK::PolygonalMesh polymesh;
-    polymesh.loadStlFile(filepathname);
-
-    polymesh.scaleMesh(scale_factor);
-    SimTK::Transform_<double> transform(SimTK::Rotation_<double>(SimTKMat33((double)rotation(0, 0), (double)rotation(0, 1), (double)rotation(0, 2),
-                                                                            (double)rotation(1, 0), (double)rotation(1, 1), (double)rotation(1, 2),
-                                                                            (double)rotation(2, 0), (double)rotation(2, 1), (double)rotation(2, 2))),
-                                        SimTKVec3((double)translation[0], (double)translation[1], (double)translation[2]));
-    triangle_mesh_ = generateTriangleMesh(polymesh.transformMesh(transform));
+    loadTriangleMesh(filepathname, rotation, translation, scale_factor);
 }
 //=================================================================================================//
 #ifdef __EMSCRIPTEN__
@@ -146,6 +121,17 @@ TriangleMeshShapeSTL::TriangleMeshShapeSTL(const uint8_t *buffer, Vecd translati
 }
 #endif
 //=================================================================================================//
+TriangleMeshShapeOBJ::TriangleMeshShapeOBJ(const std::string &filepathname, Vecd translation, Real scale_factor,
+                                           const std::string &shape_name)
+    : TriangleMeshShapeOBJ(filepathname, Mat3d::Identity(), translation, scale_factor, shape_name) {}
+//=================================================================================================//
+TriangleMeshShapeOBJ::TriangleMeshShapeOBJ(const std::string &filepathname, Mat3d rotation,
+                                           Vec3d translation, Real scale_factor, const std::string &shape_name)
+    : TriangleMeshShape(shape_name)
+{
+    loadTriangleMesh(filepathname, rotation, translation, scale_factor);
+}
+//=================================================================================================//
 TriangleMeshShapeBrick::TriangleMeshShapeBrick(Vecd halfsize, int resolution, Vecd translation,
                                                const std::string &shape_name)
     : TriangleMeshShape(shape_name)
@@ -32,10 +32,13 @@
 
 #include "all_simbody.h"
 #include "base_geometry.h"
+#include "triangle_mesh_bvh.h"
+#include "triangle_mesh_loader.h"
 
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <string>
 namespace fs = std::filesystem;
 
@@ -44,6 +47,8 @@ namespace SPH
 /**
  * @class TriangleMeshShape
  * @brief Derived class for triangle shape processing.
+ * @details Geometric queries are answered by a bounding volume hierarchy built
+ * from the triangle mesh, which is thread safe and also offers batched queries.
  */
 class TriangleMeshShape : public Shape
 {
@@ -57,25 +62,34 @@ class TriangleMeshShape : public Shape
         if (mesh)
             triangle_mesh_ = generateTriangleMesh(*mesh);
     };
-    /** Only reliable when the probe point is close to the shape surface.
-     * Need to be combined with level set shape and sign correction to avoid artifacts
-     * when probe distance is far from the surface. */
+    /** Decided by ray crossing parity, hence requires a closed mesh. */
     virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
+    /** Batched queries evaluated in parallel, results are resized to the number of probe points. */
+    void checkContain(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<int> &is_contained);
+    void findClosestPoints(const StdLargeVec<Vec3d> &probe_points, StdLargeVec<Vec3d> &closest_points);
 
+    /** For meshes loaded natively, the SimTK triangle mesh is generated on the first request,
+     * once also when requested from several threads. */
     SimTK::ContactGeometry::TriangleMesh *getTriangleMesh();
+    TriangleMeshBVH &getBVH() { return bvh_; };
 
   protected:
     SimTK::ContactGeometry::TriangleMesh *triangle_mesh_;
+    std::once_flag triangle_mesh_generation_;
+    TriangleMeshBVH bvh_;
 
     /** generate triangle mesh from polygon mesh */
     SimTK::ContactGeometry::TriangleMesh *generateTriangleMesh(const SimTK::PolygonalMesh &poly_mesh);
+    /** load a mesh file by TriangleMeshLoader, without SimTK conversion. */
+    void loadTriangleMesh(const std::string &file_path_name, const Mat3d &rotation,
+                          const Vec3d &translation, Real scale_factor);
     virtual BoundingBox findBounds() override;
 };
 
 /**
  * @class TriangleMeshShapeSTL
- * @brief Input triangle mesh with stl file.
+ * @brief Input triangle mesh with binary or ASCII stl file.
  */
 class TriangleMeshShapeSTL : public TriangleMeshShape
 {
@@ -91,6 +105,20 @@ class TriangleMeshShapeSTL : public TriangleMeshShape
     virtual ~TriangleMeshShapeSTL(){};
 };
 
+/**
+ * @class TriangleMeshShapeOBJ
+ * @brief Input triangle mesh with obj file, polygonal faces are triangulated.
+ */
+class TriangleMeshShapeOBJ : public TriangleMeshShape
+{
+  public:
+    explicit TriangleMeshShapeOBJ(const std::string &file_path_name, Vec3d translation, Real scale_factor,
+                                  const std::string &shape_name = "TriangleMeshShapeOBJ");
+    explicit TriangleMeshShapeOBJ(const std::string &file_path_name, Mat3d rotation, Vec3d translation,
+                                  Real scale_factor, const std::string &shape_name = "TriangleMeshShapeOBJ");
+    virtual ~TriangleMeshShapeOBJ(){};
+};
+
 /**
  * @class TriangleMeshShapeBrick
  * @brief Generate a brick triangle mesh using SIMBODy default shape.
@@ -25,11 +25,13 @@ void CellLinkedList ::deleteMeshDataMatrix()
 //=================================================================================================//
 void CellLinkedList::clearCellLists()
 {
-    mesh_parallel_for(MeshRange(Array3i::Zero(), all_cells_),
+    mesh_parallel_for(active_cells_,
                       [&](int i, int j, int k)
                       {
                           cell_index_lists_[i][j][k].clear();
+                          cell_data_lists_[i][j][k].clear();
                       });
+    active_cells_ = MeshRange(Array3i::Zero(), Array3i::Zero());
 }
 //=================================================================================================//
 void CellLinkedList::UpdateCellListData(BaseParticles &base_particles)
@@ -37,7 +39,7 @@ void CellLinkedList::UpdateCellListData(BaseParticles &base_particles)
     StdLargeVec<Vecd> &pos = base_particles.pos_;
     StdLargeVec<Real> &Vol = base_particles.Vol_;
     mesh_parallel_for(
-        MeshRange(Array3i::Zero(), all_cells_),
+        active_cells_,
         [&](int i, int j, int k)
         {
             cell_data_lists_[i][j][k].clear();
@@ -54,7 +56,7 @@ void CellLinkedList::updateSplitCellLists(SplitCellLists &split_cell_lists)
 {
     clearSplitCellLists(split_cell_lists);
     mesh_parallel_for(
-        MeshRange(Array3i::Zero(), all_cells_),
+        active_cells_,
         [&](int i, int j, int k)
         {
             size_t real_particles_in_cell = cell_index_lists_[i][j][k].size();
@@ -76,6 +78,7 @@ void CellLinkedList ::InsertListDataEntry(size_t particle_index,
                                           const Vecd &particle_position, Real volumetric)
 {
     Array3i cell_pos = CellIndexFromPosition(particle_position);
+    extendActiveCells(cell_pos);
     cell_data_lists_[cell_pos[0]][cell_pos[1]][cell_pos[2]].emplace_back(
         std::make_tuple(particle_index, particle_position, volumetric));
 }
@@ -60,6 +60,16 @@ DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
 }
 //=================================================================================================//
 template <int PKG_SIZE, int ADDRS_BUFFER>
+template <class DataType>
+DataType GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
+    probePackage(const MeshVariable<DataType> &mesh_variable, const Vecd &position)
+{
+    PackageDataAddress<DataType> &pkg_data_addrs = getPackageDataAddress(mesh_variable);
+    return isInnerPackage() ? probeDataPackage<DataType>(pkg_data_addrs, position)
+                            : *pkg_data_addrs[0][0][0];
+}
+//=================================================================================================//
+template <int PKG_SIZE, int ADDRS_BUFFER>
 template <typename InDataType, typename OutDataType>
 void GridDataPackage<PKG_SIZE, ADDRS_BUFFER>::
     computeGradient(const MeshVariable<InDataType> &in_variable,
@@ -164,8 +174,7 @@ DataType MeshWithGridDataPackages<GridDataPackageType>::
         cell_index_on_mesh_[n] = cell_index_in_this_direction;
         local_data_index[n] = global_grid_index[n] - cell_index_in_this_direction * pkg_size;
     }
-    auto &data = data_pkg_addrs_[cell_index_on_mesh_[0]][cell_index_on_mesh_[1]][cell_index_on_mesh_[2]]
-                     ->getPackageData(mesh_variable);
+    auto &data = DataPackageFromCellIndex(cell_index_on_mesh_)->getPackageData(mesh_variable);
     return data[local_data_index[0]][local_data_index[1]][local_data_index[2]];
 }
 //=================================================================================================//
@@ -177,7 +186,7 @@ void MeshWithGridDataPackages<GridDataPackageType>::
     int j = cell_index[1];
     int k = cell_index[2];
 
-    GridDataPackageType *data_pkg = data_pkg_addrs_[i][j][k];
+    GridDataPackageType *data_pkg = DataPackageFromCellIndex(cell_index);
     if (data_pkg->isInnerPackage())
     {
         for (int l = 0; l != pkg_addrs_size; ++l)
@@ -190,36 +199,24 @@ void MeshWithGridDataPackages<GridDataPackageType>::
 
                     data_pkg->assignPackageDataAddress(
                         Arrayi(l, m, n),
-                        data_pkg_addrs_[i + x_pair.first][j + y_pair.first][k + z_pair.first],
+                        DataPackageFromCellIndex(Arrayi(i + x_pair.first, j + y_pair.first, k + z_pair.first)),
                         Arrayi(x_pair.second, y_pair.second, z_pair.second));
                 }
     }
 }
 //=================================================================================================//
 template <class GridDataPackageType>
-void MeshWithGridDataPackages<GridDataPackageType>::allocateMeshDataMatrix()
-{
-    Allocate3dArray(data_pkg_addrs_, all_cells_);
-}
-//=================================================================================================//
-template <class GridDataPackageType>
-void MeshWithGridDataPackages<GridDataPackageType>::deleteMeshDataMatrix()
-{
-    Delete3dArray(data_pkg_addrs_, all_cells_);
-}
-//=================================================================================================//
-template <class GridDataPackageType>
 void MeshWithGridDataPackages<GridDataPackageType>::
     assignDataPackageAddress(const Arrayi &cell_index, GridDataPackageType *data_pkg)
 {
-    data_pkg_addrs_[cell_index[0]][cell_index[1]][cell_index[2]] = data_pkg;
+    data_pkg_addrs_.assignPackage(cell_index, data_pkg);
 }
 //=================================================================================================//
 template <class GridDataPackageType>
 GridDataPackageType *MeshWithGridDataPackages<GridDataPackageType>::
     DataPackageFromCellIndex(const Arrayi &cell_index)
 {
-    return data_pkg_addrs_[cell_index[0]][cell_index[1]][cell_index[2]];
+    return data_pkg_addrs_.PackageFromCellIndex(cell_index);
 }
 //=================================================================================================//
 template <class GridDataPackageType>
@@ -228,7 +225,7 @@ DataType MeshWithGridDataPackages<GridDataPackageType>::
     probeMesh(const MeshVariable<DataType> &mesh_variable, const Vecd &position)
 {
     Arrayi index = CellIndexFromPosition(position);
-    GridDataPackageType *data_pkg = data_pkg_addrs_[index[0]][index[1]][index[2]];
+    GridDataPackageType *data_pkg = DataPackageFromCellIndex(index);
     auto &pkg_data_addrs = data_pkg->getPackageDataAddress(mesh_variable);
     return data_pkg->isInnerPackage() ? data_pkg->GridDataPackageType::
                                             template probeDataPackage<DataType>(pkg_data_addrs, position)
@@ -101,13 +101,16 @@ class BarCorrectConfiguration : public LocalDynamics, public BarDataInner
     {
         /** A small number is added to diagonal to avoid dividing by zero. */
         Matd global_configuration = Eps * Matd::Identity();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            Vecd r_ji = -inner_neighborhood.r_ij_[n] * inner_neighborhood.e_ij_[n];
-            global_configuration += r_ji * gradW_ijV_j.transpose();
-        }
+        onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    Vecd r_ji = -inner_neighborhood.r_ij_[n] * inner_neighborhood.e_ij_[n];
+                    global_configuration += r_ji * gradW_ijV_j.transpose();
+                }
+            });
         Matd local_configuration =
             transformation_matrix_[index_i] * global_configuration * transformation_matrix_[index_i].transpose();
         /** correction matrix is obtained from local configuration. */
@@ -142,15 +145,18 @@ class BarDeformationGradientTensor : public LocalDynamics, public BarDataInner
         Matd deformation_part_one = Matd::Zero();
         Matd deformation_part_two = Matd::Zero();
         Matd deformation_part_three = Matd::Zero();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-            Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            deformation_part_one -= (pos_n_i - pos_[index_j]) * gradW_ijV_j.transpose();
-            deformation_part_two -= ((pseudo_n_i - n0_[index_i]) - (pseudo_n_[index_j] - n0_[index_j])) * gradW_ijV_j.transpose();
-            deformation_part_three -= ((pseudo_b_n_i - b_n0_[index_i]) - (pseudo_b_n_[index_j] - b_n0_[index_j])) * gradW_ijV_j.transpose();
-        }
+        onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+                    Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    deformation_part_one -= (pos_n_i - pos_[index_j]) * gradW_ijV_j.transpose();
+                    deformation_part_two -= ((pseudo_n_i - n0_[index_i]) - (pseudo_n_[index_j] - n0_[index_j])) * gradW_ijV_j.transpose();
+                    deformation_part_three -= ((pseudo_b_n_i - b_n0_[index_i]) - (pseudo_b_n_[index_j] - b_n0_[index_j])) * gradW_ijV_j.transpose();
+                }
+            });
         F_[index_i] = transformation_matrix_i * deformation_part_one * transformation_matrix_i.transpose() * B_[index_i];
         F_[index_i].col(Dimensions - 1) = transformation_matrix_i * pseudo_n_[index_i];
         F_[index_i].col(Dimensions - 2) = transformation_matrix_i * pseudo_b_n_[index_i];
@@ -216,18 +222,21 @@ class BarStressRelaxationFirstHalf : public BaseBarRelaxation
         Vecd pseudo_normal_acceleration = global_shear_stress_i;
         Vecd pseudo_b_normal_acceleration = global_b_shear_stress_i;
 
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-
-            force += mass_[index_i] * (global_stress_i + global_stress_[index_j]) *
-                            inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            pseudo_normal_acceleration += (global_moment_i + global_moment_[index_j]) *
-                                          inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            pseudo_b_normal_acceleration += (global_b_moment_i + global_b_moment_[index_j]) *
-                                            inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-        }
+        onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+
+                    force += mass_[index_i] * (global_stress_i + global_stress_[index_j]) *
+                                    inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    pseudo_normal_acceleration += (global_moment_i + global_moment_[index_j]) *
+                                                  inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    pseudo_b_normal_acceleration += (global_b_moment_i + global_b_moment_[index_j]) *
+                                                    inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                }
+            });
 
         force_[index_i] = force * inv_rho0_ / (thickness_[index_i] * width_[index_i]);
         dpseudo_n_d2t_[index_i] = pseudo_normal_acceleration * inv_rho0_ * 12.0 / pow(thickness_[index_i], 4);
@@ -300,16 +309,19 @@ class BarStressRelaxationSecondHalf : public BaseBarRelaxation
         Matd deformation_gradient_change_rate_part_one = Matd::Zero();
         Matd deformation_gradient_change_rate_part_three = Matd::Zero();
         Matd deformation_gradient_change_rate_part_two = Matd::Zero();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-
-            Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            deformation_gradient_change_rate_part_one -= (vel_n_i - vel_[index_j]) * gradW_ijV_j.transpose();
-            deformation_gradient_change_rate_part_two -= (dpseudo_n_dt_i - dpseudo_n_dt_[index_j]) * gradW_ijV_j.transpose();
-            deformation_gradient_change_rate_part_three -= (dpseudo_b_n_dt_i - dpseudo_b_n_dt_[index_j]) * gradW_ijV_j.transpose();
-        }
+        onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+
+                    Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    deformation_gradient_change_rate_part_one -= (vel_n_i - vel_[index_j]) * gradW_ijV_j.transpose();
+                    deformation_gradient_change_rate_part_two -= (dpseudo_n_dt_i - dpseudo_n_dt_[index_j]) * gradW_ijV_j.transpose();
+                    deformation_gradient_change_rate_part_three -= (dpseudo_b_n_dt_i - dpseudo_b_n_dt_[index_j]) * gradW_ijV_j.transpose();
+                }
+            });
         dF_dt_[index_i] = transformation_matrix_i * deformation_gradient_change_rate_part_one *
                           transformation_matrix_i.transpose() * B_[index_i];
         dF_dt_[index_i].col(Dimensions - 1) = transformation_matrix_i * dpseudo_n_dt_[index_i];
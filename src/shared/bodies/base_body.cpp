@@ -113,12 +113,23 @@ BaseCellLinkedList &RealBody::getCellLinkedList()
 {
     if (!cell_linked_list_created_)
     {
-        cell_linked_list_ptr_ = sph_adaptation_->createCellLinkedList(getSPHSystemBounds(), *this);
+        cell_linked_list_ptr_ = sph_adaptation_->createCellLinkedList(cell_linked_list_bounds_, *this);
         cell_linked_list_created_ = true;
     }
     return *cell_linked_list_ptr_.get();
 }
 //=================================================================================================//
+void RealBody::setCellLinkedListBounds(const BoundingBox &bounds)
+{
+    if (cell_linked_list_created_)
+    {
+        std::cout << "\n Error: the cell linked list of " << getName() << " is already created!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    cell_linked_list_bounds_ = bounds;
+}
+//=================================================================================================//
 void RealBody::updateCellLinkedList()
 {
     getCellLinkedList().UpdateCellLists(*base_particles_);
@@ -209,13 +209,14 @@ class RealBody : public SPHBody
     bool use_split_cell_lists_;
     size_t iteration_count_;
     bool cell_linked_list_created_;
+    BoundingBox cell_linked_list_bounds_;
 
   public:
     template <typename... Args>
     RealBody(Args &&...args)
         : SPHBody(std::forward<Args>(args)...),
           use_split_cell_lists_(false), iteration_count_(1),
-          cell_linked_list_created_(false)
+          cell_linked_list_created_(false), cell_linked_list_bounds_(getSPHSystemBounds())
     {
         this->getSPHSystem().real_bodies_.push_back(this);
         size_t number_of_split_cell_lists = pow(3, Dimensions);
@@ -223,9 +224,14 @@ class RealBody : public SPHBody
     };
     virtual ~RealBody(){};
     BaseCellLinkedList &getCellLinkedList();
+    /** Bounds of the cell linked list, the system domain bounds by default,
+     * to be set before the cell linked list is created, e.g. by the body relations. */
+    void setCellLinkedListBounds(const BoundingBox &bounds);
     void setUseSplitCellLists() { use_split_cell_lists_ = true; };
     bool getUseSplitCellLists() { return use_split_cell_lists_; };
     SplitCellLists &getSplitCellLists() { return split_cell_lists_; };
+    /** bounds of the real particles, updated with the cell linked list */
+    BoundingBox getParticleBounds() { return getCellLinkedList().getParticleBounds(); };
     void updateCellLinkedList();
     void updateCellLinkedListWithParticleSort(size_t particle_sort_period);
 };
@@ -1,5 +1,6 @@
 #include "base_body_relation.h"
 #include "base_particle_dynamics.h"
+#include "inner_interaction_plan.hpp"
 
 namespace SPH
 {
@@ -18,6 +19,14 @@ namespace SPH
 	SPHRelation::SPHRelation(SPHBody &sph_body)
 		: sph_body_(sph_body), base_particles_(sph_body.getBaseParticles()) {}
 	//=================================================================================================//
+	void SPHRelation::refreshConfiguration()
+	{
+		std::cout << "\n Error: the neighbor lists of a relation of " << sph_body_.getName()
+				  << " can not be refreshed, they are only updated!" << std::endl;
+		std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+		exit(1);
+	}
+	//=================================================================================================//
 	BaseInnerRelation::BaseInnerRelation(RealBody &real_body)
 		: SPHRelation(real_body), real_body_(&real_body)
 	{
@@ -31,6 +40,17 @@ namespace SPH
 		inner_configuration_.resize(updated_size, Neighborhood());
 	}
 	//=================================================================================================//
+	void BaseInnerRelation::freezeTopology(bool is_single_precision)
+	{
+		if (isFrozen())
+			return;
+
+		if (is_single_precision)
+			single_precision_inner_plan_.compile(inner_configuration_, base_particles_.total_real_particles_);
+		else
+			inner_plan_.compile(inner_configuration_, base_particles_.total_real_particles_);
+	}
+	//=================================================================================================//
 	void BaseInnerRelation::resetNeighborhoodCurrentSize()
 	{
 		parallel_for(
@@ -34,6 +34,7 @@
 #include "base_geometry.h"
 #include "base_particles.h"
 #include "cell_linked_list.h"
+#include "inner_interaction_plan.h"
 #include "neighborhood.h"
 
 namespace SPH
@@ -96,6 +97,21 @@ struct SearchDepthAdaptiveContact
     };
 };
 
+/** Re-evaluate the listed neighbors of particle i with the current positions of the neighbor particles,
+ * the neighbors moved out of the cut-off radius are removed. */
+template <class NeighborBuilderType>
+void refreshNeighborhood(NeighborBuilderType &neighbor_builder, Neighborhood &neighborhood, const Vecd &pos_i,
+                         size_t index_i, StdLargeVec<Vecd> &pos_j, StdLargeVec<Real> &Vol_j)
+{
+    size_t previous_size = neighborhood.current_size_;
+    neighborhood.current_size_ = 0;
+    for (size_t n = 0; n != previous_size; ++n)
+    {
+        size_t index_j = neighborhood.j_[n];
+        neighbor_builder(neighborhood, pos_i, index_i, ListData(index_j, pos_j[index_j], Vol_j[index_j]));
+    }
+}
+
 /** Transfer body parts to real bodies. **/
 RealBodyVector BodyPartsToRealBodies(BodyPartVector body_parts);
 
@@ -117,6 +133,9 @@ class SPHRelation
     void subscribeToBody() { sph_body_.body_relations_.push_back(this); };
     virtual void resizeConfiguration() = 0;
     virtual void updateConfiguration() = 0;
+    /** Re-evaluate the kernel values of the current neighbors with the current particle positions
+     * without searching new neighbors, for reusing the neighbor lists while the particles move slightly. */
+    virtual void refreshConfiguration();
 };
 
 /**
@@ -131,10 +150,19 @@ class BaseInnerRelation : public SPHRelation
   public:
     RealBody *real_body_;
     ParticleConfiguration inner_configuration_; /**< inner configuration for the neighbor relations. */
+    InnerInteractionPlan<Real> inner_plan_;     /**< compiled inner configuration once the topology is frozen. */
+    InnerInteractionPlan<SingleReal> single_precision_inner_plan_; /**< or with single precision scalars. */
     explicit BaseInnerRelation(RealBody &real_body);
     virtual ~BaseInnerRelation(){};
     BaseInnerRelation &getRelation() { return *this; };
     virtual void resizeConfiguration() override;
+    /** For bodies whose neighbors never change, e.g. total Lagrangian solids, shells and trees.
+     * Called after the configuration is built, later updates of the configuration are skipped,
+     * the inner dynamics iterate the compiled plan instead. The configuration is kept unchanged
+     * for the dynamics which still read it directly. The scalar neighbor data of the plan
+     * are optionally stored in single precision. */
+    virtual void freezeTopology(bool is_single_precision = false);
+    bool isFrozen() const { return inner_plan_.isCompiled() || single_precision_inner_plan_.isCompiled(); };
 };
 
 /**
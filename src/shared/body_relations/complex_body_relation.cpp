@@ -48,4 +48,11 @@ void ComplexRelation::updateConfiguration()
         contact_relations_[k]->updateConfiguration();
 }
 //=================================================================================================//
+void ComplexRelation::refreshConfiguration()
+{
+    inner_relation_.refreshConfiguration();
+    for (size_t k = 0; k != contact_relations_.size(); ++k)
+        contact_relations_[k]->refreshConfiguration();
+}
+//=================================================================================================//
 } // namespace SPH
@@ -54,6 +54,7 @@ class ComplexRelation : public SPHRelation
 
     virtual void resizeConfiguration() override;
     virtual void updateConfiguration() override;
+    virtual void refreshConfiguration() override;
 };
 } // namespace SPH
 #endif // COMPLEX_BODY_RELATION_H
\ No newline at end of file
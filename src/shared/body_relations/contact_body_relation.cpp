@@ -27,6 +27,21 @@ void ContactRelation::updateConfiguration()
     }
 }
 //=================================================================================================//
+void ContactRelation::refreshConfiguration()
+{
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        BaseParticles &contact_particles = contact_bodies_[k]->getBaseParticles();
+        particle_for(execution::ParallelPolicy(), base_particles_.total_real_particles_,
+                     [&](size_t index_i)
+                     {
+                         refreshNeighborhood(*get_contact_neighbors_[k], contact_configuration_[k][index_i],
+                                             pos[index_i], index_i, contact_particles.pos_, contact_particles.Vol_);
+                     });
+    }
+}
+//=================================================================================================//
 SurfaceContactRelation::SurfaceContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies)
     : ContactRelationCrossResolution(sph_body, contact_bodies),
       body_surface_layer_(shape_surface_ptr_keeper_.createPtr<BodySurfaceLayer>(sph_body)),
@@ -13,12 +13,28 @@ InnerRelation::InnerRelation(RealBody &real_body)
 //=================================================================================================//
 void InnerRelation::updateConfiguration()
 {
+    if (isFrozen())
+        return;
     resetNeighborhoodCurrentSize();
     cell_linked_list_.searchNeighborsByParticles(
         sph_body_, inner_configuration_,
         get_single_search_depth_, get_inner_neighbor_);
 }
 //=================================================================================================//
+void InnerRelation::refreshConfiguration()
+{
+    if (isFrozen())
+        return;
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    StdLargeVec<Real> &Vol = base_particles_.Vol_;
+    particle_for(execution::ParallelPolicy(), base_particles_.total_real_particles_,
+                 [&](size_t index_i)
+                 {
+                     refreshNeighborhood(get_inner_neighbor_, inner_configuration_[index_i],
+                                         pos[index_i], index_i, pos, Vol);
+                 });
+}
+//=================================================================================================//
 AdaptiveInnerRelation::
     AdaptiveInnerRelation(RealBody &real_body)
     : BaseInnerRelation(real_body), total_levels_(0),
@@ -47,6 +63,26 @@ void AdaptiveInnerRelation::updateConfiguration()
     }
 }
 //=================================================================================================//
+void AdaptiveInnerRelation::refreshConfiguration()
+{
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    StdLargeVec<Real> &Vol = base_particles_.Vol_;
+    particle_for(execution::ParallelPolicy(), base_particles_.total_real_particles_,
+                 [&](size_t index_i)
+                 {
+                     refreshNeighborhood(get_adaptive_inner_neighbor_, inner_configuration_[index_i],
+                                         pos[index_i], index_i, pos, Vol);
+                 });
+}
+//=================================================================================================//
+void AdaptiveInnerRelation::freezeTopology(bool is_single_precision)
+{
+    std::cout << "\n Error: the topology of the adaptive inner relation of " << sph_body_.getName()
+              << " can not be frozen!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
 SelfSurfaceContactRelation::
     SelfSurfaceContactRelation(RealBody &real_body)
     : BaseInnerRelation(real_body),
@@ -72,12 +108,22 @@ void SelfSurfaceContactRelation::updateConfiguration()
         get_single_search_depth_, get_self_contact_neighbor_);
 }
 //=================================================================================================//
+void SelfSurfaceContactRelation::freezeTopology(bool is_single_precision)
+{
+    std::cout << "\n Error: the topology of the self contact relation of " << sph_body_.getName()
+              << " can not be frozen!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
 TreeInnerRelation::TreeInnerRelation(RealBody &real_body)
     : InnerRelation(real_body),
       generative_tree_(DynamicCast<TreeBody>(this, real_body)) {}
 //=================================================================================================//
 void TreeInnerRelation::updateConfiguration()
 {
+    if (isFrozen())
+        return;
     generative_tree_.buildParticleConfiguration(inner_configuration_);
 }
 //=================================================================================================//
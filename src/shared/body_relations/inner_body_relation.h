@@ -49,6 +49,7 @@ class InnerRelation : public BaseInnerRelation
     virtual ~InnerRelation(){};
 
     virtual void updateConfiguration() override;
+    virtual void refreshConfiguration() override;
 };
 
 /**
@@ -71,6 +72,9 @@ class AdaptiveInnerRelation : public BaseInnerRelation
     virtual ~AdaptiveInnerRelation(){};
 
     virtual void updateConfiguration() override;
+    virtual void refreshConfiguration() override;
+    /** Not supported, as the smoothing lengths, hence the neighbors, adapt during the simulation. */
+    virtual void freezeTopology(bool is_single_precision = false) override;
 };
 
 /**
@@ -85,6 +89,8 @@ class SelfSurfaceContactRelation : public BaseInnerRelation
     explicit SelfSurfaceContactRelation(RealBody &real_body);
     virtual ~SelfSurfaceContactRelation(){};
     virtual void updateConfiguration() override;
+    /** Not supported, as the contact neighbors change with the deformation. */
+    virtual void freezeTopology(bool is_single_precision = false) override;
 
   protected:
     IndexVector &body_part_particles_;
@@ -0,0 +1,120 @@
+#include "allocation_counter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+namespace SPH
+{
+//=================================================================================================//
+size_t AllocationCounter::Allocations()
+{
+    return allocations_.load(std::memory_order_relaxed);
+}
+//=================================================================================================//
+size_t AllocationCounter::AllocatedBytes()
+{
+    return allocated_bytes_.load(std::memory_order_relaxed);
+}
+//=================================================================================================//
+bool AllocationScope::checkNoAllocation(const std::string &context) const
+{
+    if (Allocations() != 0)
+    {
+        std::cout << "\n Error: " << Allocations() << " heap allocations of " << AllocatedBytes()
+                  << " bytes in " << context << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        return false;
+    }
+    return true;
+}
+//=================================================================================================//
+} // namespace SPH
+
+#if SPHINXSYS_COUNT_ALLOCATIONS
+//=================================================================================================//
+//	The replaced global allocation functions, counting before calling the C allocation.
+//=================================================================================================//
+namespace
+{
+void *countedAllocate(std::size_t size)
+{
+    SPH::AllocationCounter::count(size);
+    return std::malloc(size != 0 ? size : 1);
+}
+
+void *countedAlignedAllocate(std::size_t size, std::align_val_t alignment)
+{
+    SPH::AllocationCounter::count(size);
+    std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size != 0 ? size : 1, align);
+#else
+    /** aligned_alloc requires the size being a multiple of the alignment. */
+    return std::aligned_alloc(align, (size + align - 1) / align * align + (size == 0 ? align : 0));
+#endif
+}
+
+void alignedFree(void *ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    void *ptr = countedAllocate(size);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAllocate(size);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAllocate(size);
+}
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    void *ptr = countedAlignedAllocate(size, alignment);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return countedAlignedAllocate(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return countedAlignedAllocate(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { alignedFree(ptr); }
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept { alignedFree(ptr); }
+//=================================================================================================//
+#endif
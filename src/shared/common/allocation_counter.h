@@ -0,0 +1,93 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	allocation_counter.h
+ * @brief 	Counter of the heap allocations, to check that a time step does not allocate after warm-up.
+ * @details Only counted if the library is built with SPHINXSYS_COUNT_ALLOCATIONS,
+ *			in which case the global operator new is replaced by a counting one,
+ *			and the allocations of the large data and concurrent containers are counted as well.
+ *			Otherwise, the counts stay zero and there is no overhead.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class AllocationCounter
+ * @brief Global counts of the heap allocations by all threads.
+ */
+class AllocationCounter
+{
+  public:
+#if SPHINXSYS_COUNT_ALLOCATIONS
+    static constexpr bool isCounting() { return true; };
+#else
+    static constexpr bool isCounting() { return false; };
+#endif
+    /** Not inlined, so that reading the counts links the counting operator new from a static library. */
+    static size_t Allocations();
+    static size_t AllocatedBytes();
+    static void count(size_t bytes)
+    {
+        if constexpr (isCounting())
+        {
+            allocations_.fetch_add(1, std::memory_order_relaxed);
+            allocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    };
+
+  private:
+    static inline std::atomic<size_t> allocations_{0};
+    static inline std::atomic<size_t> allocated_bytes_{0};
+};
+
+/**
+ * @class AllocationScope
+ * @brief The heap allocations since construction, e.g. within a time step.
+ */
+class AllocationScope
+{
+  public:
+    AllocationScope()
+        : allocations_(AllocationCounter::Allocations()),
+          allocated_bytes_(AllocationCounter::AllocatedBytes()){};
+
+    size_t Allocations() const { return AllocationCounter::Allocations() - allocations_; };
+    size_t AllocatedBytes() const { return AllocationCounter::AllocatedBytes() - allocated_bytes_; };
+    /** Report any allocation and return false, so that the caller, e.g. a test, decides on the failure.
+     * Always true if allocations are not counted. */
+    bool checkNoAllocation(const std::string &context) const;
+
+  private:
+    size_t allocations_;
+    size_t allocated_bytes_;
+};
+} // namespace SPH
+#endif // ALLOCATION_COUNTER_H
@@ -49,7 +49,8 @@ using DataContainerAssemble =
                StdVec<DataContainerType<Vec3d>>,
                StdVec<DataContainerType<Mat2d>>,
                StdVec<DataContainerType<Mat3d>>,
-               StdVec<DataContainerType<int>>>;
+               StdVec<DataContainerType<int>>,
+               StdVec<DataContainerType<SingleReal>>>;
 /** Generalized data container address assemble type */
 template <template <typename> typename DataContainerType>
 using DataContainerAddressAssemble =
@@ -58,7 +59,8 @@ using DataContainerAddressAssemble =
                StdVec<DataContainerType<Vec3d> *>,
                StdVec<DataContainerType<Mat2d> *>,
                StdVec<DataContainerType<Mat3d> *>,
-               StdVec<DataContainerType<int> *>>;
+               StdVec<DataContainerType<int> *>,
+               StdVec<DataContainerType<SingleReal> *>>;
 /** Generalized data container unique pointer assemble type */
 template <template <typename> typename DataContainerType>
 using DataContainerUniquePtrAssemble =
@@ -67,7 +69,8 @@ using DataContainerUniquePtrAssemble =
                UniquePtrsKeeper<DataContainerType<Vec3d>>,
                UniquePtrsKeeper<DataContainerType<Mat2d>>,
                UniquePtrsKeeper<DataContainerType<Mat3d>>,
-               UniquePtrsKeeper<DataContainerType<int>>>;
+               UniquePtrsKeeper<DataContainerType<int>>,
+               UniquePtrsKeeper<DataContainerType<SingleReal>>>;
 
 /** a type irrelevant operation on the data assembles  */
 template <template <typename> typename OperationType>
@@ -79,6 +82,7 @@ struct DataAssembleOperation
     OperationType<Mat2d> matrix2d_operation;
     OperationType<Mat3d> matrix3d_operation;
     OperationType<int> integer_operation;
+    OperationType<SingleReal> single_scalar_operation;
 
     template <typename... OperationArgs>
     void operator()(OperationArgs &&...operation_args)
@@ -89,6 +93,7 @@ struct DataAssembleOperation
         matrix2d_operation(std::forward<OperationArgs>(operation_args)...);
         matrix3d_operation(std::forward<OperationArgs>(operation_args)...);
         integer_operation(std::forward<OperationArgs>(operation_args)...);
+        single_scalar_operation(std::forward<OperationArgs>(operation_args)...);
     }
 };
 } // namespace SPH
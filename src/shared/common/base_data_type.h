@@ -89,6 +89,38 @@ using AlignedBox3d = Eigen::AlignedBox<Real, 3>;
 using Rotation2d = Eigen::Rotation2D<Real>;
 using Rotation3d = Eigen::AngleAxis<Real>;
 
+/**
+ * @class SingleReal
+ * @brief Scalar stored in single precision and promoted to Real when loaded.
+ * A particle variable registered with this type halves the memory traffic of the loops reading it,
+ * while the arithmetic is still carried out in Real. It is a distinct type, also when Real is float,
+ * so that it has its own entry in the data assembles.
+ */
+class SingleReal
+{
+  public:
+    SingleReal() = default;
+    SingleReal(Real value) : value_(static_cast<float>(value)){};
+    operator Real() const { return static_cast<Real>(value_); };
+    SingleReal &operator+=(Real value) { return *this = Real(*this) + value; };
+    SingleReal &operator-=(Real value) { return *this = Real(*this) - value; };
+    SingleReal &operator*=(Real value) { return *this = Real(*this) * value; };
+
+  private:
+    float value_;
+};
+inline std::ostream &operator<<(std::ostream &out, const SingleReal &value)
+{
+    return out << Real(value);
+}
+inline std::istream &operator>>(std::istream &in, SingleReal &value)
+{
+    Real promoted_value;
+    in >> promoted_value;
+    value = promoted_value;
+    return in;
+}
+
 /** Unified initialize to zero for all data type. */
 /**
  * NOTE: Eigen::Matrix<> constexpr constructor?
@@ -116,6 +148,11 @@ struct ZeroData<int>
 {
     static inline int value = 0;
 };
+template <>
+struct ZeroData<SingleReal>
+{
+    static inline SingleReal value = SingleReal(0);
+};
 /** Type trait for data type index. */
 template <typename T>
 struct DataTypeIndex
@@ -152,6 +189,11 @@ struct DataTypeIndex<int>
 {
     static constexpr int value = 5;
 };
+template <>
+struct DataTypeIndex<SingleReal>
+{
+    static constexpr int value = 6;
+};
 /** Verbal boolean for positive and negative axis directions. */
 const int xAxis = 0;
 const int yAxis = 1;
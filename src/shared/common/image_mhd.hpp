@@ -187,7 +187,7 @@ ImageMHD<T, nDims>::~ImageMHD()
 {
     if (data_)
     {
-        delete data_;
+        delete[] data_;
         data_ = nullptr;
     }
 }
@@ -36,13 +36,56 @@
 #include "tbb/concurrent_vector.h"
 #include "tbb/parallel_for.h"
 #include "tbb/parallel_reduce.h"
+#include "tbb/parallel_scan.h"
 #include "tbb/scalable_allocator.h"
 #include "tbb/tick_count.h"
 
+#include "allocation_counter.h"
+#include "numa_awareness.h"
+
 namespace SPH
 {
+/**
+ * @class SharedAffinityPartitioner
+ * @brief The affinity partitioner shared by the parallel loops of a translation unit.
+ * @details An affinity partitioner keeps the history of one loop at a time,
+ * and must not be used by loops running concurrently, e.g. the dynamics of a task graph.
+ * Therefore, while a ConcurrentLoopsScope exists, the loops use the stateless auto partitioner.
+ */
+class SharedAffinityPartitioner
+{
+  public:
+    static bool isInConcurrentLoops() { return concurrent_loops_scopes_.load(std::memory_order_acquire) != 0; };
+    tbb::affinity_partitioner &AffinityPartitioner() { return affinity_partitioner_; };
+
+  private:
+    friend class ConcurrentLoopsScope;
+    static inline std::atomic<size_t> concurrent_loops_scopes_{0};
+    tbb::affinity_partitioner affinity_partitioner_;
+};
+
+/**
+ * @class ConcurrentLoopsScope
+ * @brief A scope in which the parallel loops may run concurrently.
+ */
+class ConcurrentLoopsScope
+{
+  public:
+    ConcurrentLoopsScope() { SharedAffinityPartitioner::concurrent_loops_scopes_.fetch_add(1, std::memory_order_acq_rel); };
+    ~ConcurrentLoopsScope() { SharedAffinityPartitioner::concurrent_loops_scopes_.fetch_sub(1, std::memory_order_acq_rel); };
+};
+
+static SharedAffinityPartitioner ap;
+
+template <class Range, class LoopFunction>
+void parallel_for(const Range &range, const LoopFunction &loop_function, SharedAffinityPartitioner &partitioner)
+{
+    if (SharedAffinityPartitioner::isInConcurrentLoops())
+        tbb::parallel_for(range, loop_function, tbb::auto_partitioner());
+    else
+        tbb::parallel_for(range, loop_function, partitioner.AffinityPartitioner());
+};
 
-static tbb::affinity_partitioner ap;
 typedef tbb::blocked_range<size_t> IndexRange;
 typedef tbb::blocked_range2d<size_t> IndexRange2d;
 typedef tbb::blocked_range3d<size_t> IndexRange3d;
@@ -50,11 +93,47 @@ typedef tbb::blocked_range3d<size_t> IndexRange3d;
 typedef tbb::tick_count TickCount;
 typedef tbb::tick_count::interval_t TimeInterval;
 
+/**
+ * @class LargeDataAllocator
+ * @brief Cache aligned allocator which, in NUMA-aware mode,
+ * touches the pages of large blocks in parallel before they are filled.
+ * The allocations are counted by the allocation counter, as they bypass operator new.
+ */
+template <typename T>
+class LargeDataAllocator : public tbb::cache_aligned_allocator<T>
+{
+  public:
+    using value_type = T;
+    template <typename U>
+    struct rebind
+    {
+        using other = LargeDataAllocator<U>;
+    };
+
+    LargeDataAllocator() = default;
+    template <typename U>
+    LargeDataAllocator(const LargeDataAllocator<U> &) noexcept {};
+
+    T *allocate(std::size_t n)
+    {
+        AllocationCounter::count(n * sizeof(T));
+        T *data = tbb::cache_aligned_allocator<T>::allocate(n);
+        if (NumaAwareness::first_touch_ && n * sizeof(T) >= NumaAwareness::first_touch_bytes_)
+            NumaAwareness::touchPagesInParallel(data, n * sizeof(T));
+        return data;
+    };
+};
+
+template <typename T, typename U>
+bool operator==(const LargeDataAllocator<T> &, const LargeDataAllocator<U> &) noexcept { return true; };
+template <typename T, typename U>
+bool operator!=(const LargeDataAllocator<T> &, const LargeDataAllocator<U> &) noexcept { return false; };
+
 template <typename T>
-using ConcurrentVec = tbb::concurrent_vector<T>;
+using StdLargeVec = std::vector<T, LargeDataAllocator<T>>;
 
 template <typename T>
-using StdLargeVec = std::vector<T, tbb::cache_aligned_allocator<T>>;
+using ConcurrentVec = tbb::concurrent_vector<T, LargeDataAllocator<T>>;
 
 template <typename T>
 using StdVec = std::vector<T>;
@@ -0,0 +1,65 @@
+#include "loop_partitioner.h"
+
+namespace SPH
+{
+//=================================================================================================//
+const StdVec<LoopPartitioner::Candidate> LoopPartitioner::candidates_ = {
+    {PartitionerType::Affinity, 1},
+    {PartitionerType::Auto, 1},
+    {PartitionerType::Affinity, 256},
+    {PartitionerType::Auto, 256},
+    {PartitionerType::Simple, 64},
+    {PartitionerType::Simple, 512},
+    {PartitionerType::Simple, 4096},
+    {PartitionerType::Static, 1}};
+//=================================================================================================//
+LoopPartitioner::LoopPartitioner(size_t samples_per_candidate)
+    : samples_per_candidate_(SMAX(samples_per_candidate, size_t(1))), number_of_samples_(0),
+      best_time_per_index_(candidates_.size(), MaxReal), chosen_candidate_(0),
+      is_tuned_(!autotuning_ || NumaAwareness::first_touch_)
+{
+    if (NumaAwareness::first_touch_)
+        chosen_candidate_ = candidates_.size() - 1;
+}
+//=================================================================================================//
+size_t LoopPartitioner::nextCandidate()
+{
+    return is_tuned_ ? chosen_candidate_ : number_of_samples_ % candidates_.size();
+}
+//=================================================================================================//
+IndexRange LoopPartitioner::CandidateRange(size_t candidate, const IndexRange &range)
+{
+    return IndexRange(range.begin(), range.end(), candidates_[candidate].grain_size_);
+}
+//=================================================================================================//
+void LoopPartitioner::recordTime(size_t candidate, size_t size, TimeInterval time_interval)
+{
+    if (is_tuned_ || size == 0)
+        return;
+
+    best_time_per_index_[candidate] =
+        SMIN(best_time_per_index_[candidate], (Real)time_interval.seconds() / (Real)size);
+    number_of_samples_++;
+
+    if (number_of_samples_ == samples_per_candidate_ * candidates_.size())
+    {
+        for (size_t k = 0; k != candidates_.size(); ++k)
+        {
+            if (best_time_per_index_[k] < best_time_per_index_[chosen_candidate_])
+                chosen_candidate_ = k;
+        }
+        is_tuned_ = true;
+    }
+}
+//=================================================================================================//
+std::string LoopPartitioner::ChosenPartitioner()
+{
+    const Candidate &chosen = candidates_[chosen_candidate_];
+    std::string partitioner_name = chosen.partitioner_type_ == PartitionerType::Simple     ? "simple"
+                                   : chosen.partitioner_type_ == PartitionerType::Auto     ? "auto"
+                                   : chosen.partitioner_type_ == PartitionerType::Affinity ? "affinity"
+                                                                                           : "static";
+    return partitioner_name + " partitioner with grain size " + std::to_string(chosen.grain_size_);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,97 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	loop_partitioner.h
+ * @brief 	Partitioner with its own affinity history and grain size autotuning for parallel loops.
+ * @details Each particle dynamics owns the partitioners of its loops.
+ *			During the first calls, the loop is executed with each candidate
+ *			combination of partitioner type and grain size in turn, and the time per loop index is measured.
+ *			Afterwards, the fastest candidate is used for all further calls.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef LOOP_PARTITIONER_H
+#define LOOP_PARTITIONER_H
+
+#include "large_data_containers.h"
+#include "scalar_functions.h"
+
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class LoopPartitioner
+ * @brief Execute parallel for and reduce loops over an index range with a tuned partitioner.
+ * The loop functions are the same as for parallel_for and parallel_reduce on an IndexRange,
+ * whose grain size is replaced by that of the candidate.
+ */
+class LoopPartitioner
+{
+  public:
+    explicit LoopPartitioner(size_t samples_per_candidate = 2);
+    virtual ~LoopPartitioner(){};
+
+    /** Switch off autotuning for all loops, which then use the affinity partitioner with default grain size.
+     * In NUMA-aware mode, the loops use the static partitioner without autotuning,
+     * so that a thread works on the same part of the particle data in each loop. */
+    static inline bool autotuning_ = true;
+
+    template <class LoopFunction>
+    void parallelFor(const IndexRange &range, const LoopFunction &loop_function);
+    template <typename ReturnType, class LoopFunction, class JoinFunction>
+    ReturnType parallelReduce(const IndexRange &range, const ReturnType &identity,
+                              const LoopFunction &loop_function, const JoinFunction &join_function);
+
+    bool isTuned() { return is_tuned_; };
+    /** description of the chosen candidate, e.g. for performance reports. */
+    std::string ChosenPartitioner();
+
+  protected:
+    enum class PartitionerType
+    {
+        Simple,
+        Auto,
+        Affinity,
+        Static
+    };
+    struct Candidate
+    {
+        PartitionerType partitioner_type_;
+        size_t grain_size_;
+    };
+    static const StdVec<Candidate> candidates_;
+
+    tbb::affinity_partitioner affinity_partitioner_;
+    size_t samples_per_candidate_;
+    size_t number_of_samples_;
+    StdVec<Real> best_time_per_index_;
+    size_t chosen_candidate_;
+    bool is_tuned_;
+
+    size_t nextCandidate();
+    void recordTime(size_t candidate, size_t size, TimeInterval time_interval);
+    IndexRange CandidateRange(size_t candidate, const IndexRange &range);
+};
+} // namespace SPH
+#endif // LOOP_PARTITIONER_H
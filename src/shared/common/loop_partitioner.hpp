@@ -0,0 +1,63 @@
+/**
+ * @file 	loop_partitioner.hpp
+ * @brief 	Implementation of the template loop functions.
+ * @author	Xiangyu Hu
+ */
+
+#pragma once
+
+#include "loop_partitioner.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <class LoopFunction>
+void LoopPartitioner::parallelFor(const IndexRange &range, const LoopFunction &loop_function)
+{
+    size_t candidate = nextCandidate();
+    IndexRange candidate_range = CandidateRange(candidate, range);
+    TickCount time_instance = TickCount::now();
+    switch (candidates_[candidate].partitioner_type_)
+    {
+    case PartitionerType::Simple:
+        parallel_for(candidate_range, loop_function, tbb::simple_partitioner());
+        break;
+    case PartitionerType::Auto:
+        parallel_for(candidate_range, loop_function, tbb::auto_partitioner());
+        break;
+    case PartitionerType::Static:
+        parallel_for(candidate_range, loop_function, tbb::static_partitioner());
+        break;
+    default:
+        parallel_for(candidate_range, loop_function, affinity_partitioner_);
+    }
+    recordTime(candidate, range.size(), TickCount::now() - time_instance);
+}
+//=================================================================================================//
+template <typename ReturnType, class LoopFunction, class JoinFunction>
+ReturnType LoopPartitioner::parallelReduce(const IndexRange &range, const ReturnType &identity,
+                                           const LoopFunction &loop_function, const JoinFunction &join_function)
+{
+    size_t candidate = nextCandidate();
+    IndexRange candidate_range = CandidateRange(candidate, range);
+    TickCount time_instance = TickCount::now();
+    ReturnType result = identity;
+    switch (candidates_[candidate].partitioner_type_)
+    {
+    case PartitionerType::Simple:
+        result = parallel_reduce(candidate_range, identity, loop_function, join_function, tbb::simple_partitioner());
+        break;
+    case PartitionerType::Auto:
+        result = parallel_reduce(candidate_range, identity, loop_function, join_function, tbb::auto_partitioner());
+        break;
+    case PartitionerType::Static:
+        result = parallel_reduce(candidate_range, identity, loop_function, join_function, tbb::static_partitioner());
+        break;
+    default:
+        result = parallel_reduce(candidate_range, identity, loop_function, join_function, affinity_partitioner_);
+    }
+    recordTime(candidate, range.size(), TickCount::now() - time_instance);
+    return result;
+}
+//=================================================================================================//
+} // namespace SPH
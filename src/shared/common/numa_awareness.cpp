@@ -0,0 +1,61 @@
+#include "numa_awareness.h"
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/partitioner.h"
+#include "tbb/task_arena.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+void NumaAwareness::touchPagesInParallel(void *data, size_t bytes)
+{
+    constexpr size_t page_size = 4096;
+    char *block = static_cast<char *>(data);
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, (bytes + page_size - 1) / page_size),
+        [&](const tbb::blocked_range<size_t> &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                block[i * page_size] = 0;
+            }
+        },
+        tbb::static_partitioner());
+}
+//=================================================================================================//
+ThreadPinning::ThreadPinning() : tbb::task_scheduler_observer()
+{
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &cpu_set) == 0)
+    {
+        for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &cpu_set))
+                allowed_cores_.push_back(cpu);
+    }
+#endif
+}
+//=================================================================================================//
+void ThreadPinning::on_scheduler_entry(bool is_worker)
+{
+#ifdef __linux__
+    int slot = tbb::this_task_arena::current_thread_index();
+    if (slot < 0 || allowed_cores_.empty())
+        return;
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(allowed_cores_[slot % allowed_cores_.size()], &cpu_set);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+#endif
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,79 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	numa_awareness.h
+ * @brief 	Optional NUMA-aware placement of large data and pinning of the parallel threads.
+ * @details On multi-socket machines, a memory page is placed on the socket of the thread which first writes it.
+ *			Large data are allocated and then filled by the main thread,
+ *			so that all pages land on one socket and half the threads read remote memory.
+ *			In NUMA-aware mode, the pages of large blocks are first touched in parallel
+ *			with a static partition, threads are pinned to cores,
+ *			and the parallel particle loops use the same static partition,
+ *			so that each thread works mostly on memory local to its socket.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef NUMA_AWARENESS_H
+#define NUMA_AWARENESS_H
+
+#include "tbb/task_scheduler_observer.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace SPH
+{
+/**
+ * @class NumaAwareness
+ * @brief Global switch of the NUMA-aware mode, to be set before any particle data is allocated.
+ */
+class NumaAwareness
+{
+  public:
+    static inline bool first_touch_ = false;
+    /** blocks smaller than this are not worth a parallel loop. */
+    static inline size_t first_touch_bytes_ = 1 << 20;
+    /** Write one byte per page of the block in parallel with the static partitioner. */
+    static void touchPagesInParallel(void *data, size_t bytes);
+};
+
+/**
+ * @class ThreadPinning
+ * @brief Pin each thread entering the task scheduler to a single core,
+ * chosen by its slot index in the arena, so that a thread stays on the socket of its data.
+ * The cores are those the process is allowed to run on when the pinning is constructed,
+ * e.g. restricted by taskset, numactl or the batch system.
+ * Only available on Linux, elsewhere it does nothing.
+ */
+class ThreadPinning : public tbb::task_scheduler_observer
+{
+  public:
+    ThreadPinning();
+    virtual ~ThreadPinning() { observe(false); };
+    virtual void on_scheduler_entry(bool is_worker) override;
+
+  protected:
+    std::vector<int> allowed_cores_;
+};
+} // namespace SPH
+#endif // NUMA_AWARENESS_H
@@ -0,0 +1,72 @@
+#include "scratch_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace SPH
+{
+//=================================================================================================//
+void *ScratchArena::allocate(size_t bytes, size_t alignment)
+{
+    while (true)
+    {
+        if (current_block_ < blocks_.size())
+        {
+            Block &block = blocks_[current_block_];
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.data_.get()) + offset_;
+            size_t padding = (alignment - address % alignment) % alignment;
+            if (offset_ + padding + bytes <= block.size_)
+            {
+                void *data = block.data_.get() + offset_ + padding;
+                offset_ += padding + bytes;
+                return data;
+            }
+            if (current_block_ + 1 < blocks_.size())
+            {
+                current_block_++;
+                offset_ = 0;
+                continue;
+            }
+        }
+        addBlock(std::max(bytes + alignment, std::max(minimum_block_size_, 2 * Capacity())));
+    }
+}
+//=================================================================================================//
+void ScratchArena::addBlock(size_t size)
+{
+    /** not value-initialized, so that the memory is not touched */
+    blocks_.push_back(Block{std::unique_ptr<char[]>(new char[size]), size});
+    current_block_ = blocks_.size() - 1;
+    offset_ = 0;
+}
+//=================================================================================================//
+void ScratchArena::rewind(const Mark &mark)
+{
+    current_block_ = mark.block_;
+    offset_ = mark.offset_;
+    if (current_block_ == 0 && offset_ == 0 && blocks_.size() > 1)
+    {
+        size_t capacity = Capacity();
+        blocks_.clear();
+        addBlock(capacity);
+        current_block_ = 0;
+    }
+}
+//=================================================================================================//
+size_t ScratchArena::Capacity() const
+{
+    size_t capacity = 0;
+    for (const Block &block : blocks_)
+        capacity += block.size_;
+    return capacity;
+}
+//=================================================================================================//
+size_t ScratchArena::TotalCapacity()
+{
+    size_t total_capacity = 0;
+    for (const ScratchArena &arena : thread_arenas_)
+        total_capacity += arena.Capacity();
+    return total_capacity;
+}
+//=================================================================================================//
+} // namespace SPH
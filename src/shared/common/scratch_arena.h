@@ -0,0 +1,119 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	scratch_arena.h
+ * @brief 	Thread-local scratch memory for the temporaries of particle dynamics.
+ * @details A scratch arena hands out memory by bumping an offset in blocks which are kept,
+ *			and is rewound to a mark when the temporaries are no longer used.
+ *			Each thread has its own arena, and the temporaries of a function are
+ *			taken within a ScratchScope, which rewinds the arena at its end.
+ *			As the tasks executed by a thread are nested, the scopes on a thread are too,
+ *			so that the arena is used as a stack.
+ *			After the first time steps, the blocks are large enough and no heap allocation is needed.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace SPH
+{
+/**
+ * @class ScratchArena
+ * @brief Bump allocator over kept blocks, not thread safe.
+ */
+class ScratchArena
+{
+  public:
+    struct Mark
+    {
+        size_t block_;
+        size_t offset_;
+    };
+
+    ScratchArena() : current_block_(0), offset_(0){};
+
+    void *allocate(size_t bytes, size_t alignment);
+    /** Uninitialized memory for trivial data only, as no destructor is called. */
+    template <typename DataType>
+    DataType *allocate(size_t number)
+    {
+        static_assert(std::is_trivially_destructible<DataType>::value, "Only trivial data in scratch memory.");
+        return static_cast<DataType *>(allocate(number * sizeof(DataType), alignof(DataType)));
+    };
+    Mark getMark() const { return Mark{current_block_, offset_}; };
+    /** Release all memory taken after the mark. Once the arena is empty,
+     * several blocks are merged into one so that the next use fits in a single block. */
+    void rewind(const Mark &mark);
+    size_t Capacity() const;
+    size_t NumberOfBlocks() const { return blocks_.size(); };
+
+    /** The arena of the calling thread. */
+    static ScratchArena &local() { return thread_arenas_.local(); };
+    /** The capacity of the arenas of all threads. */
+    static size_t TotalCapacity();
+
+  protected:
+    struct Block
+    {
+        std::unique_ptr<char[]> data_;
+        size_t size_;
+    };
+    static constexpr size_t minimum_block_size_ = 64 * 1024;
+    std::vector<Block> blocks_;
+    size_t current_block_;
+    size_t offset_;
+
+    void addBlock(size_t size);
+
+    static inline tbb::enumerable_thread_specific<ScratchArena> thread_arenas_;
+};
+
+/**
+ * @class ScratchScope
+ * @brief Temporaries from the arena of the calling thread, released at the end of the scope.
+ */
+class ScratchScope
+{
+  public:
+    ScratchScope() : arena_(ScratchArena::local()), mark_(arena_.getMark()){};
+    ~ScratchScope() { arena_.rewind(mark_); };
+    ScratchScope(const ScratchScope &) = delete;
+    ScratchScope &operator=(const ScratchScope &) = delete;
+
+    template <typename DataType>
+    DataType *allocate(size_t number) { return arena_.allocate<DataType>(number); };
+
+  private:
+    ScratchArena &arena_;
+    ScratchArena::Mark mark_;
+};
+} // namespace SPH
+#endif // SCRATCH_ARENA_H
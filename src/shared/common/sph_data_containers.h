@@ -56,6 +56,51 @@ using BodyPartVector = StdVec<BodyPart *>;
 using IndexVector = StdVec<size_t>;
 using ConcurrentIndexVector = ConcurrentVec<size_t>;
 
+/** The number of indices in a task of the parallel scan gathering indices. */
+inline constexpr size_t index_gather_grain_size = 4096;
+
+/** Gather, in order and by a parallel scan, the indices[n] for which is_selected(n) is true.
+ * The gathered vector is reused, so that no allocation is needed once it is large enough. */
+template <class SelectFunction>
+void gatherIndices(const IndexVector &indices, IndexVector &gathered, const SelectFunction &is_selected)
+{
+    gathered.resize(indices.size());
+    size_t total_gathered = parallel_scan(
+        IndexRange(0, indices.size(), index_gather_grain_size), size_t(0),
+        [&](const IndexRange &r, size_t number_gathered, bool is_final_scan) -> size_t
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                if (is_selected(n))
+                {
+                    if (is_final_scan)
+                        gathered[number_gathered] = indices[n];
+                    number_gathered++;
+                }
+            }
+            return number_gathered;
+        },
+        [](size_t left, size_t right) -> size_t
+        { return left + right; });
+    gathered.resize(total_gathered);
+};
+
+/** Extend the indices to the identity map of the given size.
+ * Only the new entries are filled, as the existing ones are identical to their positions. */
+inline void fillIdentityIndices(IndexVector &indices, size_t size)
+{
+    size_t previous_size = SMIN(indices.size(), size);
+    indices.resize(size);
+    parallel_for(
+        IndexRange(previous_size, size),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                indices[i] = i;
+        },
+        ap);
+};
+
 /** List data pair: first for indexes, second for particle position. */
 using ListData = std::tuple<size_t, Vecd, Real>;
 using ListDataVector = StdLargeVec<ListData>;
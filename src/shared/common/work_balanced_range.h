@@ -0,0 +1,81 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	work_balanced_range.h
+ * @brief 	Index range for parallel loops which is split by work rather than by index count.
+ * @details The work of each index, e.g. the number of particles in a cell, is given as prefix sums.
+ *			Cells near free surfaces or walls hold much fewer particles than bulk cells,
+ *			so that splitting by cell count gives tasks with very different work.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef WORK_BALANCED_RANGE_H
+#define WORK_BALANCED_RANGE_H
+
+#include "large_data_containers.h"
+
+#include <algorithm>
+
+namespace SPH
+{
+/**
+ * @class WorkBalancedRange
+ * @brief A tbb range over [begin, end) splitting at the index which halves the work.
+ * @details work_prefix[i] is the total work of the indexes before i,
+ * hence it has one more entry than the number of indexes.
+ * The range is divisible as long as its work is larger than the grain work.
+ */
+class WorkBalancedRange
+{
+  public:
+    WorkBalancedRange(size_t begin, size_t end, const size_t *work_prefix, size_t grain_work)
+        : begin_(begin), end_(end), work_prefix_(work_prefix), grain_work_(grain_work){};
+    WorkBalancedRange(WorkBalancedRange &range, tbb::split)
+        : begin_(range.splitIndex()), end_(range.end_),
+          work_prefix_(range.work_prefix_), grain_work_(range.grain_work_)
+    {
+        range.end_ = begin_;
+    };
+
+    size_t begin() const { return begin_; };
+    size_t end() const { return end_; };
+    size_t size() const { return end_ - begin_; };
+    bool empty() const { return begin_ >= end_; };
+    size_t Work() const { return work_prefix_[end_] - work_prefix_[begin_]; };
+    bool is_divisible() const { return size() > 1 && Work() > grain_work_; };
+
+  protected:
+    size_t begin_, end_;
+    const size_t *work_prefix_;
+    size_t grain_work_;
+
+    /** the first index of the upper half, both halves are kept non-empty. */
+    size_t splitIndex()
+    {
+        size_t half_work = work_prefix_[begin_] + Work() / 2;
+        size_t split_index = std::upper_bound(work_prefix_ + begin_ + 1, work_prefix_ + end_, half_work) - work_prefix_;
+        return std::clamp(split_index, begin_ + 1, end_ - 1);
+    };
+};
+} // namespace SPH
+#endif // WORK_BALANCED_RANGE_H
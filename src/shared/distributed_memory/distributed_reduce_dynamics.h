@@ -0,0 +1,123 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	distributed_reduce_dynamics.h
+ * @brief 	Reduce dynamics with the result combined over all processes.
+ * @details The local results are reduced across processes with the same operation
+ *			before the final output, so that e.g. the time step size is the same on all processes.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef DISTRIBUTED_REDUCE_DYNAMICS_H
+#define DISTRIBUTED_REDUCE_DYNAMICS_H
+
+#include "mpi_environment.h"
+#include "particle_dynamics_algorithms.h"
+#include "particle_functors.h"
+
+namespace SPH
+{
+//----------------------------------------------------------------------
+// Reduction of local results across processes by the reduce operation
+//----------------------------------------------------------------------
+inline Real reduceAcrossProcesses(Real value, const ReduceSum<Real> &)
+{
+    MPIEnvironment::allReduce(&value, 1, MPIEnvironment::ReduceOperation::Sum);
+    return value;
+};
+
+template <typename DataType>
+DataType reduceAcrossProcesses(DataType value, const ReduceSum<DataType> &)
+{
+    MPIEnvironment::allReduce(value.data(), value.size(), MPIEnvironment::ReduceOperation::Sum);
+    return value;
+};
+
+inline Real reduceAcrossProcesses(Real value, const ReduceMax &)
+{
+    MPIEnvironment::allReduce(&value, 1, MPIEnvironment::ReduceOperation::Max);
+    return value;
+};
+
+inline Real reduceAcrossProcesses(Real value, const ReduceMin &)
+{
+    MPIEnvironment::allReduce(&value, 1, MPIEnvironment::ReduceOperation::Min);
+    return value;
+};
+
+inline bool reduceAcrossProcesses(bool value, const ReduceOR &)
+{
+    int flag = value;
+    MPIEnvironment::allReduce(&flag, 1, MPIEnvironment::ReduceOperation::Max);
+    return flag != 0;
+};
+
+inline bool reduceAcrossProcesses(bool value, const ReduceAND &)
+{
+    int flag = value;
+    MPIEnvironment::allReduce(&flag, 1, MPIEnvironment::ReduceOperation::Min);
+    return flag != 0;
+};
+
+inline Vecd reduceAcrossProcesses(Vecd value, const ReduceLowerBound &)
+{
+    MPIEnvironment::allReduce(value.data(), value.size(), MPIEnvironment::ReduceOperation::Min);
+    return value;
+};
+
+inline Vecd reduceAcrossProcesses(Vecd value, const ReduceUpperBound &)
+{
+    MPIEnvironment::allReduce(value.data(), value.size(), MPIEnvironment::ReduceOperation::Max);
+    return value;
+};
+
+/**
+ * @class DistributedReduceDynamics
+ * @brief Reduce dynamics over the particles of all processes, e.g. for AcousticTimeStepSize.
+ * Note that the output of averages is still divided by the local number of particles.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class DistributedReduceDynamics : public ReduceDynamics<LocalDynamicsType, ExecutionPolicy>
+{
+    using ReturnType = typename LocalDynamicsType::ReduceReturnType;
+
+  public:
+    template <class DynamicsIdentifier, typename... Args>
+    DistributedReduceDynamics(DynamicsIdentifier &identifier, Args &&...args)
+        : ReduceDynamics<LocalDynamicsType, ExecutionPolicy>(identifier, std::forward<Args>(args)...){};
+    virtual ~DistributedReduceDynamics(){};
+
+    virtual ReturnType exec(Real dt = 0.0) override
+    {
+        this->setupDynamics(dt);
+        ReturnType temp = particle_reduce(ExecutionPolicy(),
+                                          this->identifier_.LoopRange(), this->Reference(), this->getOperation(),
+                                          [&](size_t i) -> ReturnType
+                                          { return this->reduce(i, dt); },
+                                          this->loop_partitioner_);
+        this->finishDynamics(dt);
+        return this->outputResult(reduceAcrossProcesses(temp, this->getOperation()));
+    };
+};
+} // namespace SPH
+#endif // DISTRIBUTED_REDUCE_DYNAMICS_H
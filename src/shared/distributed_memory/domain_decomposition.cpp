@@ -0,0 +1,491 @@
+#include "domain_decomposition.h"
+
+#include "base_body.h"
+#include "base_particles.hpp"
+
+#include <cstring>
+
+namespace SPH
+{
+//=================================================================================================//
+/** Count the particles of all bodies for each group, with the group labels of the particles. */
+template <typename CountCondition>
+static StdVec<size_t> countParticlesInGroups(const RealBodyVector &real_bodies, StdVec<IndexVector> &group_labels,
+                                             size_t number_of_groups, const CountCondition &count_condition)
+{
+    StdVec<size_t> counts(number_of_groups, 0);
+    for (size_t k = 0; k != real_bodies.size(); ++k)
+    {
+        StdLargeVec<Vecd> &pos = real_bodies[k]->getBaseParticles().pos_;
+        IndexVector &labels = group_labels[k];
+        StdVec<size_t> body_counts = parallel_reduce(
+            IndexRange(0, labels.size()), StdVec<size_t>(number_of_groups, 0),
+            [&](const IndexRange &r, StdVec<size_t> local_counts) -> StdVec<size_t>
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                    if (count_condition(labels[i], pos[i]))
+                        local_counts[labels[i]]++;
+                return local_counts;
+            },
+            [](StdVec<size_t> x, const StdVec<size_t> &y) -> StdVec<size_t>
+            {
+                for (size_t g = 0; g != x.size(); ++g)
+                    x[g] += y[g];
+                return x;
+            });
+        for (size_t g = 0; g != number_of_groups; ++g)
+            counts[g] += body_counts[g];
+    }
+    MPIEnvironment::allReduce(counts.data(), counts.size(), MPIEnvironment::ReduceOperation::Sum);
+    return counts;
+}
+//=================================================================================================//
+RecursiveBisection::RecursiveBisection()
+    : subdomains_(MPIEnvironment::Size(),
+                  BoundingBox(Vecd::Constant(-MaxReal), Vecd::Constant(MaxReal))) {}
+//=================================================================================================//
+void RecursiveBisection::partition(const RealBodyVector &real_bodies)
+{
+    /** A group of processes owns the particles labelled with its index and the subdomain bounds. */
+    struct ProcessGroup
+    {
+        size_t node_;
+        int first_rank_;
+        int number_of_ranks_;
+        BoundingBox bounds_;
+    };
+    StdVec<ProcessGroup> groups;
+    groups.push_back({0, 0, MPIEnvironment::Size(),
+                      BoundingBox(Vecd::Constant(-MaxReal), Vecd::Constant(MaxReal))});
+    nodes_.clear();
+    nodes_.push_back({0, 0.0, 0, 0, 0});
+
+    StdVec<IndexVector> group_labels(real_bodies.size());
+    for (size_t k = 0; k != real_bodies.size(); ++k)
+        group_labels[k].assign(real_bodies[k]->getBaseParticles().total_real_particles_, 0);
+
+    while (std::any_of(groups.begin(), groups.end(), [](const ProcessGroup &group)
+                       { return group.number_of_ranks_ > 1; }))
+    {
+        size_t number_of_groups = groups.size();
+        /** extents of the particles in each group, the lower bounds are negated for a single max reduction. */
+        StdVec<Real> extents(2 * Dimensions * number_of_groups, -MaxReal);
+        for (size_t k = 0; k != real_bodies.size(); ++k)
+        {
+            StdLargeVec<Vecd> &pos = real_bodies[k]->getBaseParticles().pos_;
+            for (size_t i = 0; i != group_labels[k].size(); ++i)
+            {
+                size_t offset = 2 * Dimensions * group_labels[k][i];
+                for (int axis = 0; axis != Dimensions; ++axis)
+                {
+                    extents[offset + axis] = SMAX(extents[offset + axis], -pos[i][axis]);
+                    extents[offset + Dimensions + axis] = SMAX(extents[offset + Dimensions + axis], pos[i][axis]);
+                }
+            }
+        }
+        MPIEnvironment::allReduce(extents.data(), extents.size(), MPIEnvironment::ReduceOperation::Max);
+        StdVec<size_t> group_sizes = countParticlesInGroups(
+            real_bodies, group_labels, number_of_groups, [](size_t, const Vecd &)
+            { return true; });
+
+        StdVec<int> axes(number_of_groups, 0);
+        StdVec<Real> lower(number_of_groups, 0.0), upper(number_of_groups, 0.0);
+        StdVec<size_t> targets(number_of_groups, 0);
+        for (size_t g = 0; g != number_of_groups; ++g)
+        {
+            size_t offset = 2 * Dimensions * g;
+            if (group_sizes[g] != 0)
+            {
+                Vecd extent_lower = -Eigen::Map<Vecd>(&extents[offset]);
+                Vecd extent_upper = Eigen::Map<Vecd>(&extents[offset + Dimensions]);
+                (extent_upper - extent_lower).maxCoeff(&axes[g]);
+                lower[g] = extent_lower[axes[g]];
+                upper[g] = extent_upper[axes[g]];
+            }
+            int lower_ranks = groups[g].number_of_ranks_ / 2;
+            targets[g] = group_sizes[g] * lower_ranks / SMAX(groups[g].number_of_ranks_, 1);
+        }
+
+        for (int step = 0; step != bisection_steps_; ++step)
+        {
+            StdVec<Real> splits(number_of_groups);
+            for (size_t g = 0; g != number_of_groups; ++g)
+                splits[g] = 0.5 * (lower[g] + upper[g]);
+            StdVec<size_t> below = countParticlesInGroups(
+                real_bodies, group_labels, number_of_groups, [&](size_t g, const Vecd &position)
+                { return position[axes[g]] < splits[g]; });
+            for (size_t g = 0; g != number_of_groups; ++g)
+            {
+                if (below[g] < targets[g])
+                    lower[g] = splits[g];
+                else
+                    upper[g] = splits[g];
+            }
+        }
+
+        StdVec<ProcessGroup> new_groups;
+        StdVec<size_t> lower_group(number_of_groups), upper_group(number_of_groups);
+        for (size_t g = 0; g != number_of_groups; ++g)
+        {
+            ProcessGroup &group = groups[g];
+            if (group.number_of_ranks_ == 1)
+            {
+                lower_group[g] = upper_group[g] = new_groups.size();
+                new_groups.push_back(group);
+                continue;
+            }
+            Real split = 0.5 * (lower[g] + upper[g]);
+            int lower_ranks = group.number_of_ranks_ / 2;
+            BoundingBox lower_bounds = group.bounds_;
+            BoundingBox upper_bounds = group.bounds_;
+            lower_bounds.second_[axes[g]] = split;
+            upper_bounds.first_[axes[g]] = split;
+
+            size_t lower_node = nodes_.size();
+            nodes_.push_back({0, 0.0, 0, 0, group.first_rank_});
+            nodes_.push_back({0, 0.0, 0, 0, group.first_rank_ + lower_ranks});
+            nodes_[group.node_] = {axes[g], split, lower_node, lower_node + 1, -1};
+
+            lower_group[g] = new_groups.size();
+            new_groups.push_back({lower_node, group.first_rank_, lower_ranks, lower_bounds});
+            upper_group[g] = new_groups.size();
+            new_groups.push_back({lower_node + 1, group.first_rank_ + lower_ranks,
+                                  group.number_of_ranks_ - lower_ranks, upper_bounds});
+        }
+
+        for (size_t k = 0; k != real_bodies.size(); ++k)
+        {
+            StdLargeVec<Vecd> &pos = real_bodies[k]->getBaseParticles().pos_;
+            IndexVector &labels = group_labels[k];
+            parallel_for(
+                IndexRange(0, labels.size()),
+                [&](const IndexRange &r)
+                {
+                    for (size_t i = r.begin(); i != r.end(); ++i)
+                    {
+                        size_t g = labels[i];
+                        labels[i] = pos[i][axes[g]] < 0.5 * (lower[g] + upper[g]) ? lower_group[g] : upper_group[g];
+                    }
+                },
+                ap);
+        }
+        groups = new_groups;
+    }
+
+    for (const ProcessGroup &group : groups)
+        subdomains_[group.first_rank_] = group.bounds_;
+}
+//=================================================================================================//
+int RecursiveBisection::OwnerRank(const Vecd &position)
+{
+    size_t node = 0;
+    while (nodes_[node].rank_ < 0)
+    {
+        node = position[nodes_[node].axis_] < nodes_[node].split_ ? nodes_[node].lower_child_
+                                                                  : nodes_[node].upper_child_;
+    }
+    return nodes_[node].rank_;
+}
+//=================================================================================================//
+/** Select the particles sent to each process, in the order of particle indices. */
+template <class SelectionFunction>
+static void selectParticlesToSend(size_t total_particles, StdVec<IndexVector> &send_lists,
+                                  const SelectionFunction &selection)
+{
+    send_lists = parallel_reduce(
+        IndexRange(0, total_particles), StdVec<IndexVector>(send_lists.size()),
+        [&](const IndexRange &r, StdVec<IndexVector> local_lists) -> StdVec<IndexVector>
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                selection(i, local_lists);
+            return local_lists;
+        },
+        [](StdVec<IndexVector> x, const StdVec<IndexVector> &y) -> StdVec<IndexVector>
+        {
+            for (size_t k = 0; k != x.size(); ++k)
+                x[k].insert(x[k].end(), y[k].begin(), y[k].end());
+            return x;
+        });
+}
+//=================================================================================================//
+/** Register the global particle id, which is the particle index if it is not given by the particle generator. */
+static StdLargeVec<int> &registerGlobalParticleId(BaseParticles &base_particles)
+{
+    bool is_registered = findVariableByName<int>(base_particles.AllDiscreteVariables(), "GlobalParticleId") != nullptr;
+    StdLargeVec<int> &global_id = *base_particles.registerSharedVariable<int>("GlobalParticleId");
+    if (!is_registered)
+    {
+        for (size_t i = 0; i != base_particles.total_real_particles_; ++i)
+            global_id[i] = (int)i;
+    }
+    base_particles.registerSortableVariable<int>("GlobalParticleId");
+    base_particles.addVariableToWrite<int>("GlobalParticleId");
+    return global_id;
+}
+//=================================================================================================//
+template <typename DataType>
+void DomainDecomposition::packParticleData<DataType>::
+operator()(ParticleData &particle_data, size_t index, char *&buffer) const
+{
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    for (size_t i = 0; i != std::get<type_index>(particle_data).size(); ++i)
+    {
+        std::memcpy(buffer, reinterpret_cast<const char *>(&(*std::get<type_index>(particle_data)[i])[index]), sizeof(DataType));
+        buffer += sizeof(DataType);
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void DomainDecomposition::unpackParticleData<DataType>::
+operator()(ParticleData &particle_data, size_t index, const char *&buffer) const
+{
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    for (size_t i = 0; i != std::get<type_index>(particle_data).size(); ++i)
+    {
+        std::memcpy(reinterpret_cast<char *>(&(*std::get<type_index>(particle_data)[i])[index]), buffer, sizeof(DataType));
+        buffer += sizeof(DataType);
+    }
+}
+//=================================================================================================//
+DomainDecomposition::DomainDecomposition(RealBody &real_body, RecursiveBisection &recursive_bisection)
+    : real_body_(real_body), base_particles_(real_body.getBaseParticles()),
+      recursive_bisection_(recursive_bisection),
+      halo_width_(real_body.sph_adaptation_->getKernel()->CutOffRadius()),
+      global_id_(registerGlobalParticleId(base_particles_)),
+      halo_send_lists_(MPIEnvironment::Size()), migration_send_lists_(MPIEnvironment::Size()),
+      first_halo_particle_(0), total_halo_particles_(0),
+      send_buffers_(MPIEnvironment::Size()), receive_buffers_(MPIEnvironment::Size())
+{
+    checkPartitioned();
+    BoundingBox &subdomain = recursive_bisection_.Subdomain(MPIEnvironment::Rank());
+    BoundingBox system_bounds = real_body_.getSPHSystemBounds();
+    real_body_.setCellLinkedListBounds(
+        BoundingBox((subdomain.first_ - Vecd::Constant(halo_width_)).cwiseMax(system_bounds.first_),
+                    (subdomain.second_ + Vecd::Constant(halo_width_)).cwiseMin(system_bounds.second_)));
+}
+//=================================================================================================//
+ParticleData &DomainDecomposition::HaloData()
+{
+    return isGlobalIdSentSeparately() ? base_particles_.ghost_data_ : base_particles_.getAllParticleData();
+}
+//=================================================================================================//
+bool DomainDecomposition::isGlobalIdSentSeparately()
+{
+    return !std::get<DataTypeIndex<Vecd>::value>(base_particles_.ghost_data_).empty();
+}
+//=================================================================================================//
+size_t DomainDecomposition::ParticleDataBytes(ParticleData &particle_data)
+{
+    return std::get<DataTypeIndex<Real>::value>(particle_data).size() * sizeof(Real) +
+           std::get<DataTypeIndex<Vec2d>::value>(particle_data).size() * sizeof(Vec2d) +
+           std::get<DataTypeIndex<Vec3d>::value>(particle_data).size() * sizeof(Vec3d) +
+           std::get<DataTypeIndex<Mat2d>::value>(particle_data).size() * sizeof(Mat2d) +
+           std::get<DataTypeIndex<Mat3d>::value>(particle_data).size() * sizeof(Mat3d) +
+           std::get<DataTypeIndex<int>::value>(particle_data).size() * sizeof(int) +
+           std::get<DataTypeIndex<SingleReal>::value>(particle_data).size() * sizeof(SingleReal);
+}
+//=================================================================================================//
+Real DomainDecomposition::SquaredDistanceToBox(const Vecd &position, const BoundingBox &box)
+{
+    Vecd gap = (box.first_ - position).cwiseMax(position - box.second_).cwiseMax(Vecd::Zero());
+    return gap.squaredNorm();
+}
+//=================================================================================================//
+void DomainDecomposition::checkPartitioned()
+{
+    if (!recursive_bisection_.isPartitioned())
+    {
+        std::cout << "\n Error: the domain is not partitioned for body " << real_body_.getName() << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+void DomainDecomposition::removeParticlesOfOtherProcesses()
+{
+    checkPartitioned();
+    int rank = MPIEnvironment::Rank();
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    parallel_for(
+        IndexRange(0, base_particles_.total_real_particles_),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                if (recursive_bisection_.OwnerRank(pos[i]) != rank)
+                    base_particles_.markParticleForDeletion(i);
+        },
+        ap);
+    base_particles_.commitParticleCreationAndDeletion();
+}
+//=================================================================================================//
+void DomainDecomposition::reserveRealParticles(size_t total_real_particles)
+{
+    size_t real_particles_bound = base_particles_.real_particles_bound_;
+    if (total_real_particles > real_particles_bound)
+    {
+        /** the ghost particles are reserved again after the cell linked list is updated */
+        base_particles_.total_ghost_particles_ = 0;
+        base_particles_.addBufferParticles(total_real_particles - real_particles_bound);
+        /** former ghost particles refer to real particles by their sorted ids */
+        for (size_t i = real_particles_bound; i != total_real_particles; ++i)
+            base_particles_.sorted_id_[base_particles_.unsorted_id_[i]] = i;
+    }
+}
+//=================================================================================================//
+void DomainDecomposition::packParticles(ParticleData &particle_data, const StdVec<IndexVector> &send_lists,
+                                        bool is_global_id_separate)
+{
+    size_t particle_bytes = ParticleDataBytes(particle_data) + (is_global_id_separate ? sizeof(int) : 0);
+    for (size_t k = 0; k != send_lists.size(); ++k)
+    {
+        const IndexVector &send_list = send_lists[k];
+        send_buffers_[k].resize(send_list.size() * particle_bytes);
+        char *buffer_begin = send_buffers_[k].data();
+        parallel_for(
+            IndexRange(0, send_list.size()),
+            [&](const IndexRange &r)
+            {
+                for (size_t n = r.begin(); n != r.end(); ++n)
+                {
+                    char *buffer = buffer_begin + n * particle_bytes;
+                    pack_particle_data_(particle_data, send_list[n], buffer);
+                    if (is_global_id_separate)
+                        std::memcpy(buffer, &global_id_[send_list[n]], sizeof(int));
+                }
+            },
+            ap);
+    }
+}
+//=================================================================================================//
+size_t DomainDecomposition::unpackParticles(ParticleData &particle_data, size_t first_index, bool is_global_id_separate)
+{
+    size_t particle_bytes = ParticleDataBytes(particle_data) + (is_global_id_separate ? sizeof(int) : 0);
+    size_t index = first_index;
+    for (const StdVec<char> &receive_buffer : receive_buffers_)
+    {
+        const char *buffer_begin = receive_buffer.data();
+        size_t received_particles = receive_buffer.size() / particle_bytes;
+        parallel_for(
+            IndexRange(0, received_particles),
+            [&](const IndexRange &r)
+            {
+                for (size_t n = r.begin(); n != r.end(); ++n)
+                {
+                    const char *buffer = buffer_begin + n * particle_bytes;
+                    unpack_particle_data_(particle_data, index + n, buffer);
+                    if (is_global_id_separate)
+                        std::memcpy(&global_id_[index + n], buffer, sizeof(int));
+                }
+            },
+            ap);
+        index += received_particles;
+    }
+    return index - first_index;
+}
+//=================================================================================================//
+void DomainDecomposition::migrateParticles()
+{
+    checkPartitioned();
+    int rank = MPIEnvironment::Rank();
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    size_t total_real_particles = base_particles_.total_real_particles_;
+    owner_ranks_.resize(total_real_particles);
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                owner_ranks_[i] = recursive_bisection_.OwnerRank(pos[i]);
+                if (owner_ranks_[i] != rank)
+                    base_particles_.markParticleForDeletion(i);
+            }
+        },
+        ap);
+    selectParticlesToSend(total_real_particles, migration_send_lists_,
+                          [&](size_t i, StdVec<IndexVector> &send_lists)
+                          {
+                              if (owner_ranks_[i] != rank)
+                                  send_lists[owner_ranks_[i]].push_back(i);
+                          });
+
+    ParticleData &all_particle_data = base_particles_.getAllParticleData();
+    packParticles(all_particle_data, migration_send_lists_, false);
+    MPIEnvironment::exchangeBuffers(send_buffers_, receive_buffers_);
+    base_particles_.commitParticleCreationAndDeletion();
+
+    size_t particle_bytes = ParticleDataBytes(all_particle_data);
+    size_t total_received_particles = 0;
+    for (const StdVec<char> &receive_buffer : receive_buffers_)
+        total_received_particles += receive_buffer.size() / particle_bytes;
+    reserveRealParticles(base_particles_.total_real_particles_ + total_received_particles);
+    base_particles_.total_real_particles_ +=
+        unpackParticles(all_particle_data, base_particles_.total_real_particles_, false);
+}
+//=================================================================================================//
+void DomainDecomposition::sendHaloData()
+{
+    packParticles(HaloData(), halo_send_lists_, isGlobalIdSentSeparately());
+    MPIEnvironment::exchangeBuffers(send_buffers_, receive_buffers_);
+}
+//=================================================================================================//
+void DomainDecomposition::exchangeHaloParticles()
+{
+    int rank = MPIEnvironment::Rank();
+    Real halo_width_sqr = halo_width_ * halo_width_;
+    BoundingBox &subdomain = recursive_bisection_.Subdomain(rank);
+
+    neighbor_ranks_.clear();
+    for (int k = 0; k != MPIEnvironment::Size(); ++k)
+    {
+        BoundingBox &other = recursive_bisection_.Subdomain(k);
+        Vecd gap = (other.first_ - subdomain.second_).cwiseMax(subdomain.first_ - other.second_).cwiseMax(Vecd::Zero());
+        if (k != rank && gap.squaredNorm() < halo_width_sqr)
+            neighbor_ranks_.push_back(k);
+    }
+
+    StdLargeVec<Vecd> &pos = base_particles_.pos_;
+    selectParticlesToSend(base_particles_.total_real_particles_, halo_send_lists_,
+                          [&](size_t i, StdVec<IndexVector> &send_lists)
+                          {
+                              Real distance_to_boundary = (pos[i] - subdomain.first_).cwiseMin(subdomain.second_ - pos[i]).minCoeff();
+                              if (distance_to_boundary < halo_width_)
+                              {
+                                  for (size_t k : neighbor_ranks_)
+                                      if (SquaredDistanceToBox(pos[i], recursive_bisection_.Subdomain(k)) < halo_width_sqr)
+                                          send_lists[k].push_back(i);
+                              }
+                          });
+
+    sendHaloData();
+
+    bool is_global_id_separate = isGlobalIdSentSeparately();
+    size_t particle_bytes = ParticleDataBytes(HaloData()) + (is_global_id_separate ? sizeof(int) : 0);
+    total_halo_particles_ = 0;
+    for (const StdVec<char> &receive_buffer : receive_buffers_)
+        total_halo_particles_ += receive_buffer.size() / particle_bytes;
+    first_halo_particle_ = base_particles_.reserveGhostParticles(total_halo_particles_);
+    unpackParticles(HaloData(), first_halo_particle_, is_global_id_separate);
+
+    BaseCellLinkedList &cell_linked_list = real_body_.getCellLinkedList();
+    for (size_t halo_index = first_halo_particle_; halo_index != first_halo_particle_ + total_halo_particles_; ++halo_index)
+    {
+        base_particles_.sorted_id_[halo_index] = halo_index;
+        cell_linked_list.InsertListDataEntry(halo_index, pos[halo_index], base_particles_.Vol_[halo_index]);
+    }
+}
+//=================================================================================================//
+void DomainDecomposition::updateHaloParticles()
+{
+    sendHaloData();
+    unpackParticles(HaloData(), first_halo_particle_, isGlobalIdSentSeparately());
+}
+//=================================================================================================//
+void DomainDecomposition::updateCellLinkedList()
+{
+    migrateParticles();
+    real_body_.updateCellLinkedList();
+    exchangeHaloParticles();
+}
+//=================================================================================================//
+} // namespace SPH
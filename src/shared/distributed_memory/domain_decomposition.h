@@ -0,0 +1,248 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	domain_decomposition.h
+ * @brief 	Spatial decomposition of bodies over processes for distributed-memory computing.
+ * @details The domain is partitioned by recursive coordinate bisection on particle positions,
+ *			so that each process owns a box-shaped subdomain with nearly the same number of particles.
+ *			Each process keeps the particles in its subdomain as real particles,
+ *			and the particles of other processes within a cut-off radius of the subdomain
+ *			as halo particles, which are ghost particles of the body.
+ *			Particles crossing subdomain boundaries migrate when the cell linked list is updated.
+ *			The same partition is shared by all bodies so that the halo also serves contact interactions.
+ *			Each particle keeps a global id, which is exchanged with the particle data.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef DOMAIN_DECOMPOSITION_H
+#define DOMAIN_DECOMPOSITION_H
+
+#include "base_particle_dynamics.h"
+#include "base_particle_generator.h"
+#include "mpi_environment.h"
+
+namespace SPH
+{
+/**
+ * @class RecursiveBisection
+ * @brief Partition of the space into one box per process.
+ * @details A group of processes is split into two halves along the longest extent of the positions in the group,
+ * at the coordinate which divides the particles in proportion to the numbers of processes in the halves.
+ * The split coordinates are found by bisection with global particle counts, hence this is a collective operation.
+ * The outer faces of the subdomains at the domain boundary are unbounded, so that every position has an owner.
+ */
+class RecursiveBisection
+{
+  public:
+    RecursiveBisection();
+    virtual ~RecursiveBisection(){};
+
+    /** Collective partition with the particles of the given bodies on all processes. */
+    void partition(const RealBodyVector &real_bodies);
+    int OwnerRank(const Vecd &position);
+    BoundingBox &Subdomain(int rank) { return subdomains_[rank]; };
+    bool isPartitioned() { return !nodes_.empty(); };
+
+  protected:
+    /** An inner node splits at the coordinate along the axis, a leaf node has the owner rank. */
+    struct BisectionNode
+    {
+        int axis_;
+        Real split_;
+        size_t lower_child_, upper_child_;
+        int rank_;
+    };
+    StdVec<BisectionNode> nodes_;
+    StdVec<BoundingBox> subdomains_;
+    /** Number of bisection steps for a split coordinate. */
+    static constexpr int bisection_steps_ = 50;
+};
+
+/**
+ * @class DistributedParticleGeneratorBase
+ * @brief Keep on this process only every particle whose generation order modulo the number of processes is the rank.
+ * @details All processes go through the same generation, but each stores only its share of the particles,
+ * so that the particle capacity of a body is set per process. The generation order is kept as the global particle id.
+ * The particles are moved to the processes owning their positions by the first migration after the partition.
+ */
+template <class ParticleGeneratorType>
+class DistributedParticleGeneratorBase : public ParticleGeneratorType
+{
+  public:
+    template <typename... Args>
+    explicit DistributedParticleGeneratorBase(SPHBody &sph_body, Args &&...args)
+        : ParticleGeneratorType(sph_body, std::forward<Args>(args)...),
+          rank_(MPIEnvironment::Rank()), number_of_ranks_(MPIEnvironment::Size()),
+          total_generated_particles_(0), is_last_particle_kept_(false){};
+    virtual ~DistributedParticleGeneratorBase(){};
+
+    virtual void generateParticlesWithBasicVariables() override
+    {
+        ParticleGeneratorType::generateParticlesWithBasicVariables();
+        StdLargeVec<int> &global_id = *this->base_particles_.template registerSharedVariable<int>("GlobalParticleId");
+        std::copy(global_ids_.begin(), global_ids_.end(), global_id.begin());
+    };
+
+  protected:
+    size_t rank_, number_of_ranks_;
+    size_t total_generated_particles_;
+    bool is_last_particle_kept_;
+    StdLargeVec<int> global_ids_;
+
+    virtual void initializePositionAndVolumetricMeasure(const Vecd &position, Real volumetric_measure) override
+    {
+        size_t global_id = total_generated_particles_++;
+        is_last_particle_kept_ = global_id % number_of_ranks_ == rank_;
+        if (is_last_particle_kept_)
+        {
+            global_ids_.push_back((int)global_id);
+            ParticleGeneratorType::initializePositionAndVolumetricMeasure(position, volumetric_measure);
+        }
+    };
+};
+
+template <class ParticleGeneratorType,
+          bool = std::is_base_of<ParticleGenerator<Surface>, ParticleGeneratorType>::value>
+class DistributedParticleGenerator : public DistributedParticleGeneratorBase<ParticleGeneratorType>
+{
+  public:
+    using DistributedParticleGeneratorBase<ParticleGeneratorType>::DistributedParticleGeneratorBase;
+    virtual ~DistributedParticleGenerator(){};
+};
+
+/** The surface properties are kept with the positions. */
+template <class ParticleGeneratorType>
+class DistributedParticleGenerator<ParticleGeneratorType, true>
+    : public DistributedParticleGeneratorBase<ParticleGeneratorType>
+{
+  public:
+    using DistributedParticleGeneratorBase<ParticleGeneratorType>::DistributedParticleGeneratorBase;
+    virtual ~DistributedParticleGenerator(){};
+
+  protected:
+    virtual void initializeSurfaceProperties(const Vecd &surface_normal, Real thickness) override
+    {
+        if (this->is_last_particle_kept_)
+            ParticleGeneratorType::initializeSurfaceProperties(surface_normal, thickness);
+    };
+};
+
+/**
+ * @class DomainDecomposition
+ * @brief Particle migration and halo exchange of a real body for a given partition.
+ * @details The halo particles carry the ghost data of the body particles,
+ * i.e. the variables registered by registerGhostVariable if there are any, otherwise all particle variables.
+ * Migrating particles carry all particle variables. Both carry the global particle id "GlobalParticleId",
+ * which is the generation order of a DistributedParticleGenerator or otherwise the particle index at construction.
+ * To be constructed after the partition and before the cell linked list of the body is created,
+ * which then covers only the subdomain of this process and its halo.
+ * The particle capacity of the body is increased if the migrating particles do not fit into the buffer.
+ */
+class DomainDecomposition
+{
+  public:
+    DomainDecomposition(RealBody &real_body, RecursiveBisection &recursive_bisection);
+    virtual ~DomainDecomposition(){};
+
+    /** Keep only the particles owned by this process, when all processes start with the same particles. */
+    void removeParticlesOfOtherProcesses();
+    /** Move the particles to the processes owning their positions. */
+    void migrateParticles();
+    /** Find and send the particles within the halo width of other subdomains,
+     * and receive halo particles as ghost particles, after the cell linked list is updated. */
+    void exchangeHaloParticles();
+    /** Send the current data of the same halo particles again, e.g. before an interaction step. */
+    void updateHaloParticles();
+    /** Migration, cell linked list update and halo exchange,
+     * to be used instead of the update of the cell linked list of the body. */
+    void updateCellLinkedList();
+    RealBody &getRealBody() { return real_body_; };
+    size_t TotalHaloParticles() { return total_halo_particles_; };
+
+  protected:
+    RealBody &real_body_;
+    BaseParticles &base_particles_;
+    RecursiveBisection &recursive_bisection_;
+    Real halo_width_;
+    StdLargeVec<int> &global_id_;
+    StdVec<IndexVector> halo_send_lists_;      /**< local particles sent to each process as halo. */
+    StdVec<IndexVector> migration_send_lists_; /**< local particles migrating to each process. */
+    size_t first_halo_particle_;
+    size_t total_halo_particles_;
+    /** Kept with their capacity, so that repeated exchanges do not allocate. */
+    StdLargeVec<int> owner_ranks_;
+    IndexVector neighbor_ranks_;
+    StdVec<StdVec<char>> send_buffers_;
+    StdVec<StdVec<char>> receive_buffers_;
+
+    ParticleData &HaloData();
+    /** The global id is sent separately with the halo data if only the ghost variables are sent. */
+    bool isGlobalIdSentSeparately();
+    size_t ParticleDataBytes(ParticleData &particle_data);
+    /** Squared distance from a position to a box, zero inside the box. */
+    Real SquaredDistanceToBox(const Vecd &position, const BoundingBox &box);
+    void checkPartitioned();
+    /** Increase the capacity of real particles if needed, before the ghost particles are reserved. */
+    void reserveRealParticles(size_t total_real_particles);
+    /** Pack the data of the listed particles into the send buffers in parallel. */
+    void packParticles(ParticleData &particle_data, const StdVec<IndexVector> &send_lists,
+                       bool is_global_id_separate);
+    /** Unpack the received particles in parallel into continuous particles from the first index.
+     * Return the number of received particles. */
+    size_t unpackParticles(ParticleData &particle_data, size_t first_index, bool is_global_id_separate);
+    void sendHaloData();
+
+    template <typename DataType>
+    struct packParticleData
+    {
+        void operator()(ParticleData &particle_data, size_t index, char *&buffer) const;
+    };
+
+    template <typename DataType>
+    struct unpackParticleData
+    {
+        void operator()(ParticleData &particle_data, size_t index, const char *&buffer) const;
+    };
+
+    DataAssembleOperation<packParticleData> pack_particle_data_;
+    DataAssembleOperation<unpackParticleData> unpack_particle_data_;
+};
+
+/**
+ * @class HaloParticleUpdate
+ * @brief Update the halo particles as a dynamics, e.g. as a pre-process of interaction dynamics.
+ */
+class HaloParticleUpdate : public BaseDynamics<void>
+{
+  public:
+    explicit HaloParticleUpdate(DomainDecomposition &domain_decomposition)
+        : BaseDynamics<void>(domain_decomposition.getRealBody()), domain_decomposition_(domain_decomposition){};
+    virtual ~HaloParticleUpdate(){};
+
+    virtual void exec(Real dt = 0.0) override { domain_decomposition_.updateHaloParticles(); };
+
+  protected:
+    DomainDecomposition &domain_decomposition_;
+};
+} // namespace SPH
+#endif // DOMAIN_DECOMPOSITION_H
@@ -0,0 +1,142 @@
+#include "mpi_environment.h"
+
+#include "scalar_functions.h"
+#include "scratch_arena.h"
+
+#if SPHINXSYS_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace SPH
+{
+#if SPHINXSYS_USE_MPI
+//=================================================================================================//
+static MPI_Op toMPIOperation(MPIEnvironment::ReduceOperation reduce_operation)
+{
+    switch (reduce_operation)
+    {
+    case MPIEnvironment::ReduceOperation::Max:
+        return MPI_MAX;
+    case MPIEnvironment::ReduceOperation::Min:
+        return MPI_MIN;
+    default:
+        return MPI_SUM;
+    }
+}
+//=================================================================================================//
+MPIEnvironment::MPIEnvironment(int &argc, char **&argv)
+{
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+}
+//=================================================================================================//
+MPIEnvironment::~MPIEnvironment()
+{
+    MPI_Finalize();
+}
+//=================================================================================================//
+int MPIEnvironment::Rank()
+{
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    return rank;
+}
+//=================================================================================================//
+int MPIEnvironment::Size()
+{
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    return size;
+}
+//=================================================================================================//
+void MPIEnvironment::barrier()
+{
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+//=================================================================================================//
+void MPIEnvironment::allReduce(Real *data, size_t size, ReduceOperation reduce_operation)
+{
+    MPI_Datatype data_type = sizeof(Real) == sizeof(float) ? MPI_FLOAT : MPI_DOUBLE;
+    MPI_Allreduce(MPI_IN_PLACE, data, (int)size, data_type, toMPIOperation(reduce_operation), MPI_COMM_WORLD);
+}
+//=================================================================================================//
+void MPIEnvironment::allReduce(int *data, size_t size, ReduceOperation reduce_operation)
+{
+    MPI_Allreduce(MPI_IN_PLACE, data, (int)size, MPI_INT, toMPIOperation(reduce_operation), MPI_COMM_WORLD);
+}
+//=================================================================================================//
+void MPIEnvironment::allReduce(size_t *data, size_t size, ReduceOperation reduce_operation)
+{
+    MPI_Datatype data_type = sizeof(size_t) == sizeof(uint64_t) ? MPI_UINT64_T : MPI_UINT32_T;
+    MPI_Allreduce(MPI_IN_PLACE, data, (int)size, data_type, toMPIOperation(reduce_operation), MPI_COMM_WORLD);
+}
+//=================================================================================================//
+void MPIEnvironment::exchangeBuffers(const StdVec<StdVec<char>> &send_buffers, StdVec<StdVec<char>> &receive_buffers)
+{
+    int size = Size();
+    int rank = Rank();
+    ScratchScope scratch_scope;
+    uint64_t *send_counts = scratch_scope.allocate<uint64_t>(size);
+    uint64_t *receive_counts = scratch_scope.allocate<uint64_t>(size);
+    for (int k = 0; k != size; ++k)
+        send_counts[k] = send_buffers[k].size();
+    MPI_Alltoall(send_counts, 1, MPI_UINT64_T, receive_counts, 1, MPI_UINT64_T, MPI_COMM_WORLD);
+
+    /** Point-to-point messages of at most max_message_bytes each, received in the order sent,
+     * so that buffers beyond the int range of the MPI counts are exchanged in chunks. */
+    receive_buffers.resize(size);
+    StdVec<MPI_Request> requests;
+    for (int k = 0; k != size; ++k)
+    {
+        receive_buffers[k].resize(receive_counts[k]);
+        if (k == rank)
+        {
+            std::copy(send_buffers[k].begin(), send_buffers[k].end(), receive_buffers[k].begin());
+            continue;
+        }
+        for (uint64_t offset = 0; offset < receive_counts[k]; offset += max_message_bytes)
+        {
+            requests.emplace_back();
+            int chunk = (int)SMIN(max_message_bytes, receive_counts[k] - offset);
+            MPI_Irecv(receive_buffers[k].data() + offset, chunk, MPI_CHAR, k, 0, MPI_COMM_WORLD, &requests.back());
+        }
+    }
+    for (int k = 0; k != size; ++k)
+    {
+        if (k == rank)
+            continue;
+        for (uint64_t offset = 0; offset < send_counts[k]; offset += max_message_bytes)
+        {
+            requests.emplace_back();
+            int chunk = (int)SMIN(max_message_bytes, send_counts[k] - offset);
+            MPI_Isend(send_buffers[k].data() + offset, chunk, MPI_CHAR, k, 0, MPI_COMM_WORLD, &requests.back());
+        }
+    }
+    MPI_Waitall((int)requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+}
+//=================================================================================================//
+#else
+//=================================================================================================//
+MPIEnvironment::MPIEnvironment(int &argc, char **&argv) {}
+//=================================================================================================//
+MPIEnvironment::~MPIEnvironment() {}
+//=================================================================================================//
+int MPIEnvironment::Rank() { return 0; }
+//=================================================================================================//
+int MPIEnvironment::Size() { return 1; }
+//=================================================================================================//
+void MPIEnvironment::barrier() {}
+//=================================================================================================//
+void MPIEnvironment::allReduce(Real *data, size_t size, ReduceOperation reduce_operation) {}
+//=================================================================================================//
+void MPIEnvironment::allReduce(int *data, size_t size, ReduceOperation reduce_operation) {}
+//=================================================================================================//
+void MPIEnvironment::allReduce(size_t *data, size_t size, ReduceOperation reduce_operation) {}
+//=================================================================================================//
+void MPIEnvironment::exchangeBuffers(const StdVec<StdVec<char>> &send_buffers, StdVec<StdVec<char>> &receive_buffers)
+{
+    receive_buffers = send_buffers;
+}
+//=================================================================================================//
+#endif
+} // namespace SPH
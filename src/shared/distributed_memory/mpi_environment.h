@@ -0,0 +1,72 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	mpi_environment.h
+ * @brief 	The message passing environment for distributed-memory computing.
+ * @details The MPI calls are used only if the library is built with SPHINXSYS_USE_MPI,
+ *			otherwise there is a single process and the communications are trivial,
+ *			so that distributed cases also run with the shared-memory library.
+ *			Within each process, the computing is parallel with threads as usual.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef MPI_ENVIRONMENT_H
+#define MPI_ENVIRONMENT_H
+
+#include "base_data_type.h"
+#include "large_data_containers.h"
+
+namespace SPH
+{
+/**
+ * @class MPIEnvironment
+ * @brief Initialize MPI at construction and finalize it at destruction.
+ * Only one instance, created at the beginning of the main function.
+ */
+class MPIEnvironment
+{
+  public:
+    MPIEnvironment(int &argc, char **&argv);
+    virtual ~MPIEnvironment();
+
+    static int Rank();
+    static int Size();
+    static void barrier();
+
+    enum class ReduceOperation
+    {
+        Sum,
+        Max,
+        Min
+    };
+    static constexpr uint64_t max_message_bytes = std::numeric_limits<int>::max();
+    /** Element-wise in-place reductions across all processes. */
+    static void allReduce(Real *data, size_t size, ReduceOperation reduce_operation);
+    static void allReduce(int *data, size_t size, ReduceOperation reduce_operation);
+    static void allReduce(size_t *data, size_t size, ReduceOperation reduce_operation);
+    /** Send a buffer to every process, possibly empty, and receive one from every process.
+     * Buffers larger than max_message_bytes are sent in several messages. */
+    static void exchangeBuffers(const StdVec<StdVec<char>> &send_buffers, StdVec<StdVec<char>> &receive_buffers);
+};
+} // namespace SPH
+#endif // MPI_ENVIRONMENT_H
@@ -127,6 +127,27 @@ Vecd BinaryShapes::findClosestPoint(const Vecd &probe_point)
     return pnt_closest;
 }
 //=================================================================================================//
+Shape *BinaryShapes::getSingleAddedShape()
+{
+    return sub_shapes_and_ops_.size() == 1 && sub_shapes_and_ops_[0].second == ShapeBooleanOps::add
+               ? sub_shapes_and_ops_[0].first
+               : nullptr;
+}
+//=================================================================================================//
+Real BinaryShapes::findSignedDistance(const Vecd &probe_point)
+{
+    Shape *single_shape = getSingleAddedShape();
+    return single_shape != nullptr ? single_shape->findSignedDistance(probe_point)
+                                   : Shape::findSignedDistance(probe_point);
+}
+//=================================================================================================//
+Vecd BinaryShapes::findNormalDirection(const Vecd &probe_point)
+{
+    Shape *single_shape = getSingleAddedShape();
+    return single_shape != nullptr ? single_shape->findNormalDirection(probe_point)
+                                   : Shape::findNormalDirection(probe_point);
+}
+//=================================================================================================//
 SubShapeAndOp *BinaryShapes::getSubShapeAndOpByName(const std::string &name)
 {
     for (auto &sub_shape_and_op : sub_shapes_and_ops_)
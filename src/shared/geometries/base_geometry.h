@@ -77,10 +77,11 @@ class Shape
 
     bool checkNotFar(const Vecd &probe_point, Real threshold);
     bool checkNearSurface(const Vecd &probe_point, Real threshold);
-    /** Signed distance is negative for point within the shape. */
-    Real findSignedDistance(const Vecd &probe_point);
+    /** Signed distance is negative for point within the shape.
+     * Shapes which carry a distance field themselves override this and the normal direction. */
+    virtual Real findSignedDistance(const Vecd &probe_point);
     /** Normal direction point toward outside of the shape. */
-    Vecd findNormalDirection(const Vecd &probe_point);
+    virtual Vecd findNormalDirection(const Vecd &probe_point);
 
   protected:
     std::string name_;
@@ -124,6 +125,9 @@ class BinaryShapes : public Shape
     virtual bool isValid() override;
     virtual bool checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED = true) override;
     virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    /** Passed to the sub-shape directly if the binary shapes consist of a single added shape. */
+    virtual Real findSignedDistance(const Vecd &probe_point) override;
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override;
     Shape *getSubShapeByName(const std::string &name);
     SubShapeAndOp *getSubShapeAndOpByName(const std::string &name);
     size_t getSubShapeIndexByName(const std::string &name);
@@ -133,6 +137,7 @@ class BinaryShapes : public Shape
     StdVec<SubShapeAndOp> sub_shapes_and_ops_;
 
     virtual BoundingBox findBounds() override;
+    Shape *getSingleAddedShape();
 };
 
 /**
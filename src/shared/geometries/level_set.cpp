@@ -1,5 +1,6 @@
 #include "level_set.h"
 #include "adaptation.h"
+#include "scratch_arena.h"
 
 namespace SPH
 {
@@ -35,8 +36,9 @@ LevelSet::LevelSet(BoundingBox tentative_bounds, Real data_spacing, size_t buffe
       phi_(*registerMeshVariable<Real>("Levelset")),
       near_interface_id_(*registerMeshVariable<int>("NearInterfaceID")),
       phi_gradient_(*registerMeshVariable<Vecd>("LevelsetGradient")),
-      kernel_weight_(*registerMeshVariable<Real>("KernelWeight")),
-      kernel_gradient_(*registerMeshVariable<Vecd>("KernelGradient")),
+      kernel_weight_(*registerMeshVariable<Real>(kernel_integral_variables_, "KernelWeight")),
+      kernel_gradient_(*registerMeshVariable<Vecd>(kernel_integral_variables_, "KernelGradient")),
+      kernel_integrals_in_cells_(all_cells_),
       kernel_(*sph_adaptation.getKernel())
 {
     Real far_field_distance = grid_spacing_ * (Real)buffer_width_;
@@ -46,6 +48,20 @@ LevelSet::LevelSet(BoundingBox tentative_bounds, Real data_spacing, size_t buffe
     initializeASingularDataPackage(
         all_mesh_variables_, [&](LevelSetDataPackage *data_pkg)
         { initializeDataForSingularPackage(data_pkg, far_field_distance); });
+
+    for (Real far_field_level_set : {-far_field_distance, far_field_distance})
+    {
+        LevelSetDataPackage *kernel_pkg = data_pkg_pool_.malloc();
+        kernel_pkg->allocateAllVariables(kernel_integral_variables_);
+        kernel_pkg->assignByPosition(
+            kernel_weight_, [&](const Vecd &position) -> Real
+            { return far_field_level_set < 0.0 ? 0.0 : 1.0; });
+        kernel_pkg->assignByPosition(
+            kernel_gradient_, [&](const Vecd &position) -> Vecd
+            { return Vecd::Zero(); });
+        kernel_pkg->assignSingularPackageDataAddress();
+        singular_kernel_integral_pkgs_.push_back(kernel_pkg);
+    }
 }
 //=================================================================================================//
 void LevelSet::initializeAddressesInACell(const Arrayi &cell_index)
@@ -61,16 +77,74 @@ void LevelSet::updateLevelSetGradient()
 //=================================================================================================//
 void LevelSet::updateKernelIntegrals()
 {
-    package_parallel_for(inner_data_pkgs_,
-                         [&](LevelSetDataPackage *data_pkg)
+    package_parallel_for(inner_data_pkgs_, [&](LevelSetDataPackage *data_pkg)
+                         { prepareKernelIntegralsInCell(data_pkg->CellIndexOnMesh()); });
+}
+//=================================================================================================//
+void LevelSet::initializeKernelIntegrals()
+{
+    kernel_integrals_.resize(inner_data_pkgs_.size());
+    for (size_t i = 0; i != inner_data_pkgs_.size(); ++i)
+        kernel_integrals_in_cells_.assignPackage(inner_data_pkgs_[i]->CellIndexOnMesh(), &kernel_integrals_[i]);
+    resetKernelIntegrals();
+}
+//=================================================================================================//
+void LevelSet::resetKernelIntegrals()
+{
+    parallel_for(
+        IndexRange(0, kernel_integrals_.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                kernel_integrals_[i].is_computed_ = makeUnique<tbb::collaborative_once_flag>();
+                kernel_integrals_[i].is_prepared_ = makeUnique<tbb::collaborative_once_flag>();
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void LevelSet::computeKernelIntegralsForAPackage(LevelSetDataPackage *data_pkg)
+{
+    Arrayi cell_index = data_pkg->CellIndexOnMesh();
+    KernelIntegralsInACell &kernel_integrals = *kernel_integrals_in_cells_.PackageFromCellIndex(cell_index);
+    tbb::collaborative_call_once(
+        *kernel_integrals.is_computed_,
+        [&]()
+        {
+            LevelSetDataPackage *kernel_pkg = kernel_integrals.kernel_pkg_;
+            if (kernel_pkg == nullptr) // allocated when first computed and reused after a reset
+            {
+                Vecd grid_position = GridPositionFromCellPosition(CellPositionFromIndex(cell_index));
+                kernel_pkg = data_pkg_pool_.malloc(grid_position, data_spacing_);
+                kernel_pkg->allocateAllVariables(kernel_integral_variables_);
+                kernel_pkg->setInnerPackage();
+                kernel_pkg->setCellIndexOnMesh(cell_index);
+                kernel_integrals.kernel_pkg_ = kernel_pkg;
+            }
+            kernel_pkg->assignByPosition(
+                kernel_weight_, [&](const Vecd &position) -> Real
+                { return computeKernelIntegral(position); });
+            kernel_pkg->assignByPosition(
+                kernel_gradient_, [&](const Vecd &position) -> Vecd
+                { return computeKernelGradientIntegral(position); });
+        });
+}
+//=================================================================================================//
+LevelSet::LevelSetDataPackage *LevelSet::KernelIntegralPackage(LevelSetDataPackage *data_pkg)
+{
+    if (data_pkg->isInnerPackage())
+        return kernel_integrals_in_cells_.PackageFromCellIndex(data_pkg->CellIndexOnMesh())->kernel_pkg_;
+    return data_pkg == singular_data_pkgs_addrs_[0] ? singular_kernel_integral_pkgs_[0]
+                                                    : singular_kernel_integral_pkgs_[1];
+}
+//=================================================================================================//
+void LevelSet::prepareKernelIntegralsNearInterface()
+{
+    package_parallel_for(inner_data_pkgs_, [&](LevelSetDataPackage *data_pkg)
                          {
-                             data_pkg->assignByPosition(
-                                 kernel_weight_, [&](const Vecd &position) -> Real
-                                 { return computeKernelIntegral(position); });
-                             data_pkg->assignByPosition(
-                                 kernel_gradient_, [&](const Vecd &position) -> Vecd
-                                 { return computeKernelGradientIntegral(position); });
-                         });
+                             if (data_pkg->isCorePackage())
+                                 prepareKernelIntegralsInCell(data_pkg->CellIndexOnMesh()); });
 }
 //=================================================================================================//
 Vecd LevelSet::probeNormalDirection(const Vecd &position)
@@ -100,12 +174,66 @@ Real LevelSet::probeSignedDistance(const Vecd &position)
 //=================================================================================================//
 Real LevelSet::probeKernelIntegral(const Vecd &position, Real h_ratio)
 {
-    return probeMesh(kernel_weight_, position);
+    return probeKernelIntegralPackage(kernel_weight_, position);
 }
 //=================================================================================================//
 Vecd LevelSet::probeKernelGradientIntegral(const Vecd &position, Real h_ratio)
 {
-    return probeMesh(kernel_gradient_, position);
+    return probeKernelIntegralPackage(kernel_gradient_, position);
+}
+//=================================================================================================//
+void LevelSet::probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                   StdLargeVec<Real> &results)
+{
+    probeMesh(phi_, positions, indices, results);
+}
+//=================================================================================================//
+void LevelSet::probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                    StdLargeVec<Vecd> &results)
+{
+    probeMesh(phi_gradient_, positions, indices, results);
+
+    Real threshold = 1.0e-2 * data_spacing_;
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t index_i = indices[n];
+                results[index_i] = results[index_i].norm() < threshold
+                                       ? probeNormalDirection(positions[index_i])
+                                       : results[index_i].normalized();
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void LevelSet::probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                           StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios)
+{
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            Arrayi current_cell = -Arrayi::Ones();
+            LevelSetDataPackage *kernel_pkg = nullptr;
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t index_i = indices[n];
+                Arrayi cell_index = CellIndexFromPosition(positions[index_i]);
+                if ((cell_index != current_cell).any())
+                {
+                    current_cell = cell_index;
+                    LevelSetDataPackage *data_pkg = DataPackageFromCellIndex(cell_index);
+                    if (data_pkg->isInnerPackage())
+                        prepareKernelIntegralsInCell(cell_index);
+                    kernel_pkg = KernelIntegralPackage(data_pkg);
+                }
+                results[index_i] = kernel_pkg->probePackage(kernel_gradient_, positions[index_i]);
+            }
+        },
+        ap);
 }
 //=================================================================================================//
 void LevelSet::redistanceInterface()
@@ -127,7 +255,7 @@ void LevelSet::cleanInterface(Real small_shift_factor)
     redistanceInterface();
     reinitializeLevelSet();
     updateLevelSetGradient();
-    updateKernelIntegrals();
+    resetKernelIntegrals();
 }
 //=============================================================================================//
 void LevelSet::correctTopology(Real small_shift_factor)
@@ -136,7 +264,7 @@ void LevelSet::correctTopology(Real small_shift_factor)
     for (size_t i = 0; i != 10; ++i)
         diffuseLevelSetSign();
     updateLevelSetGradient();
-    updateKernelIntegrals();
+    resetKernelIntegrals();
 }
 //=================================================================================================//
 bool LevelSet::probeIsWithinMeshBound(const Vecd &position)
@@ -278,6 +406,12 @@ void MultilevelLevelSet::correctTopology(Real small_shift_factor)
     mesh_levels_.back()->correctTopology(small_shift_factor);
 }
 //=============================================================================================//
+void MultilevelLevelSet::prepareKernelIntegralsNearInterface()
+{
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->prepareKernelIntegralsNearInterface();
+}
+//=============================================================================================//
 Real MultilevelLevelSet::probeSignedDistance(const Vecd &position)
 {
     return mesh_levels_[getProbeLevel(position)]->probeSignedDistance(position);
@@ -323,6 +457,102 @@ Vecd MultilevelLevelSet::probeKernelGradientIntegral(const Vecd &position, Real
     return alpha * coarse_level_value + (1.0 - alpha) * fine_level_value;
 }
 //=================================================================================================//
+void MultilevelLevelSet::probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Real> &results)
+{
+    ScratchScope scratch;
+    size_t *probe_levels = scratch.allocate<size_t>(indices.size());
+    findProbeLevels(positions, indices, probe_levels);
+    groupIndicesByLevel(indices, probe_levels);
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->probeSignedDistance(positions, level_indices_[level], results);
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                              StdLargeVec<Vecd> &results)
+{
+    ScratchScope scratch;
+    size_t *probe_levels = scratch.allocate<size_t>(indices.size());
+    findProbeLevels(positions, indices, probe_levels);
+    groupIndicesByLevel(indices, probe_levels);
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->probeNormalDirection(positions, level_indices_[level], results);
+}
+//=================================================================================================//
+void MultilevelLevelSet::findProbeLevels(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                         size_t *probe_levels)
+{
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+                probe_levels[n] = getProbeLevel(positions[indices[n]]);
+        },
+        ap);
+}
+//=================================================================================================//
+void MultilevelLevelSet::groupIndicesByLevel(const IndexVector &indices, const size_t *levels)
+{
+    level_indices_.resize(total_levels_);
+    for (size_t level = 0; level != total_levels_; ++level)
+        gatherIndices(indices, level_indices_[level],
+                      [&](size_t n)
+                      { return levels[n] == level; });
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                                     StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios)
+{
+    if (total_levels_ == 1)
+    {
+        mesh_levels_[0]->probeKernelGradientIntegral(positions, indices, results);
+        return;
+    }
+
+    ScratchScope scratch;
+    size_t *coarse_levels = scratch.allocate<size_t>(indices.size());
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                Real h_ratio = h_ratios == nullptr ? 1.0 : (*h_ratios)[indices[n]];
+                coarse_levels[n] = SMIN(getCoarseLevel(h_ratio), total_levels_ - 2);
+            }
+        },
+        ap);
+    groupIndicesByLevel(indices, coarse_levels);
+
+    if (coarse_level_values_.size() < positions.size())
+        coarse_level_values_.resize(positions.size());
+    for (size_t level = 0; level + 1 < total_levels_; ++level)
+    {
+        IndexVector &level_probes = level_indices_[level];
+        if (level_probes.empty())
+            continue;
+
+        mesh_levels_[level]->probeKernelGradientIntegral(positions, level_probes, coarse_level_values_);
+        mesh_levels_[level + 1]->probeKernelGradientIntegral(positions, level_probes, results);
+        Real coarse_h_ratio = mesh_levels_[level]->global_h_ratio_;
+        Real fine_h_ratio = mesh_levels_[level + 1]->global_h_ratio_;
+        parallel_for(
+            IndexRange(0, level_probes.size()),
+            [&](const IndexRange &r)
+            {
+                for (size_t n = r.begin(); n != r.end(); ++n)
+                {
+                    size_t index_i = level_probes[n];
+                    Real h_ratio = h_ratios == nullptr ? 1.0 : (*h_ratios)[index_i];
+                    Real alpha = (fine_h_ratio - h_ratio) / (fine_h_ratio - coarse_h_ratio);
+                    results[index_i] = alpha * coarse_level_values_[index_i] + (1.0 - alpha) * results[index_i];
+                }
+            },
+            ap);
+    }
+}
+//=================================================================================================//
 bool MultilevelLevelSet::probeIsWithinMeshBound(const Vecd &position)
 {
     bool is_bounded = true;
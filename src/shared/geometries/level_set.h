@@ -33,6 +33,8 @@
 #include "base_geometry.h"
 #include "mesh_with_data_packages.hpp"
 
+#include <tbb/collaborative_call_once.h>
+
 namespace SPH
 {
 /**
@@ -55,6 +57,17 @@ class BaseLevelSet : public BaseMeshField
     virtual Vecd probeLevelSetGradient(const Vecd &position) = 0;
     virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) = 0;
     virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) = 0;
+    /** Batched probes at positions[indices[n]], the results are stored with the same indices.
+     * The optional h_ratios, given for all particles, replace the uniform ratio of 1.0. */
+    virtual void probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &results) = 0;
+    virtual void probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                      StdLargeVec<Vecd> &results) = 0;
+    virtual void probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios = nullptr) = 0;
+    /** Kernel integrals are computed lazily when first probed,
+     * this computes them in advance for the packages around the zero level set only. */
+    virtual void prepareKernelIntegralsNearInterface() = 0;
 
   protected:
     Shape &shape_; /**< the geometry is described by the level set. */
@@ -96,6 +109,13 @@ class LevelSet : public MeshWithGridDataPackages<GridDataPackage<4, 1>>,
     virtual Vecd probeLevelSetGradient(const Vecd &position) override;
     virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) override;
     virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) override;
+    virtual void probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &results) override;
+    virtual void probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                      StdLargeVec<Vecd> &results) override;
+    virtual void probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios = nullptr) override;
+    virtual void prepareKernelIntegralsNearInterface() override;
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
     bool isWithinCorePackage(Vecd position);
     Real computeKernelIntegral(const Vecd &position);
@@ -105,8 +125,22 @@ class LevelSet : public MeshWithGridDataPackages<GridDataPackage<4, 1>>,
     MeshVariable<Real> &phi_;
     MeshVariable<int> &near_interface_id_;
     MeshVariable<Vecd> &phi_gradient_;
+    /** The kernel integrals are not allocated with the level set packages,
+     * but in packages of their own, created for the cells in which they are computed. */
+    MeshVariableAssemble kernel_integral_variables_;
     MeshVariable<Real> &kernel_weight_;
     MeshVariable<Vecd> &kernel_gradient_;
+    /** The kernel integrals of an inner package are computed once on demand.
+     * The flags are replaced when the integrals are reset. */
+    struct KernelIntegralsInACell
+    {
+        LevelSetDataPackage *kernel_pkg_ = nullptr;
+        UniquePtr<tbb::collaborative_once_flag> is_computed_;  /**< the integrals in the package. */
+        UniquePtr<tbb::collaborative_once_flag> is_prepared_;  /**< also those of the neighbors and the addresses to them. */
+    };
+    StdVec<KernelIntegralsInACell> kernel_integrals_;         /**< in the order of the inner packages. */
+    CellAddresses<KernelIntegralsInACell> kernel_integrals_in_cells_;
+    StdVec<LevelSetDataPackage *> singular_kernel_integral_pkgs_; /**< for inner and outer far field. */
     Kernel &kernel_;
 
     void initializeDataForSingularPackage(LevelSetDataPackage *data_pkg, Real far_field_level_set);
@@ -119,7 +153,27 @@ class LevelSet : public MeshWithGridDataPackages<GridDataPackage<4, 1>>,
     void redistanceInterface();
     void diffuseLevelSetSign();
     void updateLevelSetGradient();
+    /** compute the kernel integrals of all inner packages at once. */
     void updateKernelIntegrals();
+    /** invalidate the kernel integrals after the level set is changed. */
+    void resetKernelIntegrals();
+    /** assign the kernel integrals to the cells of the inner packages. */
+    void initializeKernelIntegrals();
+    void computeKernelIntegralsForAPackage(LevelSetDataPackage *data_pkg);
+    /** ensure the kernel integrals are available for probing within the cell. */
+    void prepareKernelIntegralsInCell(const Arrayi &cell_index);
+    /** the package of the kernel integrals in the cell of the given level set package. */
+    LevelSetDataPackage *KernelIntegralPackage(LevelSetDataPackage *data_pkg);
+    /** probe a kernel integral, the cell is prepared only once. */
+    template <class DataType>
+    DataType probeKernelIntegralPackage(const MeshVariable<DataType> &kernel_variable, const Vecd &position)
+    {
+        Arrayi cell_index = CellIndexFromPosition(position);
+        LevelSetDataPackage *data_pkg = DataPackageFromCellIndex(cell_index);
+        if (data_pkg->isInnerPackage())
+            prepareKernelIntegralsInCell(cell_index);
+        return KernelIntegralPackage(data_pkg)->probePackage(kernel_variable, position);
+    };
     bool isInnerPackage(const Arrayi &cell_index);
     void initializeDataInACell(const Arrayi &cell_index);
     void initializeAddressesInACell(const Arrayi &cell_index);
@@ -161,10 +215,24 @@ class MultilevelLevelSet : public MultilevelMesh<BaseLevelSet, LevelSet, Refined
     virtual Vecd probeLevelSetGradient(const Vecd &position) override;
     virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) override;
     virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) override;
+    virtual void probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &results) override;
+    virtual void probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                      StdLargeVec<Vecd> &results) override;
+    virtual void probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios = nullptr) override;
+    virtual void prepareKernelIntegralsNearInterface() override;
 
   protected:
     inline size_t getProbeLevel(const Vecd &position);
     inline size_t getCoarseLevel(Real h_ratio);
+    /** The buffers of the batched probes are kept for the next probes,
+     * hence the batched probes of a level set are not called concurrently. */
+    StdVec<IndexVector> level_indices_;     /**< the indices of the probes answered by each level. */
+    StdLargeVec<Vecd> coarse_level_values_; /**< the kernel integrals from the coarser level. */
+
+    void findProbeLevels(const StdLargeVec<Vecd> &positions, const IndexVector &indices, size_t *probe_levels);
+    void groupIndicesByLevel(const IndexVector &indices, const size_t *levels);
 };
 } // namespace SPH
 #endif // LEVEL_SET_H
@@ -25,6 +25,10 @@ LevelSetShape::LevelSetShape(SPHBody &sph_body, Shape &shape, Real refinement_ra
     is_bounds_found_ = true;
 }
 //=================================================================================================//
+LevelSetShape::LevelSetShape(const std::string &shape_name, LevelSetShape &level_set_shape)
+    : Shape(shape_name), sph_adaptation_(level_set_shape.sph_adaptation_),
+      level_set_(level_set_shape.level_set_) {}
+//=================================================================================================//
 void LevelSetShape::writeLevelSet(SPHSystem &sph_system)
 {
     MeshRecordingToPlt write_level_set_to_plt(sph_system, level_set_);
@@ -43,6 +47,12 @@ LevelSetShape *LevelSetShape::correctLevelSetSign(Real small_shift_factor)
     return this;
 }
 //=================================================================================================//
+LevelSetShape *LevelSetShape::prepareKernelIntegralsNearInterface()
+{
+    level_set_.prepareKernelIntegralsNearInterface();
+    return this;
+}
+//=================================================================================================//
 bool LevelSetShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
 {
     return level_set_.probeSignedDistance(probe_point) < 0.0 ? true : false;
@@ -55,6 +65,16 @@ Vecd LevelSetShape::findClosestPoint(const Vecd &probe_point)
     return probe_point - phi * normal;
 }
 //=================================================================================================//
+Real LevelSetShape::findSignedDistance(const Vecd &probe_point)
+{
+    return level_set_.probeSignedDistance(probe_point);
+}
+//=================================================================================================//
+Vecd LevelSetShape::findNormalDirection(const Vecd &probe_point)
+{
+    return level_set_.probeNormalDirection(probe_point);
+}
+//=================================================================================================//
 BoundingBox LevelSetShape::findBounds()
 {
     if (!is_bounds_found_)
@@ -81,4 +101,22 @@ Vecd LevelSetShape::computeKernelGradientIntegral(const Vecd &probe_point, Real
     return level_set_.probeKernelGradientIntegral(probe_point, h_ratio);
 }
 //=================================================================================================//
+void LevelSetShape::probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                        StdLargeVec<Real> &results)
+{
+    level_set_.probeSignedDistance(positions, indices, results);
+}
+//=================================================================================================//
+void LevelSetShape::probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                         StdLargeVec<Vecd> &results)
+{
+    level_set_.probeNormalDirection(positions, indices, results);
+}
+//=================================================================================================//
+void LevelSetShape::probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                                StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios)
+{
+    level_set_.probeKernelGradientIntegral(positions, indices, results, h_ratios);
+}
+//=================================================================================================//
 } // namespace SPH
@@ -56,19 +56,33 @@ class LevelSetShape : public Shape
 
     virtual bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual Real findSignedDistance(const Vecd &probe_point) override;
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override;
 
-    Vecd findLevelSetGradient(const Vecd &probe_point);
-    Real computeKernelIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
-    Vecd computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
+    virtual Vecd findLevelSetGradient(const Vecd &probe_point);
+    virtual Real computeKernelIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
+    virtual Vecd computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
+    /** Batched level set probes at positions[indices[n]], the results are stored with the same indices. */
+    virtual void probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &results);
+    virtual void probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                      StdLargeVec<Vecd> &results);
+    virtual void probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios = nullptr);
     /** small_shift_factor = 1.0 by default, can be increased for difficult geometries for smoothing */
     LevelSetShape *cleanLevelSet(Real small_shift_factor = 1.0);
     /** required to build level set from triangular mesh in stl file format. */
     LevelSetShape *correctLevelSetSign(Real small_shift_factor = 1.0);
+    /** otherwise the kernel integrals are computed when first probed. */
+    LevelSetShape *prepareKernelIntegralsNearInterface();
     void writeLevelSet(SPHSystem &sph_system);
 
   protected:
     BaseLevelSet &level_set_; /**< narrow bounded level set mesh. */
 
+    /** Shares the level set of another level set shape without rebuilding it. */
+    LevelSetShape(const std::string &shape_name, LevelSetShape &level_set_shape);
+
     virtual BoundingBox findBounds() override;
 };
 } // namespace SPH
@@ -57,6 +57,17 @@ class InverseShape : public BaseShapeType
     {
         return !BaseShapeType::checkContain(probe_point);
     };
+
+    /** The generic evaluation from the modified containment and closest point. */
+    virtual Real findSignedDistance(const Vecd &probe_point) override
+    {
+        return Shape::findSignedDistance(probe_point);
+    };
+
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override
+    {
+        return Shape::findNormalDirection(probe_point);
+    };
 };
 
 /**
@@ -102,6 +113,17 @@ class ExtrudeShape : public BaseShapeType
         closest_point += BaseShapeType::checkContain(probe_point) ? shift : -shift;
         return closest_point;
     };
+
+    /** The generic evaluation from the modified containment and closest point. */
+    virtual Real findSignedDistance(const Vecd &probe_point) override
+    {
+        return Shape::findSignedDistance(probe_point);
+    };
+
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override
+    {
+        return Shape::findNormalDirection(probe_point);
+    };
 };
 } // namespace SPH
 
@@ -69,6 +69,18 @@ class TransformShape : public BaseShapeType
         return transform_.shiftFrameStationToBase(closest_point_origin);
     };
 
+    /** The generic evaluation from the transformed closest point and containment,
+     * as a distance field of the base shape is given in the untransformed frame. */
+    virtual Real findSignedDistance(const Vecd &probe_point) override
+    {
+        return Shape::findSignedDistance(probe_point);
+    };
+
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override
+    {
+        return Shape::findNormalDirection(probe_point);
+    };
+
   protected:
     Transform transform_;
 
@@ -0,0 +1,117 @@
+#include "transformed_level_set_shape.h"
+
+namespace SPH
+{
+//=================================================================================================//
+TransformedLevelSetShape::
+    TransformedLevelSetShape(LevelSetShape &level_set_shape, const Transform &transform)
+    : LevelSetShape("Transformed" + level_set_shape.getName(), level_set_shape),
+      level_set_shape_(level_set_shape), transform_(transform) {}
+//=================================================================================================//
+bool TransformedLevelSetShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
+{
+    return level_set_shape_.checkContain(transform_.shiftBaseStationToFrame(probe_point), BOUNDARY_INCLUDED);
+}
+//=================================================================================================//
+Vecd TransformedLevelSetShape::findClosestPoint(const Vecd &probe_point)
+{
+    Vecd closest_point_in_frame = level_set_shape_.findClosestPoint(transform_.shiftBaseStationToFrame(probe_point));
+    return transform_.shiftFrameStationToBase(closest_point_in_frame);
+}
+//=================================================================================================//
+Real TransformedLevelSetShape::findSignedDistance(const Vecd &probe_point)
+{
+    return level_set_shape_.findSignedDistance(transform_.shiftBaseStationToFrame(probe_point));
+}
+//=================================================================================================//
+Vecd TransformedLevelSetShape::findNormalDirection(const Vecd &probe_point)
+{
+    Vecd normal_in_frame = level_set_shape_.findNormalDirection(transform_.shiftBaseStationToFrame(probe_point));
+    return transform_.xformFrameVecToBase(normal_in_frame);
+}
+//=================================================================================================//
+Vecd TransformedLevelSetShape::findLevelSetGradient(const Vecd &probe_point)
+{
+    Vecd gradient_in_frame = level_set_shape_.findLevelSetGradient(transform_.shiftBaseStationToFrame(probe_point));
+    return transform_.xformFrameVecToBase(gradient_in_frame);
+}
+//=================================================================================================//
+Real TransformedLevelSetShape::computeKernelIntegral(const Vecd &probe_point, Real h_ratio)
+{
+    return level_set_shape_.computeKernelIntegral(transform_.shiftBaseStationToFrame(probe_point), h_ratio);
+}
+//=================================================================================================//
+Vecd TransformedLevelSetShape::computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio)
+{
+    Vecd integral_in_frame =
+        level_set_shape_.computeKernelGradientIntegral(transform_.shiftBaseStationToFrame(probe_point), h_ratio);
+    return transform_.xformFrameVecToBase(integral_in_frame);
+}
+//=================================================================================================//
+void TransformedLevelSetShape::transformPositionsToFrame(const StdLargeVec<Vecd> &positions, const IndexVector &indices)
+{
+    frame_positions_.resize(positions.size());
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+                frame_positions_[indices[n]] = transform_.shiftBaseStationToFrame(positions[indices[n]]);
+        },
+        ap);
+}
+//=================================================================================================//
+void TransformedLevelSetShape::transformVectorsToBase(const IndexVector &indices, StdLargeVec<Vecd> &vectors)
+{
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+                vectors[indices[n]] = transform_.xformFrameVecToBase(vectors[indices[n]]);
+        },
+        ap);
+}
+//=================================================================================================//
+void TransformedLevelSetShape::probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                                   StdLargeVec<Real> &results)
+{
+    transformPositionsToFrame(positions, indices);
+    level_set_shape_.probeSignedDistance(frame_positions_, indices, results);
+}
+//=================================================================================================//
+void TransformedLevelSetShape::probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                                    StdLargeVec<Vecd> &results)
+{
+    transformPositionsToFrame(positions, indices);
+    level_set_shape_.probeNormalDirection(frame_positions_, indices, results);
+    transformVectorsToBase(indices, results);
+}
+//=================================================================================================//
+void TransformedLevelSetShape::probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                                           StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios)
+{
+    transformPositionsToFrame(positions, indices);
+    level_set_shape_.probeKernelGradientIntegral(frame_positions_, indices, results, h_ratios);
+    transformVectorsToBase(indices, results);
+}
+//=================================================================================================//
+BoundingBox TransformedLevelSetShape::findBounds()
+{
+    BoundingBox frame_bounds = level_set_shape_.getBounds();
+    Vecd lower_bound = Vecd::Constant(MaxReal);
+    Vecd upper_bound = Vecd::Constant(-MaxReal);
+    for (int corner = 0; corner != (1 << Dimensions); ++corner)
+    {
+        Vecd corner_position = frame_bounds.first_;
+        for (int k = 0; k != Dimensions; ++k)
+            if (corner & (1 << k))
+                corner_position[k] = frame_bounds.second_[k];
+        Vecd corner_in_base = transform_.shiftFrameStationToBase(corner_position);
+        lower_bound = lower_bound.cwiseMin(corner_in_base);
+        upper_bound = upper_bound.cwiseMax(corner_in_base);
+    }
+    return BoundingBox(lower_bound, upper_bound);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,88 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	transformed_level_set_shape.h
+ * @brief 	A level set shape moved by a rigid transform without rebuilding the level set.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef TRANSFORMED_LEVEL_SET_SHAPE_H
+#define TRANSFORMED_LEVEL_SET_SHAPE_H
+
+#include "level_set_shape.h"
+
+namespace SPH
+{
+/**
+ * @class TransformedLevelSetShape
+ * @brief A level set shape in its current position given by a rigid transform.
+ * @details The wrapped level set is built once in the body frame.
+ * Probe points are mapped into the body frame, and vector results
+ * such as gradients and normal directions are rotated back.
+ * Scalar results, e.g. signed distance and kernel integral, are invariant under rigid motion.
+ * The transform maps the body frame, i.e. the frame the level set was built in, to the current position.
+ * As it is a level set shape itself, it can be used wherever a level set shape is expected.
+ * Note that body parts tagged by cells, e.g. NearShapeSurface, are tagged at the construction position.
+ */
+class TransformedLevelSetShape : public LevelSetShape
+{
+  public:
+    explicit TransformedLevelSetShape(LevelSetShape &level_set_shape, const Transform &transform = Transform());
+    virtual ~TransformedLevelSetShape(){};
+
+    Transform &getTransform() { return transform_; };
+    /** The bounds are recomputed on the next request after the transform is changed. */
+    void setTransform(const Transform &transform)
+    {
+        transform_ = transform;
+        is_bounds_found_ = false;
+    };
+    LevelSetShape &getLevelSetShape() { return level_set_shape_; };
+
+    virtual bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) override;
+    virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual Real findSignedDistance(const Vecd &probe_point) override;
+    virtual Vecd findNormalDirection(const Vecd &probe_point) override;
+
+    virtual Vecd findLevelSetGradient(const Vecd &probe_point) override;
+    virtual Real computeKernelIntegral(const Vecd &probe_point, Real h_ratio = 1.0) override;
+    virtual Vecd computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio = 1.0) override;
+    virtual void probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &results) override;
+    virtual void probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                      StdLargeVec<Vecd> &results) override;
+    virtual void probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Vecd> &results, const StdLargeVec<Real> *h_ratios = nullptr) override;
+
+  protected:
+    LevelSetShape &level_set_shape_;
+    Transform transform_;
+    StdLargeVec<Vecd> frame_positions_; /**< probe positions in the body frame for batched probes. */
+
+    /** Bounds of the transformed bounding box of the level set shape. */
+    virtual BoundingBox findBounds() override;
+    void transformPositionsToFrame(const StdLargeVec<Vecd> &positions, const IndexVector &indices);
+    void transformVectorsToBase(const IndexVector &indices, StdLargeVec<Vecd> &vectors);
+};
+} // namespace SPH
+#endif // TRANSFORMED_LEVEL_SET_SHAPE_H
@@ -30,6 +30,7 @@
 
 #include "all_bodies.h"
 #include "all_body_relations.h"
+#include "all_distributed_memory.h"
 #include "all_geometries.h"
 #include "all_kernels.h"
 #include "all_materials.h"
@@ -38,6 +39,7 @@
 #include "all_physical_dynamics.h"
 #include "all_simbody.h"
 #include "io_all.h"
+#include "multi_rate_time_stepping.h"
 #include "parameterization.h"
 #include "all_regression_test_methods.h"
 #include "sph_system.h"
@@ -14,6 +14,29 @@ BaseCellLinkedList::
     : BaseMeshField("CellLinkedList"),
       real_body_(real_body), kernel_(*sph_adaptation.getKernel()) {}
 //=================================================================================================//
+BoundingBox BaseCellLinkedList::insertParticlesAndFindBounds(BaseParticles &base_particles)
+{
+    StdLargeVec<Vecd> &pos_n = base_particles.pos_;
+    size_t total_real_particles = base_particles.total_real_particles_;
+    return parallel_reduce(
+        IndexRange(0, total_real_particles),
+        BoundingBox(MaxReal * Vecd::Ones(), -MaxReal * Vecd::Ones()),
+        [&](const IndexRange &r, BoundingBox bounds) -> BoundingBox
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                insertParticleIndex(i, pos_n[i]);
+                bounds.first_ = bounds.first_.cwiseMin(pos_n[i]);
+                bounds.second_ = bounds.second_.cwiseMax(pos_n[i]);
+            }
+            return bounds;
+        },
+        [](const BoundingBox &x, const BoundingBox &y) -> BoundingBox
+        {
+            return BoundingBox(x.first_.cwiseMin(y.first_), x.second_.cwiseMax(y.second_));
+        });
+}
+//=================================================================================================//
 void BaseCellLinkedList::clearSplitCellLists(SplitCellLists &split_cell_lists)
 {
     for (size_t i = 0; i < split_cell_lists.size(); i++)
@@ -22,7 +45,8 @@ void BaseCellLinkedList::clearSplitCellLists(SplitCellLists &split_cell_lists)
 //=================================================================================================//
 CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
                                RealBody &real_body, SPHAdaptation &sph_adaptation)
-    : BaseCellLinkedList(real_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2)
+    : BaseCellLinkedList(real_body, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2),
+      active_cells_(Arrayi::Zero(), Arrayi::Zero())
 {
     allocateMeshDataMatrix();
     single_cell_linked_list_level_.push_back(this);
@@ -31,19 +55,8 @@ CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
 void CellLinkedList::UpdateCellLists(BaseParticles &base_particles)
 {
     clearCellLists();
-    StdLargeVec<Vecd> &pos_n = base_particles.pos_;
-    size_t total_real_particles = base_particles.total_real_particles_;
-    parallel_for(
-        IndexRange(0, total_real_particles),
-        [&](const IndexRange &r)
-        {
-            for (size_t i = r.begin(); i != r.end(); ++i)
-            {
-                insertParticleIndex(i, pos_n[i]);
-            }
-        },
-        ap);
-
+    particle_bounds_ = insertParticlesAndFindBounds(base_particles);
+    setActiveCells(particle_bounds_);
     UpdateCellListData(base_particles);
 
     if (real_body_.getUseSplitCellLists())
@@ -52,6 +65,28 @@ void CellLinkedList::UpdateCellLists(BaseParticles &base_particles)
     }
 }
 //=================================================================================================//
+void CellLinkedList::setActiveCells(const BoundingBox &particle_bounds)
+{
+    if ((particle_bounds.first_.array() > particle_bounds.second_.array()).any())
+    {
+        active_cells_ = MeshRange(Arrayi::Zero(), Arrayi::Zero()); // no particles
+        return;
+    }
+    active_cells_ = MeshRange((CellIndexFromPosition(particle_bounds.first_) - Arrayi::Ones()).max(Arrayi::Zero()),
+                              (CellIndexFromPosition(particle_bounds.second_) + 2 * Arrayi::Ones()).min(all_cells_));
+}
+//=================================================================================================//
+void CellLinkedList::extendActiveCells(const Arrayi &cell_index)
+{
+    if ((active_cells_.first >= active_cells_.second).any())
+    {
+        active_cells_ = MeshRange(cell_index, cell_index + Arrayi::Ones());
+        return;
+    }
+    active_cells_.first = active_cells_.first.min(cell_index);
+    active_cells_.second = active_cells_.second.max(cell_index + Arrayi::Ones());
+}
+//=================================================================================================//
 StdLargeVec<size_t> &CellLinkedList::computingSequence(BaseParticles &base_particles)
 {
     StdLargeVec<Vecd> &pos = base_particles.pos_;
@@ -102,22 +137,12 @@ void MultilevelCellLinkedList::UpdateCellLists(BaseParticles &base_particles)
     for (size_t level = 0; level != total_levels_; ++level)
         mesh_levels_[level]->clearCellLists();
 
-    StdLargeVec<Vecd> &pos_n = base_particles.pos_;
-    size_t total_real_particles = base_particles.total_real_particles_;
     // rebuild the corresponding particle list.
-    parallel_for(
-        IndexRange(0, total_real_particles),
-        [&](const IndexRange &r)
-        {
-            for (size_t i = r.begin(); i != r.end(); ++i)
-            {
-                insertParticleIndex(i, pos_n[i]);
-            }
-        },
-        ap);
+    particle_bounds_ = insertParticlesAndFindBounds(base_particles);
 
     for (size_t level = 0; level != total_levels_; ++level)
     {
+        mesh_levels_[level]->setActiveCells(particle_bounds_);
         mesh_levels_[level]->UpdateCellListData(base_particles);
     }
 
@@ -33,6 +33,7 @@
 #define MESH_CELL_LINKED_LIST_H
 
 #include "base_mesh.h"
+#include "mesh_iterators.h"
 #include "neighborhood.h"
 
 namespace SPH
@@ -54,7 +55,10 @@ class BaseCellLinkedList : public BaseMeshField
   protected:
     RealBody &real_body_;
     Kernel &kernel_;
+    BoundingBox particle_bounds_; /**< bounds of the real particles from the last update */
 
+    /** insert all real particles and find their bounds by a parallel reduction */
+    BoundingBox insertParticlesAndFindBounds(BaseParticles &base_particles);
     /** clear split cell lists in this mesh*/
     virtual void clearSplitCellLists(SplitCellLists &split_cell_lists);
     /** update split particle list in this mesh */
@@ -68,6 +72,8 @@ class BaseCellLinkedList : public BaseMeshField
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() = 0;
     /** update the cell lists */
     virtual void UpdateCellLists(BaseParticles &base_particles) = 0;
+    /** bounds of the real particles found in the last update of the cell lists */
+    BoundingBox getParticleBounds() { return particle_bounds_; };
     /** Insert a cell-linked_list entry to the concurrent index list. */
     virtual void insertParticleIndex(size_t particle_index, const Vecd &particle_position) = 0;
     /** Insert a cell-linked_list entry of the index and particle position pair. */
@@ -96,19 +102,28 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     MeshDataMatrix<ConcurrentIndexVector> cell_index_lists_;
     /** non-concurrent list data rewritten for building neighbor list */
     MeshDataMatrix<ListDataVector> cell_data_lists_;
+    /** Cells which may hold particles or list data, found from the particle bounds plus one cell margin
+     * and extended by list data entries inserted afterwards, e.g. periodic ghost particles.
+     * Cell list sweeps are restricted to this range, all cells outside are empty. */
+    MeshRange active_cells_;
 
     void allocateMeshDataMatrix(); /**< allocate memories for addresses of data packages. */
     void deleteMeshDataMatrix();   /**< delete memories for addresses of data packages. */
     virtual void updateSplitCellLists(SplitCellLists &split_cell_lists) override;
+    void extendActiveCells(const Arrayi &cell_index);
 
   public:
     CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing, RealBody &real_body, SPHAdaptation &sph_adaptation);
     virtual ~CellLinkedList() { deleteMeshDataMatrix(); };
 
+    /** clear the cell lists within the active cells, which are reset to empty afterwards */
     void clearCellLists();
+    /** set the active cells from the bounds of the particles inserted after clearing */
+    void setActiveCells(const BoundingBox &particle_bounds);
     void UpdateCellListData(BaseParticles &base_particles);
     virtual void UpdateCellLists(BaseParticles &base_particles) override;
     void insertParticleIndex(size_t particle_index, const Vecd &particle_position) override;
+    /** Not thread-safe, as the list data are not concurrent vectors. */
     void InsertListDataEntry(size_t particle_index, const Vecd &particle_position, Real volumetric) override;
     virtual ListData findNearestListDataEntry(const Vecd &position) override;
     virtual StdLargeVec<size_t> &computingSequence(BaseParticles &base_particles) override;
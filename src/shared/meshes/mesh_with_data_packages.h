@@ -32,8 +32,10 @@
 #include "base_mesh.h"
 #include "base_variable.h"
 #include "my_memory_pool.h"
+#include "tbb/parallel_sort.h"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <functional>
 #include <mutex>
@@ -152,6 +154,9 @@ class GridDataPackage : public BaseDataPackage, public BaseMesh
     /** probe by applying bi and tri-linear interpolation within the package. */
     template <typename DataType>
     DataType probeDataPackage(PackageDataAddress<DataType> &pkg_data_addrs, const Vecd &position);
+    /** probe within an inner package, or take the uniform value of a singular package. */
+    template <typename DataType>
+    DataType probePackage(const MeshVariable<DataType> &mesh_variable, const Vecd &position);
     /** assign value to data package according to the position of data */
     template <typename DataType, typename FunctionByPosition>
     void assignByPosition(const MeshVariable<DataType> &mesh_variable,
@@ -222,6 +227,151 @@ class GridDataPackage : public BaseDataPackage, public BaseMesh
     };
 };
 
+/**
+ * @class SparseBlockAddresses
+ * @brief Addresses of the data packages in the cells of a mesh, stored in blocks of block_size^d cells.
+ * @details A block whose cells refer all to the same package, e.g. the singular package
+ * for the inner or outer far field, keeps this address only. Blocks with different packages,
+ * i.e. those around the interface, keep an address for each cell.
+ * Hence, the memory scales with the number of blocks and the extent of the interface,
+ * instead of the number of cells. A lookup is two loads, the block and the address in the block.
+ * Different cells can be assigned concurrently, also while other cells are looked up.
+ * It is used instead of DenseCellAddresses when built with SPHINXSYS_SPARSE_MESH_ADDRESSES.
+ */
+template <class DataPackageType>
+class SparseBlockAddresses
+{
+    static constexpr int block_size_ = 8;
+    static constexpr int block_volume_ = 1 << (3 * Dimensions);
+
+    struct Block
+    {
+        std::atomic<DataPackageType *> uniform_{nullptr};
+        std::atomic<std::atomic<DataPackageType *> *> cells_{nullptr};
+    };
+
+  public:
+    explicit SparseBlockAddresses(const Arrayi &all_cells)
+        : number_of_blocks_((all_cells + (block_size_ - 1) * Arrayi::Ones()) / block_size_),
+          blocks_(number_of_blocks_.prod()){};
+    ~SparseBlockAddresses()
+    {
+        for (Block &block : blocks_)
+            delete[] block.cells_.load();
+    };
+
+    DataPackageType *PackageFromCellIndex(const Arrayi &cell_index) const
+    {
+        const Block &block = blocks_[BlockIndex(cell_index)];
+        std::atomic<DataPackageType *> *cells = block.cells_.load(std::memory_order_acquire);
+        return cells == nullptr ? block.uniform_.load(std::memory_order_acquire)
+                                : cells[LocalIndex(cell_index)].load(std::memory_order_acquire);
+    };
+
+    void assignPackage(const Arrayi &cell_index, DataPackageType *data_pkg)
+    {
+        Block &block = blocks_[BlockIndex(cell_index)];
+        std::atomic<DataPackageType *> *cells = block.cells_.load(std::memory_order_acquire);
+        if (cells == nullptr)
+        {
+            DataPackageType *uniform = nullptr;
+            if (block.uniform_.compare_exchange_strong(uniform, data_pkg, std::memory_order_acq_rel) ||
+                uniform == data_pkg)
+                return;
+            cells = expandBlock(block, uniform);
+        }
+        cells[LocalIndex(cell_index)].store(data_pkg, std::memory_order_release);
+    };
+
+    /** Number of blocks keeping an address for each cell. */
+    size_t NumberOfExpandedBlocks() const
+    {
+        size_t count = 0;
+        for (const Block &block : blocks_)
+            count += block.cells_.load() != nullptr ? 1 : 0;
+        return count;
+    };
+
+  protected:
+    Arrayi number_of_blocks_;
+    StdVec<Block> blocks_;
+
+    size_t BlockIndex(const Arrayi &cell_index) const
+    {
+        size_t index = 0;
+        for (int n = Dimensions - 1; n >= 0; --n)
+            index = index * number_of_blocks_[n] + cell_index[n] / block_size_;
+        return index;
+    };
+
+    size_t LocalIndex(const Arrayi &cell_index) const
+    {
+        size_t index = 0;
+        for (int n = Dimensions - 1; n >= 0; --n)
+            index = index * block_size_ + cell_index[n] % block_size_;
+        return index;
+    };
+
+    /** The cells of the block take the uniform address, if another thread expands it first, its cells are used. */
+    std::atomic<DataPackageType *> *expandBlock(Block &block, DataPackageType *uniform)
+    {
+        std::atomic<DataPackageType *> *new_cells = new std::atomic<DataPackageType *>[block_volume_];
+        for (int i = 0; i != block_volume_; ++i)
+            new_cells[i].store(uniform, std::memory_order_relaxed);
+        std::atomic<DataPackageType *> *expected = nullptr;
+        if (!block.cells_.compare_exchange_strong(expected, new_cells, std::memory_order_acq_rel))
+        {
+            delete[] new_cells;
+            return expected;
+        }
+        return new_cells;
+    };
+};
+
+/**
+ * @class DenseCellAddresses
+ * @brief Addresses of the data packages with one address for each cell of a mesh.
+ * @details Different cells can be assigned concurrently,
+ * but the addresses are looked up only after they are assigned.
+ */
+template <class DataPackageType>
+class DenseCellAddresses
+{
+  public:
+    explicit DenseCellAddresses(const Arrayi &all_cells)
+        : all_cells_(all_cells), addresses_(all_cells.prod(), nullptr){};
+
+    DataPackageType *PackageFromCellIndex(const Arrayi &cell_index) const
+    {
+        return addresses_[LinearIndex(cell_index)];
+    };
+
+    void assignPackage(const Arrayi &cell_index, DataPackageType *data_pkg)
+    {
+        addresses_[LinearIndex(cell_index)] = data_pkg;
+    };
+
+  protected:
+    Arrayi all_cells_;
+    StdVec<DataPackageType *> addresses_;
+
+    size_t LinearIndex(const Arrayi &cell_index) const
+    {
+        size_t index = 0;
+        for (int n = Dimensions - 1; n >= 0; --n)
+            index = index * all_cells_[n] + cell_index[n];
+        return index;
+    };
+};
+
+#if SPHINXSYS_SPARSE_MESH_ADDRESSES
+template <class DataPackageType>
+using CellAddresses = SparseBlockAddresses<DataPackageType>;
+#else
+template <class DataPackageType>
+using CellAddresses = DenseCellAddresses<DataPackageType>;
+#endif
+
 /**
  * @class MeshWithGridDataPackages
  * @brief Abstract class for mesh with grid-based data packages.
@@ -249,18 +399,15 @@ class MeshWithGridDataPackages : public Mesh
     explicit MeshWithGridDataPackages(BoundingBox tentative_bounds, Real data_spacing, size_t buffer_size)
         : Mesh(tentative_bounds, GridDataPackageType::pkg_size * data_spacing, buffer_size),
           data_spacing_(data_spacing),
-          global_mesh_(this->mesh_lower_bound_ + 0.5 * data_spacing * Vecd::Ones(), data_spacing, this->all_cells_ * pkg_size)
-    {
-        allocateMeshDataMatrix();
-    };
-    virtual ~MeshWithGridDataPackages() { deleteMeshDataMatrix(); };
+          data_pkg_addrs_(this->all_cells_),
+          global_mesh_(this->mesh_lower_bound_ + 0.5 * data_spacing * Vecd::Ones(), data_spacing, this->all_cells_ * pkg_size){};
+    virtual ~MeshWithGridDataPackages(){};
     /** spacing between the data, which is 1/ pkg_size of this grid spacing */
     virtual Real DataSpacing() override { return data_spacing_; };
 
   protected:
     MeshVariableAssemble all_mesh_variables_;              /**< all mesh variables on this mesh. */
     MyMemoryPool<GridDataPackageType> data_pkg_pool_;      /**< memory pool for all packages in the mesh. */
-    MeshDataMatrix<GridDataPackageType *> data_pkg_addrs_; /**< Address of data packages. */
     ConcurrentVec<GridDataPackageType *> inner_data_pkgs_; /**< Inner data packages which is able to carry out spatial operations. */
     /** Singular data packages. provided for far field condition with usually only two values.
      * For example, when level set is considered. The first value for inner far-field and second for outer far-field */
@@ -270,22 +417,26 @@ class MeshWithGridDataPackages : public Mesh
     static constexpr int pkg_ops_end = GridDataPackageType::pkg_ops_end;           /**< the size of operation loops. */
     static constexpr int pkg_addrs_size = GridDataPackageType::pkg_addrs_size;     /**< the size of address matrix in the data packages. */
     const Real data_spacing_;                                                      /**< spacing of data in the data packages*/
-    std::mutex mutex_my_pool;                                                      /**< mutex exclusion for memory pool */
+    CellAddresses<GridDataPackageType> data_pkg_addrs_;                            /**< Address of data packages. */
     BaseMesh global_mesh_;                                                         /**< the mesh for the locations of all possible data points. */
 
-    void allocateMeshDataMatrix(); /**< allocate memories for addresses of data packages. */
-    void deleteMeshDataMatrix();   /**< delete memories for addresses of data packages. */
-
     template <typename DataType>
     MeshVariable<DataType> *registerMeshVariable(const std::string &variable_name)
+    {
+        return registerMeshVariable<DataType>(all_mesh_variables_, variable_name);
+    };
+    /** Variables registered to another assemble are not allocated with the data packages,
+     * but only in the packages allocated with this assemble. */
+    template <typename DataType>
+    MeshVariable<DataType> *registerMeshVariable(MeshVariableAssemble &mesh_variables, const std::string &variable_name)
     {
         MeshVariable<DataType> *variable =
-            findVariableByName<DataType>(all_mesh_variables_, variable_name);
+            findVariableByName<DataType>(mesh_variables, variable_name);
         if (variable == nullptr)
         {
             constexpr int type_index = DataTypeIndex<DataType>::value;
-            size_t new_variable_index = std::get<type_index>(all_mesh_variables_).size();
-            return addVariableToAssemble<DataType>(all_mesh_variables_, mesh_variable_ptrs_,
+            size_t new_variable_index = std::get<type_index>(mesh_variables).size();
+            return addVariableToAssemble<DataType>(mesh_variables, mesh_variable_ptrs_,
                                                    variable_name, new_variable_index);
         }
         return variable;
@@ -309,11 +460,9 @@ class MeshWithGridDataPackages : public Mesh
         const Arrayi &cell_index,
         const InitializePackageData &initialize_package_data)
     {
-        mutex_my_pool.lock();
         Vecd cell_position = CellPositionFromIndex(cell_index);
         Vecd grid_position = GridPositionFromCellPosition(cell_position);
         GridDataPackageType *new_data_pkg = data_pkg_pool_.malloc(grid_position, data_spacing_);
-        mutex_my_pool.unlock();
         new_data_pkg->allocateAllVariables(all_mesh_variables_);
         initialize_package_data(new_data_pkg);
         new_data_pkg->setCellIndexOnMesh(cell_index);
@@ -321,6 +470,17 @@ class MeshWithGridDataPackages : public Mesh
         return new_data_pkg;
     };
 
+    /** Order the inner packages, collected concurrently, by their cell index,
+     * so that package sweeps are reproducible and follow the spatial order of the mesh. */
+    void sortInnerDataPackages()
+    {
+        tbb::parallel_sort(inner_data_pkgs_.begin(), inner_data_pkgs_.end(),
+                           [&](GridDataPackageType *a, GridDataPackageType *b)
+                           {
+                               return transferMeshIndexTo1D(all_cells_, a->CellIndexOnMesh()) <
+                                      transferMeshIndexTo1D(all_cells_, b->CellIndexOnMesh());
+                           });
+    };
     void assignDataPackageAddress(const Arrayi &cell_index, GridDataPackageType *data_pkg);
     /** Return data package with given cell index. */
     GridDataPackageType *DataPackageFromCellIndex(const Arrayi &cell_index);
@@ -337,6 +497,38 @@ class MeshWithGridDataPackages : public Mesh
     /** This function probe a mesh value */
     template <class DataType>
     DataType probeMesh(const MeshVariable<DataType> &mesh_variable, const Vecd &position);
+    /** Batched probe at positions[indices[n]], the results are stored with the same indices.
+     * Consecutive probes within the same cell share the package lookup,
+     * which is the common case for particles sorted by cells. */
+    template <class DataType>
+    void probeMesh(const MeshVariable<DataType> &mesh_variable, const StdLargeVec<Vecd> &positions,
+                   const IndexVector &indices, StdLargeVec<DataType> &results)
+    {
+        parallel_for(
+            IndexRange(0, indices.size()),
+            [&](const IndexRange &r)
+            {
+                Arrayi current_cell = -Arrayi::Ones();
+                GridDataPackageType *data_pkg = nullptr;
+                typename GridDataPackageType::template PackageDataAddress<DataType> *pkg_data_addrs = nullptr;
+                for (size_t n = r.begin(); n != r.end(); ++n)
+                {
+                    size_t index_i = indices[n];
+                    Arrayi cell_index = CellIndexFromPosition(positions[index_i]);
+                    if ((cell_index != current_cell).any())
+                    {
+                        current_cell = cell_index;
+                        data_pkg = DataPackageFromCellIndex(cell_index);
+                        pkg_data_addrs = &data_pkg->getPackageDataAddress(mesh_variable);
+                    }
+                    results[index_i] = data_pkg->isInnerPackage()
+                                           ? data_pkg->GridDataPackageType::template probeDataPackage<DataType>(
+                                                 *pkg_data_addrs, positions[index_i])
+                                           : probeMesh(mesh_variable, positions[index_i]);
+                }
+            },
+            ap);
+    };
     /** This function find the value of data from its index from global mesh. */
     template <typename DataType>
     DataType DataValueFromGlobalIndex(const MeshVariable<DataType> &mesh_variable,
@@ -22,82 +22,101 @@
  * ------------------------------------------------------------------------- */
 /**
  * @file 	my_memory_pool.h
- * @brief 	A class template for scalable memory allocation from memory blocks provided by an underlying allocator.
- * @details A memory_pool allocates and frees memory in a way that scales with the number of processors.
- *			The memory is obtained as big chunks from an underlying allocator specified by the template argument.
- *			The latter must satisfy the subset of the allocator requirements from the [allocator.requirements] ISO C++ Standard section.
- *			A memory_pool meet the Memory Pool named requirement.
+ * @brief 	A class template for scalable, lock-free allocation of objects from per-thread slabs.
+ * @details Each thread constructs its objects in its own slabs, i.e. contiguous blocks of slab_size objects,
+ *			so that concurrent allocations never contend and objects created by one thread
+ *			in a parallel sweep are adjacent in memory.
+ *			Object addresses are stable during the lifetime of the pool.
  * @author	Chi Zhang and Xiangyu Hu
  */
 
 #ifndef MY_MEMORY_POOL_H
 #define MY_MEMORY_POOL_H
 
-#define TBB_PREVIEW_MEMORY_POOL 1
-
 #include "tbb/enumerable_thread_specific.h"
-#include "tbb/memory_pool.h"
 
-#include <list>
+#include <memory>
+#include <new>
+#include <vector>
 
 /**
  * @class MyMemoryPool
  * @brief Note that the data package T should has a default constructor.
+ * @details Allocation and release are thread safe without locking,
+ * as each thread only touches its own slabs and free list.
+ * An object released by one thread may be reused by the same thread only.
  */
 template <class T>
 class MyMemoryPool
 {
+    static constexpr size_t slab_size = 64; /**< number of objects in one slab. */
 
-#ifdef __EMSCRIPTEN__
-    std::allocator<T> my_pool; /**< memory pool. */
-    std::list<T> data_list;    /**< list of all nodes allocated. */
-#else
-    tbb::memory_pool<std::allocator<T>> my_pool;            /**< memory pool. */
-    typedef tbb::memory_pool_allocator<T> pool_allocator_t; /**< memory allocator. */
-    std::list<T, pool_allocator_t> data_list;               /**< list of all nodes allocated. */
-#endif
-    std::list<T *> free_list; /**< list of all free nodes. */
-
-  public:
-#ifdef __EMSCRIPTEN__
-    MyMemoryPool() : data_list(my_pool){};
-#else
-    MyMemoryPool() : data_list(pool_allocator_t(my_pool)){};
-#endif
+    struct LocalSlabs
+    {
+        std::vector<std::unique_ptr<T, void (*)(T *)>> slabs; /**< contiguous storage of slab_size objects each. */
+        size_t used_in_last_slab = slab_size;                 /**< constructed objects in the last slab. */
+        std::vector<T *> free_list;                           /**< released objects for reuse. */
 
-    ~MyMemoryPool(){
-        // my_pool.recycle();
+        size_t constructedObjects() { return slabs.empty() ? 0 : (slabs.size() - 1) * slab_size + used_in_last_slab; };
+        ~LocalSlabs()
+        {
+            for (size_t n = 0; n != slabs.size(); ++n)
+            {
+                size_t used = n + 1 == slabs.size() ? used_in_last_slab : slab_size;
+                for (size_t i = 0; i != used; ++i)
+                    slabs[n].get()[i].~T();
+            }
+        };
     };
+    tbb::enumerable_thread_specific<LocalSlabs> local_slabs_;
+
+    static void releaseSlab(T *slab) { ::operator delete(slab, std::align_val_t(alignof(T))); };
+
+  public:
+    MyMemoryPool(){};
+    ~MyMemoryPool(){};
     /**  Prepare an available node. */
     template <typename... Args>
     T *malloc(Args &&...args)
     {
-        if (free_list.empty())
+        LocalSlabs &local = local_slabs_.local();
+        if (!local.free_list.empty())
         {
-            data_list.emplace_back(std::forward<Args>(args)...);
-            return (&data_list.back());
+            T *result = local.free_list.back();
+            local.free_list.pop_back();
+            return result;
         }
-        else
+
+        if (local.used_in_last_slab == slab_size)
         {
-            T *result = free_list.front();
-            free_list.pop_front();
-            return result;
+            T *slab = static_cast<T *>(::operator new(slab_size * sizeof(T), std::align_val_t(alignof(T))));
+            local.slabs.emplace_back(slab, &releaseSlab);
+            local.used_in_last_slab = 0;
         }
+        T *result = new (local.slabs.back().get() + local.used_in_last_slab) T(std::forward<Args>(args)...);
+        local.used_in_last_slab++;
+        return result;
     };
     /** Relinquish an unused node. */
     void free(T *ptr)
     {
-        free_list.push_back(ptr);
+        local_slabs_.local().free_list.push_back(ptr);
     };
-    /** Return the total number of nodes allocated. */
+    /** Return the total number of nodes allocated. Not to be called concurrently with allocation. */
     int capacity()
     {
-        return data_list.size();
+        size_t total = 0;
+        for (LocalSlabs &local : local_slabs_)
+            total += local.constructedObjects();
+        return total;
     };
-    /** Return the number of current available nodes. */
+    /** Return the number of current available nodes. Not to be called concurrently with allocation. */
     int available_node()
     {
-        return free_list.size();
+        size_t total = 0;
+        for (LocalSlabs &local : local_slabs_)
+            total += local.free_list.size();
+        return total;
     };
 };
 
@@ -65,7 +65,8 @@ class BaseLocalDynamics
     virtual ~BaseLocalDynamics(){};
     SPHBody &getSPHBody() { return sph_body_; };
     DynamicsIdentifier &getDynamicsIdentifier() { return identifier_; };
-    virtual void setupDynamics(Real dt = 0.0){}; // setup global parameters
+    virtual void setupDynamics(Real dt = 0.0){};  // setup global parameters
+    virtual void finishDynamics(Real dt = 0.0){}; // commit global changes after the particle loop
   protected:
     DynamicsIdentifier &identifier_;
     SPHBody &sph_body_ = identifier_.getSPHBody();
@@ -34,6 +34,7 @@
 #include "all_body_relations.h"
 #include "base_body.h"
 #include "base_data_package.h"
+#include "loop_partitioner.h"
 #include "neighborhood.h"
 #include "sph_data_containers.h"
 
@@ -70,6 +71,8 @@ class BaseDynamics : public GlobalStaticVariables
     BaseDynamics(SPHBody &sph_body)
         : sph_body_(sph_body), is_newly_updated_(false){};
     virtual ~BaseDynamics(){};
+    /** not named getSPHBody, which is also a function of the local dynamics the dynamics derive from. */
+    SPHBody &DynamicsBody() { return sph_body_; };
     bool checkNewlyUpdated() { return is_newly_updated_; };
     void setNotNewlyUpdated() { is_newly_updated_ = false; };
 
@@ -82,6 +85,10 @@ class BaseDynamics : public GlobalStaticVariables
     /** There is the interface functions for computing. */
     virtual ReturnType exec(Real dt = 0.0) = 0;
 
+  protected:
+    /** Partitioner of the main particle loop, tuned for this dynamics only. */
+    LoopPartitioner loop_partitioner_;
+
   private:
     SPHBody &sph_body_;
     bool is_newly_updated_;
@@ -133,13 +140,30 @@ class DataDelegateInner : public BaseDataDelegateType
     explicit DataDelegateInner(BaseInnerRelation &inner_relation)
         : BaseDataDelegateType(inner_relation.getSPHBody()),
           inner_relation_(inner_relation),
-          inner_configuration_(inner_relation.inner_configuration_){};
+          inner_configuration_(inner_relation.inner_configuration_),
+          inner_plan_(inner_relation.inner_plan_),
+          single_precision_inner_plan_(inner_relation.single_precision_inner_plan_){};
     virtual ~DataDelegateInner(){};
     BaseInnerRelation &getBodyRelation() { return inner_relation_; };
 
   protected:
     /** inner configuration of the designated body */
     ParticleConfiguration &inner_configuration_;
+    /** compiled inner configuration, only used once the topology is frozen */
+    InnerInteractionPlan<Real> &inner_plan_;
+    InnerInteractionPlan<SingleReal> &single_precision_inner_plan_;
+
+    /** Apply a function, generic in the neighborhood type, to the inner neighbors of a particle,
+     * taken from the plan if the topology is frozen. */
+    template <typename FunctionOnNeighborhood>
+    auto onInnerNeighborhood(size_t index_i, const FunctionOnNeighborhood &function)
+    {
+        if (inner_plan_.isCompiled())
+            return function(inner_plan_[index_i]);
+        if (single_precision_inner_plan_.isCompiled())
+            return function(single_precision_inner_plan_[index_i]);
+        return function(inner_configuration_[index_i]);
+    };
 };
 
 /**
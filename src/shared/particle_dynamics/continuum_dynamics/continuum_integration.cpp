@@ -90,6 +90,7 @@ void StressDiffusion::interaction(size_t index_i, Real dt)
     Real density = plastic_continuum_.getDensity();
     Mat3d diffusion_stress_rate_ = Mat3d::Zero();
     Mat3d diffusion_stress_ = Mat3d::Zero();
+    Real smoothing_length_i = smoothing_length_ / sph_body_.sph_adaptation_->SmoothingLengthRatio(index_i);
     Neighborhood &inner_neighborhood = inner_configuration_[index_i];
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
     {
@@ -101,8 +102,8 @@ void StressDiffusion::interaction(size_t index_i, Real dt)
         diffusion_stress_(0, 0) -= (1 - sin(fai_)) * density * gravity * y_ij;
         diffusion_stress_(1, 1) -= density * gravity * y_ij;
         diffusion_stress_(2, 2) -= (1 - sin(fai_)) * density * gravity * y_ij;
-        diffusion_stress_rate_ += 2 * zeta_ * smoothing_length_ * sound_speed_ *
-                                  diffusion_stress_ * r_ij * dW_ijV_j / (r_ij * r_ij + 0.01 * smoothing_length_);
+        diffusion_stress_rate_ += 2 * zeta_ * smoothing_length_i * sound_speed_ *
+                                  diffusion_stress_ * r_ij * dW_ijV_j / (r_ij * r_ij + 0.01 * smoothing_length_i);
     }
     stress_rate_3D_[index_i] = diffusion_stress_rate_;
 }
@@ -0,0 +1,120 @@
+#include "continuum_refinement.h"
+namespace SPH
+{
+//=================================================================================================//
+namespace continuum_dynamics
+{
+//=================================================================================================//
+PlasticSplitWithMinimumDensityErrorInner::
+    PlasticSplitWithMinimumDensityErrorInner(BaseInnerRelation &inner_relation, Shape &refinement_region,
+                                             size_t body_buffer_width, Real split_strain_rate)
+    : SplitWithMinimumDensityErrorInner(inner_relation, refinement_region, body_buffer_width),
+      plastic_particles_(DynamicCast<PlasticContinuumParticles>(this, *particles_)),
+      strain_rate_3D_(plastic_particles_.strain_rate_3D_), split_strain_rate_(split_strain_rate) {}
+//=================================================================================================//
+bool PlasticSplitWithMinimumDensityErrorInner::splitCriteria(size_t index_i)
+{
+    Real non_deformed_volume = mass_[index_i] * inv_rho0_;
+    if (!particle_adaptation_.isSplitAllowed(non_deformed_volume))
+        return false;
+
+    bool is_plastic_active = plastic_particles_.getDeviatoricPlasticStrain(strain_rate_3D_[index_i]) > split_strain_rate_;
+    return is_plastic_active || checkLocation(refinement_region_bounds_, pos_[index_i], non_deformed_volume);
+}
+//=================================================================================================//
+void PlasticSplitWithMinimumDensityErrorInner::
+    updateNewlySplittingParticle(size_t index_center, size_t index_new, Vecd pos_split)
+{
+    SplitWithMinimumDensityErrorInner::updateNewlySplittingParticle(index_center, index_new, pos_split);
+    /** The density is copied from the parent particle, which may be compacted or dilated. */
+    Vol_[index_new] = mass_[index_new] / rho_[index_new];
+}
+//=================================================================================================//
+PlasticMergeWithMinimumDensityErrorInner::
+    PlasticMergeWithMinimumDensityErrorInner(BaseInnerRelation &inner_relation, Shape &refinement_region,
+                                             Real merge_strain_rate)
+    : MergeWithMinimumDensityErrorInner(inner_relation, refinement_region),
+      plastic_particles_(DynamicCast<PlasticContinuumParticles>(this, *particles_)),
+      plastic_continuum_(plastic_particles_.plastic_continuum_),
+      stress_tensor_3D_(plastic_particles_.stress_tensor_3D_), strain_tensor_3D_(plastic_particles_.strain_tensor_3D_),
+      strain_rate_3D_(plastic_particles_.strain_rate_3D_),
+      elastic_strain_tensor_3D_(plastic_particles_.elastic_strain_tensor_3D_),
+      acc_deviatoric_plastic_strain_(plastic_particles_.acc_deviatoric_plastic_strain_),
+      vertical_stress_(plastic_particles_.vertical_stress_),
+      G_(plastic_continuum_.getShearModulus(plastic_continuum_.getYoungsModulus(), plastic_continuum_.getPoissonRatio())),
+      K_(plastic_continuum_.getBulkModulus(plastic_continuum_.getYoungsModulus(), plastic_continuum_.getPoissonRatio())),
+      merge_strain_rate_(merge_strain_rate) {}
+//=================================================================================================//
+bool PlasticMergeWithMinimumDensityErrorInner::mergeCriteria(size_t index_i, StdVec<size_t> &merge_indices)
+{
+    if (plastic_particles_.getDeviatoricPlasticStrain(strain_rate_3D_[index_i]) > merge_strain_rate_)
+        return false;
+
+    /** The merged state is assembled in the first buffer particle, which must exist. */
+    if (particles_->total_real_particles_ >= particles_->real_particles_bound_)
+        return false;
+
+    if (!MergeWithMinimumDensityErrorInner::mergeCriteria(index_i, merge_indices))
+        return false;
+
+    /** The neighbor lists are not updated during merging. A neighbor beyond the real particles
+     * has been deleted and its data moved, merging it again would create mass and momentum. */
+    for (size_t k = 0; k != merge_indices.size(); ++k)
+    {
+        if (merge_indices[k] >= particles_->total_real_particles_)
+            return false;
+        if (plastic_particles_.getDeviatoricPlasticStrain(strain_rate_3D_[merge_indices[k]]) > merge_strain_rate_)
+            return false;
+    }
+    return true;
+}
+//=================================================================================================//
+void PlasticMergeWithMinimumDensityErrorInner::mergingModel(const StdVec<size_t> &merge_indices)
+{
+    StdVec<size_t> new_indices; // the first and third particles
+    new_indices.push_back(merge_indices[0]);
+    new_indices.push_back(merge_indices[merge_indices.size() - 1]);
+
+    size_t temporary_index = particles_->total_real_particles_; // the first buffer particle as temporary
+    updateMergedParticleInformation(temporary_index, merge_indices);
+    Vecd pos_merging = getMergingPosition(new_indices, merge_indices);
+    updateNewlyMergingParticle(temporary_index, new_indices, pos_merging);
+
+    // the follow for deleting the second particle
+    particles_->copyFromAnotherParticle(merge_indices[1], particles_->total_real_particles_ - 1);
+    particles_->total_real_particles_ -= 1;
+}
+//=================================================================================================//
+void PlasticMergeWithMinimumDensityErrorInner::
+    updateMergedParticleInformation(size_t merged_index, const StdVec<size_t> &merge_indices)
+{
+    MergeWithMinimumDensityErrorInner::updateMergedParticleInformation(merged_index, merge_indices);
+    Vol_[merged_index] = mass_[merged_index] / rho_[merged_index];
+    /** The Drucker-Prager admissible stress set is convex,
+     * hence the return mapping only removes round-off errors of the averaging. */
+    Mat3d stress_tensor = plastic_continuum_.ReturnMapping(stress_tensor_3D_[merged_index]);
+    stress_tensor_3D_[merged_index] = stress_tensor;
+    vertical_stress_[merged_index] = stress_tensor(1, 1);
+    /** The accumulated deviatoric plastic strain is not linear in the strain tensors, it is recomputed. */
+    Mat3d deviatoric_stress = stress_tensor - (1.0 / 3.0) * stress_tensor.trace() * Mat3d::Identity();
+    Real hydrostatic_pressure = (1.0 / 3.0) * stress_tensor.trace();
+    elastic_strain_tensor_3D_[merged_index] = deviatoric_stress / (2.0 * G_) +
+                                              hydrostatic_pressure * Mat3d::Identity() / (9.0 * K_);
+    Mat3d plastic_strain_tensor_3D = strain_tensor_3D_[merged_index] - elastic_strain_tensor_3D_[merged_index];
+    acc_deviatoric_plastic_strain_[merged_index] = plastic_particles_.getDeviatoricPlasticStrain(plastic_strain_tensor_3D);
+}
+//=================================================================================================//
+void PlasticMergeWithMinimumDensityErrorInner::
+    updateNewlyMergingParticle(size_t index_center, const StdVec<size_t> &new_indices, Vecd pos_split)
+{
+    /** Both new particles take the merged state so that mass, momentum and stress integrals are conserved. */
+    for (size_t n = 0; n != new_indices.size(); ++n)
+        particles_->copyFromAnotherParticle(new_indices[n], index_center);
+
+    MergeWithMinimumDensityErrorInner::updateNewlyMergingParticle(index_center, new_indices, pos_split);
+    for (size_t n = 0; n != new_indices.size(); ++n)
+        Vol_[new_indices[n]] = mass_[new_indices[n]] / rho_[new_indices[n]];
+}
+//=================================================================================================//
+} // namespace continuum_dynamics
+} // namespace SPH
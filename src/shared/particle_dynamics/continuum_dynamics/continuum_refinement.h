@@ -0,0 +1,93 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	continuum_refinement.h
+ * @brief 	Particle splitting and merging for plastic continuum bodies.
+ * @details The refinement is driven by the plastic activity, i.e. the equivalent deviatoric strain rate,
+ * 			so that particles are fine near the failure surface and the flow front
+ * 			and coarse in the deposit and the far source region.
+ * 			Stress and strain tensors are intensive quantities. Splitting copies them
+ * 			and merging averages them weighted by mass, so that their mass integrals are conserved.
+ * 			The body should use ParticleSplitAndMerge adaptation with AdaptiveInnerRelation,
+ * 			through which the plastic integration sees the variable smoothing length.
+ * @author	Shuaihao Zhang and Xiangyu Hu
+ */
+#ifndef CONTINUUM_REFINEMENT_H
+#define CONTINUUM_REFINEMENT_H
+
+#include "continuum_particles.h"
+#include "general_refinement.h"
+namespace SPH
+{
+namespace continuum_dynamics
+{
+/**
+ * @class PlasticSplitWithMinimumDensityErrorInner
+ * @brief Split particles inside the refinement region or with plastic activity above the split threshold.
+ */
+class PlasticSplitWithMinimumDensityErrorInner : public SplitWithMinimumDensityErrorInner
+{
+  public:
+    PlasticSplitWithMinimumDensityErrorInner(BaseInnerRelation &inner_relation, Shape &refinement_region,
+                                             size_t body_buffer_width, Real split_strain_rate);
+    virtual ~PlasticSplitWithMinimumDensityErrorInner(){};
+
+  protected:
+    PlasticContinuumParticles &plastic_particles_;
+    StdLargeVec<Mat3d> &strain_rate_3D_;
+    Real split_strain_rate_; /**< equivalent deviatoric strain rate above which particles are split */
+
+    virtual bool splitCriteria(size_t index_i) override;
+    virtual void updateNewlySplittingParticle(size_t index_center, size_t index_new, Vecd pos_split) override;
+};
+
+/**
+ * @class PlasticMergeWithMinimumDensityErrorInner
+ * @brief Merge particles outside the refinement region whose plastic activity is below the merge threshold.
+ * @details Unlike the fluid version, the merged values are given to both new particles
+ * and the kinetic energy is not restored, as the plastic flow is dissipative.
+ * The merge threshold should be lower than the split threshold to avoid repeated split and merge.
+ */
+class PlasticMergeWithMinimumDensityErrorInner : public MergeWithMinimumDensityErrorInner
+{
+  public:
+    PlasticMergeWithMinimumDensityErrorInner(BaseInnerRelation &inner_relation, Shape &refinement_region,
+                                             Real merge_strain_rate);
+    virtual ~PlasticMergeWithMinimumDensityErrorInner(){};
+
+  protected:
+    PlasticContinuumParticles &plastic_particles_;
+    PlasticContinuum &plastic_continuum_;
+    StdLargeVec<Mat3d> &stress_tensor_3D_, &strain_tensor_3D_, &strain_rate_3D_, &elastic_strain_tensor_3D_;
+    StdLargeVec<Real> &acc_deviatoric_plastic_strain_, &vertical_stress_;
+    Real G_, K_;
+    Real merge_strain_rate_; /**< equivalent deviatoric strain rate below which particles are merged */
+
+    virtual bool mergeCriteria(size_t index_i, StdVec<size_t> &merge_indices) override;
+    virtual void mergingModel(const StdVec<size_t> &merge_indices) override;
+    virtual void updateMergedParticleInformation(size_t merged_index, const StdVec<size_t> &merge_indices) override;
+    virtual void updateNewlyMergingParticle(size_t index_center, const StdVec<size_t> &new_indices, Vecd pos_split) override;
+};
+} // namespace continuum_dynamics
+} // namespace SPH
+#endif // CONTINUUM_REFINEMENT_H
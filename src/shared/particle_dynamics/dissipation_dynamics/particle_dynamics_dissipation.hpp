@@ -23,18 +23,21 @@ DampingBySplittingInner<VariableType>::computeErrorAndParameters(size_t index_i,
     Real mass_i = mass_[index_i];
     VariableType &variable_i = variable_[index_i];
     ErrorAndParameters<VariableType> error_and_parameters;
-    Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-    {
-        size_t index_j = inner_neighborhood.j_[n];
-        // linear projection
-        VariableType variable_derivative = (variable_i - variable_[index_j]);
-        Real parameter_b = 2.0 * eta_ * inner_neighborhood.dW_ijV_j_[n] * Vol_i * dt / inner_neighborhood.r_ij_[n];
-
-        error_and_parameters.error_ -= variable_derivative * parameter_b;
-        error_and_parameters.a_ += parameter_b;
-        error_and_parameters.c_ += parameter_b * parameter_b;
-    }
+    onInnerNeighborhood(
+        index_i, [&](const auto &inner_neighborhood)
+        {
+            for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            {
+                size_t index_j = inner_neighborhood.j_[n];
+                // linear projection
+                VariableType variable_derivative = (variable_i - variable_[index_j]);
+                Real parameter_b = 2.0 * eta_ * inner_neighborhood.dW_ijV_j_[n] * Vol_i * dt / inner_neighborhood.r_ij_[n];
+
+                error_and_parameters.error_ -= variable_derivative * parameter_b;
+                error_and_parameters.a_ += parameter_b;
+                error_and_parameters.c_ += parameter_b * parameter_b;
+            }
+        });
     error_and_parameters.a_ -= mass_i;
     return error_and_parameters;
 }
@@ -49,20 +52,23 @@ void DampingBySplittingInner<VariableType>::
 
     Real Vol_i = Vol_[index_i];
     VariableType &variable_i = variable_[index_i];
-    Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-    {
-        size_t index_j = inner_neighborhood.j_[n];
+    onInnerNeighborhood(
+        index_i, [&](const auto &inner_neighborhood)
+        {
+            for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            {
+                size_t index_j = inner_neighborhood.j_[n];
 
-        Real parameter_b = 2.0 * eta_ * inner_neighborhood.dW_ijV_j_[n] * Vol_i * dt / inner_neighborhood.r_ij_[n];
+                Real parameter_b = 2.0 * eta_ * inner_neighborhood.dW_ijV_j_[n] * Vol_i * dt / inner_neighborhood.r_ij_[n];
 
-        // predicted quantity at particle j
-        VariableType variable_j = variable_[index_j] - parameter_k * parameter_b;
-        VariableType variable_derivative = (variable_i - variable_j);
+                // predicted quantity at particle j
+                VariableType variable_j = variable_[index_j] - parameter_k * parameter_b;
+                VariableType variable_derivative = (variable_i - variable_j);
 
-        // exchange in conservation form
-        variable_[index_j] -= variable_derivative * parameter_b / mass_[index_j];
-    }
+                // exchange in conservation form
+                variable_[index_j] -= variable_derivative * parameter_b / mass_[index_j];
+            }
+        });
 }
 //=================================================================================================//
 template <typename VariableType>
@@ -217,33 +223,36 @@ void DampingPairwiseInner<VariableType>::
     VariableType &variable_i = variable_[index_i];
 
     std::array<Real, MaximumNeighborhoodSize> parameter_b;
-    Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    // forward sweep
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-    {
-        size_t index_j = inner_neighborhood.j_[n];
-        Real mass_j = mass_[index_j];
-
-        VariableType variable_derivative = (variable_i - variable_[index_j]);
-        parameter_b[n] = eta_ * inner_neighborhood.dW_ijV_j_[n] * Vol_i * dt / inner_neighborhood.r_ij_[n];
-
-        VariableType increment = parameter_b[n] * variable_derivative / (mass_i * mass_j - parameter_b[n] * (mass_i + mass_j));
-        variable_[index_i] += increment * mass_j;
-        variable_[index_j] -= increment * mass_i;
-    }
-
-    // backward sweep
-    for (size_t n = inner_neighborhood.current_size_; n != 0; --n)
-    {
-        size_t index_j = inner_neighborhood.j_[n - 1];
-        Real mass_j = mass_[index_j];
-
-        VariableType variable_derivative = (variable_i - variable_[index_j]);
-        VariableType increment = parameter_b[n - 1] * variable_derivative / (mass_i * mass_j - parameter_b[n - 1] * (mass_i + mass_j));
-
-        variable_[index_i] += increment * mass_j;
-        variable_[index_j] -= increment * mass_i;
-    }
+    onInnerNeighborhood(
+        index_i, [&](const auto &inner_neighborhood)
+        {
+            // forward sweep
+            for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            {
+                size_t index_j = inner_neighborhood.j_[n];
+                Real mass_j = mass_[index_j];
+
+                VariableType variable_derivative = (variable_i - variable_[index_j]);
+                parameter_b[n] = eta_ * inner_neighborhood.dW_ijV_j_[n] * Vol_i * dt / inner_neighborhood.r_ij_[n];
+
+                VariableType increment = parameter_b[n] * variable_derivative / (mass_i * mass_j - parameter_b[n] * (mass_i + mass_j));
+                variable_[index_i] += increment * mass_j;
+                variable_[index_j] -= increment * mass_i;
+            }
+
+            // backward sweep
+            for (size_t n = inner_neighborhood.current_size_; n != 0; --n)
+            {
+                size_t index_j = inner_neighborhood.j_[n - 1];
+                Real mass_j = mass_[index_j];
+
+                VariableType variable_derivative = (variable_i - variable_[index_j]);
+                VariableType increment = parameter_b[n - 1] * variable_derivative / (mass_i * mass_j - parameter_b[n - 1] * (mass_i + mass_j));
+
+                variable_[index_i] += increment * mass_j;
+                variable_[index_j] -= increment * mass_i;
+            }
+        });
 }
 //=================================================================================================//
 template <typename VariableType>
@@ -0,0 +1,70 @@
+#include "dynamics_task_graph.h"
+
+namespace SPH
+{
+//=================================================================================================//
+void DynamicsTaskGraph::addDynamics(BaseDynamics<void> &dynamics, const StdVec<VariableAccess> &reads,
+                                    const StdVec<VariableAccess> &writes, const Real *time_step)
+{
+    dynamics_.push_back(&dynamics);
+    time_steps_.push_back(time_step);
+    reads_.push_back(reads);
+    writes_.push_back(writes);
+    is_graph_built_ = false;
+}
+//=================================================================================================//
+bool DynamicsTaskGraph::checkConflict(const StdVec<VariableAccess> &accesses,
+                                      const StdVec<VariableAccess> &other_accesses)
+{
+    for (const VariableAccess &access : accesses)
+        for (const VariableAccess &other_access : other_accesses)
+            if (access.checkOverlap(other_access))
+                return true;
+    return false;
+}
+//=================================================================================================//
+void DynamicsTaskGraph::buildGraph()
+{
+    graph_.reset(tbb::flow::rf_clear_edges);
+    task_nodes_.clear();
+    source_nodes_.clear();
+    predecessors_.clear();
+    predecessors_.resize(dynamics_.size());
+
+    for (size_t k = 0; k != dynamics_.size(); ++k)
+    {
+        BaseDynamics<void> *dynamics = dynamics_[k];
+        const Real *time_step = time_steps_[k];
+        task_nodes_.push_back(makeUnique<TaskNode>(
+            graph_, [this, dynamics, time_step](const tbb::flow::continue_msg &)
+            { dynamics->exec(time_step == nullptr ? dt_ : *time_step); }));
+
+        for (size_t l = 0; l != k; ++l)
+        {
+            if (checkConflict(writes_[l], reads_[k]) || checkConflict(writes_[l], writes_[k]) ||
+                checkConflict(reads_[l], writes_[k]))
+            {
+                predecessors_[k].push_back(l);
+                tbb::flow::make_edge(*task_nodes_[l], *task_nodes_[k]);
+            }
+        }
+
+        if (predecessors_[k].empty())
+            source_nodes_.push_back(task_nodes_[k].get());
+    }
+    is_graph_built_ = true;
+}
+//=================================================================================================//
+void DynamicsTaskGraph::exec(Real dt)
+{
+    if (!is_graph_built_)
+        buildGraph();
+
+    dt_ = dt;
+    ConcurrentLoopsScope concurrent_loops_scope;
+    for (TaskNode *source_node : source_nodes_)
+        source_node->try_put(tbb::flow::continue_msg());
+    graph_.wait_for_all();
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,124 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	dynamics_task_graph.h
+ * @brief 	Concurrent execution of independent particle dynamics by a task graph.
+ * @details Particle dynamics are added in the order they are executed sequentially,
+ *			together with the body data they read and write.
+ *			Two dynamics depend on each other if one writes data which the other reads or writes.
+ *			This holds for the dynamics of the same body as well, which run concurrently
+ *			if they access different particle variables.
+ *			The dependencies are found once, and each execution runs the dynamics
+ *			as a tbb flow graph, so that independent dynamics run concurrently
+ *			and the small ones overlap with large ones.
+ *			The dynamics are still internally parallel, with the stateless auto partitioner
+ *			instead of the shared affinity partitioner, see ConcurrentLoopsScope.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef DYNAMICS_TASK_GRAPH_H
+#define DYNAMICS_TASK_GRAPH_H
+
+#include "base_particle_dynamics.h"
+
+#include "tbb/flow_graph.h"
+
+namespace SPH
+{
+/**
+ * @class VariableAccess
+ * @brief Data of a body, given by the name of a particle variable or as body-level data.
+ * An empty variable name stands for all data of the body,
+ * which is the safe choice for dynamics which access the body in other ways,
+ * e.g. by changing the number of particles.
+ */
+class VariableAccess
+{
+  public:
+    enum class DataType
+    {
+        ParticleVariable,
+        CellLinkedList, /**< written by its update, read by the updates of the relations to the body. */
+        Neighborhoods   /**< the configurations of the body relations, read by the interactions. */
+    };
+
+    VariableAccess(SPHBody &sph_body, const std::string &variable_name = "")
+        : sph_body_(&sph_body), data_type_(DataType::ParticleVariable), variable_name_(variable_name){};
+    VariableAccess(SPHBody &sph_body, DataType data_type)
+        : sph_body_(&sph_body), data_type_(data_type), variable_name_(""){};
+    bool isAllData() const { return data_type_ == DataType::ParticleVariable && variable_name_.empty(); };
+    bool checkOverlap(const VariableAccess &another) const
+    {
+        return sph_body_ == another.sph_body_ &&
+               (isAllData() || another.isAllData() ||
+                (data_type_ == another.data_type_ && variable_name_ == another.variable_name_));
+    };
+
+  protected:
+    SPHBody *sph_body_;
+    DataType data_type_;
+    std::string variable_name_;
+};
+
+/**
+ * @class DynamicsTaskGraph
+ * @brief Run a sequence of dynamics with void return as a dependency-aware task graph.
+ * @details The result is the same as executing the dynamics in the order they are added,
+ * provided that the declared data cover all data the dynamics read and write in other bodies.
+ * Note that the dynamics of a body relation also read the variables of the contact bodies,
+ * and the update of a contact relation reads the cell linked lists of the contact bodies.
+ */
+class DynamicsTaskGraph
+{
+  public:
+    DynamicsTaskGraph() : dt_(0.0), is_graph_built_(false){};
+    virtual ~DynamicsTaskGraph(){};
+
+    /** The dynamics is executed with the given time step, which is read at each execution,
+     * or with that of the graph execution if none is given. */
+    void addDynamics(BaseDynamics<void> &dynamics, const StdVec<VariableAccess> &reads,
+                     const StdVec<VariableAccess> &writes, const Real *time_step = nullptr);
+    void exec(Real dt = 0.0);
+    /** The number of dynamics which the given one waits for, available after the first execution. */
+    size_t NumberOfPredecessors(size_t dynamics_index) { return predecessors_[dynamics_index].size(); };
+
+  protected:
+    using TaskNode = tbb::flow::continue_node<tbb::flow::continue_msg>;
+    StdVec<BaseDynamics<void> *> dynamics_;
+    StdVec<const Real *> time_steps_;
+    StdVec<StdVec<VariableAccess>> reads_;
+    StdVec<StdVec<VariableAccess>> writes_;
+    StdVec<IndexVector> predecessors_;
+    Real dt_;
+    bool is_graph_built_;
+    tbb::flow::graph graph_;
+    StdVec<UniquePtr<TaskNode>> task_nodes_;
+    StdVec<TaskNode *> source_nodes_;
+
+    bool checkConflict(const StdVec<VariableAccess> &accesses, const StdVec<VariableAccess> &other_accesses);
+    /** An edge from every earlier dynamics which writes data the later one reads or writes,
+     * or reads data the later one writes. */
+    void buildGraph();
+};
+} // namespace SPH
+#endif // DYNAMICS_TASK_GRAPH_H
@@ -70,19 +70,8 @@ void EmitterInflowInjection::update(size_t unsorted_index_i, Real dt)
     size_t sorted_index_i = sorted_id_[unsorted_index_i];
     if (aligned_box_.checkUpperBound(axis_, pos_[sorted_index_i]))
     {
-        mutex_switch_to_real_.lock();
-        if (particles_->total_real_particles_ >= particles_->real_particles_bound_)
-        {
-            std::cout << "EmitterInflowBoundaryCondition::ConstraintAParticle: \n"
-                      << "Not enough body buffer particles! Exit the code."
-                      << "\n";
-            exit(0);
-        }
-        /** Buffer Particle state copied from real particle. */
-        particles_->copyFromAnotherParticle(particles_->total_real_particles_, sorted_index_i);
-        /** Realize the buffer particle by increasing the number of real particle in the body.  */
-        particles_->total_real_particles_ += 1;
-        mutex_switch_to_real_.unlock();
+        /** Buffer particle state copied from real particle, realized after the loop. */
+        particles_->createParticleFrom(sorted_index_i);
         /** Periodic bounding. */
         pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(axis_, pos_[sorted_index_i]);
         rho_[sorted_index_i] = fluid_.ReferenceDensity();
@@ -97,12 +86,11 @@ DisposerOutflowDeletion::
 //=================================================================================================//
 void DisposerOutflowDeletion::update(size_t index_i, Real dt)
 {
-    mutex_switch_to_buffer_.lock();
-    while (aligned_box_.checkUpperBound(axis_, pos_[index_i]) && index_i < particles_->total_real_particles_)
+    if (index_i < particles_->total_real_particles_ && aligned_box_.checkUpperBound(axis_, pos_[index_i]))
     {
-        particles_->switchToBufferParticle(index_i);
+        /** Switched to buffer particle after the loop. */
+        particles_->markParticleForDeletion(index_i);
     }
-    mutex_switch_to_buffer_.unlock();
 }
 } // namespace fluid_dynamics
 } // namespace SPH
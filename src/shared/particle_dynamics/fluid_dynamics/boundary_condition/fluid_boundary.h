@@ -31,7 +31,6 @@
 #define FLUID_BOUNDARY_H
 
 #include "base_fluid_dynamics.h"
-#include <mutex>
 
 namespace SPH
 {
@@ -217,9 +216,9 @@ class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>, pub
     virtual ~EmitterInflowInjection(){};
 
     void update(size_t unsorted_index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override { particles_->commitParticleCreationAndDeletion(); };
 
   protected:
-    std::mutex mutex_switch_to_real_; /**< mutex exclusion for memory conflict */
     Fluid &fluid_;
     StdLargeVec<Vecd> &pos_;
     StdLargeVec<Real> &rho_, &p_;
@@ -238,9 +237,9 @@ class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>, public
     virtual ~DisposerOutflowDeletion(){};
 
     void update(size_t index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override { particles_->commitParticleCreationAndDeletion(); };
 
   protected:
-    std::mutex mutex_switch_to_buffer_; /**< mutex exclusion for memory conflict */
     StdLargeVec<Vecd> &pos_;
     const int axis_; /**< the axis direction for bounding*/
     AlignedBoxShape &aligned_box_;
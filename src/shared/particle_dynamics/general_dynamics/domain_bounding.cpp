@@ -1,5 +1,7 @@
 #include "domain_bounding.h"
 
+#include <numeric>
+
 namespace SPH
 {
 //=================================================================================================//
@@ -68,51 +70,92 @@ void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::setupDyn
         ghost_particles_[i].clear();
 }
 //=================================================================================================//
-void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
+bool PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::isNearLowerBound(size_t index_i)
 {
-    Vecd particle_position = pos_[index_i];
-    Real particle_volumetric = Vol_[index_i];
-    if (particle_position[axis_] > bounding_bounds_.first_[axis_] &&
-        particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
-    {
-        mutex_create_ghost_particle_.lock();
-        size_t ghost_particle_index = particles_->insertAGhostParticle(index_i);
-        ghost_particles_[0].push_back(ghost_particle_index);
-        pos_[ghost_particle_index] = particle_position + periodic_translation_;
-        /** insert ghost particle to cell linked list */
-        cell_linked_list_.InsertListDataEntry(ghost_particle_index,
-                                              pos_[ghost_particle_index], particle_volumetric);
-        mutex_create_ghost_particle_.unlock();
-    }
+    return pos_[index_i][axis_] > bounding_bounds_.first_[axis_] &&
+           pos_[index_i][axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_);
 }
 //=================================================================================================//
-void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::checkUpperBound(size_t index_i, Real dt)
+bool PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::isNearUpperBound(size_t index_i)
 {
-    Vecd particle_position = pos_[index_i];
-    Real particle_volumetric = Vol_[index_i];
-    if (particle_position[axis_] < bounding_bounds_.second_[axis_] &&
-        particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
-    {
-        mutex_create_ghost_particle_.lock();
-        size_t ghost_particle_index = particles_->insertAGhostParticle(index_i);
-        ghost_particles_[1].push_back(ghost_particle_index);
-        pos_[ghost_particle_index] = particle_position - periodic_translation_;
-        /** insert ghost particle to cell linked list */
+    return pos_[index_i][axis_] < bounding_bounds_.second_[axis_] &&
+           pos_[index_i][axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_);
+}
+//=================================================================================================//
+template <typename CheckFunction>
+void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::
+    createGhostParticles(ConcurrentCellLists &bound_cells, IndexVector &ghost_particles,
+                         const Vecd &translation, const CheckFunction &check_ghosting)
+{
+    size_t number_of_cells = bound_cells.size();
+    cell_offsets_.resize(number_of_cells + 1);
+    cell_offsets_[0] = 0;
+    parallel_for(
+        IndexRange(0, number_of_cells),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t count = 0;
+                for (size_t index_i : *bound_cells[n])
+                    count += check_ghosting(index_i) ? 1 : 0;
+                cell_offsets_[n + 1] = count;
+            }
+        },
+        ap);
+    std::partial_sum(cell_offsets_.begin(), cell_offsets_.end(), cell_offsets_.begin());
+
+    size_t total_ghosts = cell_offsets_[number_of_cells];
+    size_t first_ghost_index = particles_->reserveGhostParticles(total_ghosts);
+    ghost_particles.resize(total_ghosts);
+    parallel_for(
+        IndexRange(0, number_of_cells),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t offset = cell_offsets_[n];
+                for (size_t index_i : *bound_cells[n])
+                    if (check_ghosting(index_i))
+                    {
+                        size_t ghost_particle_index = first_ghost_index + offset;
+                        ghost_particles[offset] = ghost_particle_index;
+                        particles_->updateGhostParticle(ghost_particle_index, index_i);
+                        pos_[ghost_particle_index] = pos_[index_i] + translation;
+                        ++offset;
+                    }
+            }
+        },
+        ap);
+
+    /** insert ghost particles to cell linked list, which is not thread safe */
+    for (size_t ghost_particle_index : ghost_particles)
         cell_linked_list_.InsertListDataEntry(ghost_particle_index,
-                                              pos_[ghost_particle_index], particle_volumetric);
-        mutex_create_ghost_particle_.unlock();
-    }
+                                              pos_[ghost_particle_index], Vol_[ghost_particle_index]);
+}
+//=================================================================================================//
+void PeriodicConditionUsingGhostParticles::CreatPeriodicGhostParticles::exec(Real dt)
+{
+    setupDynamics(dt);
+
+    createGhostParticles(bound_cells_data_[0].first, ghost_particles_[0], periodic_translation_,
+                         [&](size_t index_i)
+                         { return isNearLowerBound(index_i); });
+
+    createGhostParticles(bound_cells_data_[1].first, ghost_particles_[1], -periodic_translation_,
+                         [&](size_t index_i)
+                         { return isNearUpperBound(index_i); });
 }
 //=================================================================================================//
 void PeriodicConditionUsingGhostParticles::UpdatePeriodicGhostParticles::checkLowerBound(size_t index_i, Real dt)
 {
-    particles_->updateFromAnotherParticle(index_i, sorted_id_[index_i]);
+    particles_->updateGhostParticle(index_i, sorted_id_[index_i]);
     pos_[index_i] += periodic_translation_;
 }
 //=================================================================================================//
 void PeriodicConditionUsingGhostParticles::UpdatePeriodicGhostParticles::checkUpperBound(size_t index_i, Real dt)
 {
-    particles_->updateFromAnotherParticle(index_i, sorted_id_[index_i]);
+    particles_->updateGhostParticle(index_i, sorted_id_[index_i]);
     pos_[index_i] -= periodic_translation_;
 }
 //=================================================================================================//
@@ -200,16 +200,23 @@ class PeriodicConditionUsingGhostParticles : public BasePeriodicCondition<execut
     /**
      * @class CreatPeriodicGhostParticles
      * @brief create ghost particles in an axis direction
+     * @details The ghost particles are created by count-then-fill.
+     * The particles to be ghosted are counted for each bound cell in parallel,
+     * the counts are turned into offsets by a prefix sum, and then the ghost particles,
+     * reserved together, are filled in parallel with the ghost-visible particle data.
      */
     class CreatPeriodicGhostParticles : public PeriodicBounding
     {
       protected:
-        std::mutex mutex_create_ghost_particle_; /**< mutex exclusion for memory conflict */
         StdVec<IndexVector> &ghost_particles_;
         StdLargeVec<Real> &Vol_;
+        IndexVector cell_offsets_; /**< offsets of the ghost particles created from each bound cell */
         virtual void setupDynamics(Real dt = 0.0) override;
-        virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
-        virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+        bool isNearLowerBound(size_t index_i);
+        bool isNearUpperBound(size_t index_i);
+        template <typename CheckFunction>
+        void createGhostParticles(ConcurrentCellLists &bound_cells, IndexVector &ghost_particles,
+                                  const Vecd &translation, const CheckFunction &check_ghosting);
 
       public:
         CreatPeriodicGhostParticles(Vecd &periodic_translation,
@@ -219,6 +226,8 @@ class PeriodicConditionUsingGhostParticles : public BasePeriodicCondition<execut
             : PeriodicBounding(periodic_translation, bound_cells_data, real_body, bounding_bounds, axis),
               ghost_particles_(ghost_particles), Vol_(particles_->Vol_){};
         virtual ~CreatPeriodicGhostParticles(){};
+
+        virtual void exec(Real dt = 0.0) override;
     };
 
     /**
@@ -11,14 +11,46 @@ ShapeSurfaceBounding::ShapeSurfaceBounding(NearShapeSurface &near_shape_surface)
     level_set_shape_ = &near_shape_surface.getLevelSetShape();
 }
 //=================================================================================================//
+void ShapeSurfaceBounding::setupDynamics(Real dt)
+{
+    ConcurrentCellLists &body_part_cells = identifier_.LoopRange();
+    ScratchScope scratch;
+    size_t *particle_offsets = scratch.allocate<size_t>(body_part_cells.size() + 1);
+    computeCellWorkPrefix(body_part_cells, particle_offsets, 0);
+    probe_particles_.resize(particle_offsets[body_part_cells.size()]);
+    parallel_for(
+        IndexRange(0, body_part_cells.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+            {
+                ConcurrentIndexVector &particle_indices = *body_part_cells[k];
+                for (size_t num = 0; num != particle_indices.size(); ++num)
+                    probe_particles_[particle_offsets[k] + num] = particle_indices[num];
+            }
+        },
+        ap);
+
+    if (phi_.size() < pos_.size())
+    {
+        phi_.resize(pos_.size());
+        unit_normal_.resize(pos_.size());
+    }
+    level_set_shape_->probeSignedDistance(pos_, probe_particles_, phi_);
+
+    gatherIndices(probe_particles_, constrained_particles_,
+                  [&](size_t n)
+                  { return phi_[probe_particles_[n]] > -constrained_distance_; });
+    level_set_shape_->probeNormalDirection(pos_, constrained_particles_, unit_normal_);
+}
+//=================================================================================================//
 void ShapeSurfaceBounding::update(size_t index_i, Real dt)
 {
-    Real phi = level_set_shape_->findSignedDistance(pos_[index_i]);
+    Real phi = phi_[index_i];
 
     if (phi > -constrained_distance_)
     {
-        Vecd unit_normal = level_set_shape_->findNormalDirection(pos_[index_i]);
-        pos_[index_i] -= (phi + constrained_distance_) * unit_normal;
+        pos_[index_i] -= (phi + constrained_distance_) * unit_normal_[index_i];
     }
 }
 //=================================================================================================//
@@ -48,12 +48,18 @@ class ShapeSurfaceBounding : public BaseLocalDynamics<BodyPartByCell>,
   public:
     ShapeSurfaceBounding(NearShapeSurface &body_part);
     virtual ~ShapeSurfaceBounding(){};
+    /** Probe the level set for all particles of the body part in batches. */
+    virtual void setupDynamics(Real dt = 0.0) override;
     void update(size_t index_i, Real dt = 0.0);
 
   protected:
     StdLargeVec<Vecd> &pos_;
     LevelSetShape *level_set_shape_;
     Real constrained_distance_;
+    IndexVector probe_particles_;      /**< particles in the cells of the body part. */
+    IndexVector constrained_particles_; /**< particles to be mapped to the surface. */
+    StdLargeVec<Real> phi_;
+    StdLargeVec<Vecd> unit_normal_;
 };
 } // namespace SPH
 #endif // GENERAL_CONSTRAINT_H
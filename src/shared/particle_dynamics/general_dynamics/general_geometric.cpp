@@ -6,13 +6,25 @@ namespace SPH
 //=============================================================================================//
 NormalDirectionFromBodyShape::NormalDirectionFromBodyShape(SPHBody &sph_body)
     : LocalDynamics(sph_body), GeneralDataDelegateSimple(sph_body),
-      initial_shape_(*sph_body.initial_shape_), pos_(particles_->pos_),
+      initial_shape_(*sph_body.initial_shape_),
+      level_set_shape_(dynamic_cast<LevelSetShape *>(sph_body.initial_shape_)), pos_(particles_->pos_),
       n_(*particles_->registerSharedVariable<Vecd>("NormalDirection")),
       n0_(*particles_->registerSharedVariable<Vecd>("InitialNormalDirection")) {}
 //=============================================================================================//
+void NormalDirectionFromBodyShape::setupDynamics(Real dt)
+{
+    if (level_set_shape_ != nullptr)
+    {
+        fillIdentityIndices(probe_particles_, particles_->total_real_particles_);
+        level_set_shape_->probeNormalDirection(pos_, probe_particles_, n_);
+    }
+}
+//=============================================================================================//
 void NormalDirectionFromBodyShape::update(size_t index_i, Real dt)
 {
-    Vecd normal_direction = initial_shape_.findNormalDirection(pos_[index_i]);
+    Vecd normal_direction = level_set_shape_ != nullptr
+                                ? n_[index_i]
+                                : initial_shape_.findNormalDirection(pos_[index_i]);
     n_[index_i] = normal_direction;
     n0_[index_i] = normal_direction;
 }
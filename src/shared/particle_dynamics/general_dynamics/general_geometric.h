@@ -42,11 +42,15 @@ class NormalDirectionFromBodyShape : public LocalDynamics, public GeneralDataDel
   public:
     explicit NormalDirectionFromBodyShape(SPHBody &sph_body);
     virtual ~NormalDirectionFromBodyShape(){};
+    /** Probe the normal directions in a batch if the shape is given by a level set. */
+    virtual void setupDynamics(Real dt = 0.0) override;
     void update(size_t index_i, Real dt = 0.0);
 
   protected:
     Shape &initial_shape_;
+    LevelSetShape *level_set_shape_; /**< nullptr if the shape is not a level set shape. */
     StdLargeVec<Vecd> &pos_, &n_, &n0_;
+    IndexVector probe_particles_; /**< all real particles, kept for the next probes. */
 };
 
 /**
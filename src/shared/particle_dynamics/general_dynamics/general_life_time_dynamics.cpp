@@ -29,10 +29,7 @@ void RefinementInPrescribedRegion::update(size_t index_i, Real dt)
     if (checkSplit(index_i))
     {
         Vecd split_shift = execFirstSplit(index_i);
-
-        mutex_split_.lock();
         execOtherSplit(index_i, split_shift);
-        mutex_split_.unlock();
     }
 }
 //=================================================================================================//
@@ -78,24 +75,9 @@ Vecd RefinementInPrescribedRegion::execFirstSplit(size_t index_i)
 //=================================================================================================//
 void RefinementInPrescribedRegion::execOtherSplit(size_t index_i, const Vecd &split_shift)
 {
-    size_t total_real_particles = particles_->total_real_particles_;
-
-    if (total_real_particles >= particles_->real_particles_bound_)
-    {
-        std::cout << "ParticleSplitWithPrescribedArea: \n"
-                  << "Not enough body buffer particles! Exit the code."
-                  << "\n";
-        exit(0);
-    }
-    else
-    {
-        particles_->copyFromAnotherParticle(total_real_particles, index_i);
-
-        pos_[index_i] += split_shift;
-        pos_[total_real_particles] -= split_shift;
-
-        particles_->total_real_particles_ += 1;
-    }
+    size_t new_index = particles_->createParticleFrom(index_i);
+    pos_[index_i] += split_shift;
+    pos_[new_index] -= split_shift;
 }
 //=================================================================================================//
 } // namespace SPH
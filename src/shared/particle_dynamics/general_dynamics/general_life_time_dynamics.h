@@ -85,9 +85,9 @@ class RefinementInPrescribedRegion : public BaseSplitDynamics<Vecd>
     virtual ~RefinementInPrescribedRegion(){};
     virtual void setupDynamics(Real dt = 0.0) override;
     void update(size_t index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override { particles_->commitParticleCreationAndDeletion(); };
 
   protected:
-    std::mutex mutex_split_; /**< mutex exclusion for memory conflict */
     BoundingBox refinement_region_bounds_;
     std::random_device random_device_;
     std::mt19937 random_seed_;
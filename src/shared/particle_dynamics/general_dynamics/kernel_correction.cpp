@@ -7,13 +7,16 @@ void KernelCorrectionMatrix<Inner<>>::interaction(size_t index_i, Real dt)
 {
     Matd local_configuration = Eps * Matd::Identity();
 
-    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-    {
-        Vecd gradW_ij = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-        Vecd r_ji = inner_neighborhood.r_ij_[n] * inner_neighborhood.e_ij_[n];
-        local_configuration -= r_ji * gradW_ij.transpose();
-    }
+    onInnerNeighborhood(
+        index_i, [&](const auto &inner_neighborhood)
+        {
+            for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            {
+                Vecd gradW_ij = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                Vecd r_ji = inner_neighborhood.r_ij_[n] * inner_neighborhood.e_ij_[n];
+                local_configuration -= r_ji * gradW_ij.transpose();
+            }
+        });
     B_[index_i] = local_configuration;
 }
 //=================================================================================================//
@@ -116,7 +116,9 @@ class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
-                     { this->update(i, dt); });
+                     { this->update(i, dt); },
+                     this->loop_partitioner_);
+        this->finishDynamics(dt);
     };
 };
 
@@ -148,7 +150,9 @@ class ReduceDynamics : public LocalDynamicsType,
         ReturnType temp = particle_reduce(ExecutionPolicy(),
                                           this->identifier_.LoopRange(), this->Reference(), this->getOperation(),
                                           [&](size_t i) -> ReturnType
-                                          { return this->reduce(i, dt); });
+                                          { return this->reduce(i, dt); },
+                                          this->loop_partitioner_);
+        this->finishDynamics(dt);
         return this->outputResult(temp);
     };
 };
@@ -191,6 +195,7 @@ class BaseInteractionDynamics : public LocalDynamicsType, public BaseDynamics<vo
         this->setUpdated();
         this->setupDynamics(dt);
         runInteraction(dt);
+        this->finishDynamics(dt);
     };
 };
 
@@ -253,7 +258,8 @@ class InteractionDynamics : public BaseInteractionDynamics<LocalDynamicsType, Ex
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
-                     { this->interaction(i, dt); });
+                     { this->interaction(i, dt); },
+                     this->loop_partitioner_);
     }
 
   protected:
@@ -281,12 +287,19 @@ class InteractionWithUpdate : public InteractionDynamics<LocalDynamicsType, Exec
 
     virtual void exec(Real dt = 0.0) override
     {
-        InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::exec(dt);
+        this->setUpdated();
+        this->setupDynamics(dt);
+        InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::runInteraction(dt);
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
-                     { this->update(i, dt); });
+                     { this->update(i, dt); },
+                     update_partitioner_);
+        this->finishDynamics(dt);
     };
+
+  protected:
+    LoopPartitioner update_partitioner_;
 };
 
 /**
@@ -311,9 +324,13 @@ class InteractionWithInitialization : public InteractionDynamics<LocalDynamicsTy
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
-                     { this->initialization(i, dt); });
+                     { this->initialization(i, dt); },
+                     initialization_partitioner_);
         InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::exec(dt);
     };
+
+  protected:
+    LoopPartitioner initialization_partitioner_;
 };
 
 /**
@@ -340,15 +357,22 @@ class Dynamics1Level : public InteractionDynamics<LocalDynamicsType, ExecutionPo
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
-                     { this->initialization(i, dt); });
+                     { this->initialization(i, dt); },
+                     initialization_partitioner_);
 
         InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::runInteraction(dt);
 
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i)
-                     { this->update(i, dt); });
+                     { this->update(i, dt); },
+                     update_partitioner_);
+        this->finishDynamics(dt);
     };
+
+  protected:
+    LoopPartitioner initialization_partitioner_;
+    LoopPartitioner update_partitioner_;
 };
 } // namespace SPH
 #endif // PARTICLE_DYNAMICS_ALGORITHMS_H
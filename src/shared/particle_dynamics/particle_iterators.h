@@ -31,12 +31,80 @@
 
 #include "base_data_package.h"
 #include "execution_policy.h"
+#include "loop_partitioner.hpp"
+#include "scratch_arena.h"
 #include "sph_data_containers.h"
+#include "work_balanced_range.h"
 
 namespace SPH
 {
 using namespace execution;
 
+/** The number of particles in a task of the cell-wise parallel loops.
+ * Cells are split by particle numbers, with one more for each cell to account for its overhead. */
+inline constexpr size_t cell_loop_grain_work = 256;
+
+/** The number of cells in a task of the parallel scan for the work prefix. */
+inline constexpr size_t cell_work_prefix_grain_size = 4096;
+
+/** The work prefix has one more entry than the cells, taken from the scratch arena by the caller.
+ * It is computed by a parallel scan, so that it does not serialize the loops over many cells.
+ * The work of a cell is its number of particles and the cell overhead,
+ * hence a zero overhead gives the offsets of the particles of the cells. */
+inline void computeCellWorkPrefix(const ConcurrentCellLists &cell_lists, size_t *work_prefix, size_t cell_overhead = 1)
+{
+    work_prefix[0] = 0;
+    parallel_scan(
+        IndexRange(0, cell_lists.size(), cell_work_prefix_grain_size), size_t(0),
+        [&](const IndexRange &r, size_t work_sum, bool is_final_scan) -> size_t
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                work_sum += cell_lists[i]->size() + cell_overhead;
+                if (is_final_scan)
+                    work_prefix[i + 1] = work_sum;
+            }
+            return work_sum;
+        },
+        [](size_t left, size_t right) -> size_t
+        { return left + right; });
+};
+
+/** In NUMA-aware mode, the parallel loops use the static partitioner instead of the given one,
+ * so that a thread works on the same particles, hence on the same memory pages, in each loop. */
+template <class Range, class LoopFunction, class Partitioner>
+inline void numa_aware_parallel_for(const Range &range, const LoopFunction &loop_function, Partitioner &&partitioner)
+{
+    if (NumaAwareness::first_touch_)
+        parallel_for(range, loop_function, tbb::static_partitioner());
+    else
+        parallel_for(range, loop_function, partitioner);
+};
+
+template <class Range, typename ReturnType, class LoopFunction, class JoinFunction, class Partitioner>
+inline ReturnType numa_aware_parallel_reduce(const Range &range, const ReturnType &identity, const LoopFunction &loop_function,
+                                             const JoinFunction &join_function, Partitioner &&partitioner)
+{
+    if (NumaAwareness::first_touch_)
+        return parallel_reduce(range, identity, loop_function, join_function, tbb::static_partitioner());
+    return parallel_reduce(range, identity, loop_function, join_function, partitioner);
+};
+
+/** The loop partitioner owned by a dynamics chooses the static partitioner itself in NUMA-aware mode. */
+template <class LoopFunction>
+inline void numa_aware_parallel_for(const IndexRange &range, const LoopFunction &loop_function,
+                                    LoopPartitioner &loop_partitioner)
+{
+    loop_partitioner.parallelFor(range, loop_function);
+};
+
+template <typename ReturnType, class LoopFunction, class JoinFunction>
+inline ReturnType numa_aware_parallel_reduce(const IndexRange &range, const ReturnType &identity, const LoopFunction &loop_function,
+                                             const JoinFunction &join_function, LoopPartitioner &loop_partitioner)
+{
+    return loop_partitioner.parallelReduce(range, identity, loop_function, join_function);
+};
+
 template <class ExecutionPolicy, typename DynamicsRange, class LocalDynamicsFunction>
 void particle_for(const ExecutionPolicy &execution_policy, const DynamicsRange &dynamics_range,
                   const LocalDynamicsFunction &local_dynamics_function)
@@ -58,11 +126,11 @@ inline void particle_for(const SequencedPolicy &seq, const size_t &all_real_part
         local_dynamics_function(i);
 };
 
-template <class LocalDynamicsFunction>
+template <class LocalDynamicsFunction, class Partitioner = SharedAffinityPartitioner &>
 inline void particle_for(const ParallelPolicy &par, const size_t &all_real_particles,
-                         const LocalDynamicsFunction &local_dynamics_function)
+                         const LocalDynamicsFunction &local_dynamics_function, Partitioner &&partitioner = ap)
 {
-    parallel_for(
+    numa_aware_parallel_for(
         IndexRange(0, all_real_particles),
         [&](const IndexRange &r)
         {
@@ -71,7 +139,7 @@ inline void particle_for(const ParallelPolicy &par, const size_t &all_real_parti
                 local_dynamics_function(i);
             }
         },
-        ap);
+        partitioner);
 };
 /**
  * Bodypart By Particle-wise iterators (for sequential and parallel computing).
@@ -84,11 +152,11 @@ inline void particle_for(const SequencedPolicy &seq, const IndexVector &body_par
         local_dynamics_function(body_part_particles[i]);
 };
 
-template <class LocalDynamicsFunction>
+template <class LocalDynamicsFunction, class Partitioner = SharedAffinityPartitioner &>
 inline void particle_for(const ParallelPolicy &par, const IndexVector &body_part_particles,
-                         const LocalDynamicsFunction &local_dynamics_function)
+                         const LocalDynamicsFunction &local_dynamics_function, Partitioner &&partitioner = ap)
 {
-    parallel_for(
+    numa_aware_parallel_for(
         IndexRange(0, body_part_particles.size()),
         [&](const IndexRange &r)
         {
@@ -97,7 +165,7 @@ inline void particle_for(const ParallelPolicy &par, const IndexVector &body_part
                 local_dynamics_function(body_part_particles[i]);
             }
         },
-        ap);
+        partitioner);
 };
 /**
  * Bodypart By Cell-wise iterators (for sequential and parallel computing).
@@ -116,13 +184,17 @@ inline void particle_for(const SequencedPolicy &seq, const ConcurrentCellLists &
     }
 }
 
-template <class LocalDynamicsFunction>
+/** Cell-wise loops are balanced by the work in the cells, hence do not use the given partitioner. */
+template <class LocalDynamicsFunction, class Partitioner = tbb::simple_partitioner>
 inline void particle_for(const ParallelPolicy &par, const ConcurrentCellLists &body_part_cells,
-                         const LocalDynamicsFunction &local_dynamics_function)
+                         const LocalDynamicsFunction &local_dynamics_function, Partitioner && = Partitioner())
 {
-    parallel_for(
-        IndexRange(0, body_part_cells.size()),
-        [&](const IndexRange &r)
+    ScratchScope scratch_scope;
+    size_t *work_prefix = scratch_scope.allocate<size_t>(body_part_cells.size() + 1);
+    computeCellWorkPrefix(body_part_cells, work_prefix);
+    numa_aware_parallel_for(
+        WorkBalancedRange(0, body_part_cells.size(), work_prefix, cell_loop_grain_work),
+        [&](const WorkBalancedRange &r)
         {
             for (size_t i = r.begin(); i < r.end(); ++i)
             {
@@ -133,7 +205,7 @@ inline void particle_for(const ParallelPolicy &par, const ConcurrentCellLists &b
                 }
             }
         },
-        ap);
+        tbb::simple_partitioner());
 };
 /**
  * BodypartByCell-wise iterators on cells (for sequential and parallel computing).
@@ -146,11 +218,11 @@ inline void particle_for(const SequencedPolicy &seq, const DataListsInCells &bod
         local_dynamics_function(body_part_cells[i]);
 };
 
-template <class LocalDynamicsFunction>
+template <class LocalDynamicsFunction, class Partitioner = SharedAffinityPartitioner &>
 inline void particle_for(const ParallelPolicy &par, const DataListsInCells &body_part_cells,
-                         const LocalDynamicsFunction &local_dynamics_function)
+                         const LocalDynamicsFunction &local_dynamics_function, Partitioner &&partitioner = ap)
 {
-    parallel_for(
+    numa_aware_parallel_for(
         IndexRange(0, body_part_cells.size()),
         [&](const IndexRange &r)
         {
@@ -159,7 +231,7 @@ inline void particle_for(const ParallelPolicy &par, const DataListsInCells &body
                 local_dynamics_function(body_part_cells[i]);
             }
         },
-        ap);
+        partitioner);
 };
 /**
  * Splitting algorithm (for sequential and parallel computing).
@@ -197,48 +269,67 @@ inline void particle_for(const SequencedPolicy &seq, const SplitCellLists &split
     }
 }
 
+/** A color with little work is swept without spawning tasks. */
 template <class LocalDynamicsFunction>
 inline void particle_for(const ParallelPolicy &par, const SplitCellLists &split_cell_lists,
                          const LocalDynamicsFunction &local_dynamics_function)
 {
+    ScratchScope scratch_scope;
+    size_t **work_prefixes = scratch_scope.allocate<size_t *>(split_cell_lists.size());
+    for (size_t k = 0; k != split_cell_lists.size(); ++k)
+        work_prefixes[k] = scratch_scope.allocate<size_t>(split_cell_lists[k].size() + 1);
+    parallel_for(
+        IndexRange(0, split_cell_lists.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k < r.end(); ++k)
+            {
+                computeCellWorkPrefix(split_cell_lists[k], work_prefixes[k]);
+            }
+        });
+
     // forward sweeping
     for (size_t k = 0; k != split_cell_lists.size(); ++k)
     {
         const ConcurrentCellLists &cell_lists = split_cell_lists[k];
-        parallel_for(
-            IndexRange(0, cell_lists.size()),
-            [&](const IndexRange &r)
+        auto forward_sweep = [&](const WorkBalancedRange &r)
+        {
+            for (size_t l = r.begin(); l < r.end(); ++l)
             {
-                for (size_t l = r.begin(); l < r.end(); ++l)
+                const ConcurrentIndexVector &particle_indexes = *cell_lists[l];
+                for (size_t i = 0; i < particle_indexes.size(); ++i)
                 {
-                    const ConcurrentIndexVector &particle_indexes = *cell_lists[l];
-                    for (size_t i = 0; i < particle_indexes.size(); ++i)
-                    {
-                        local_dynamics_function(particle_indexes[i]);
-                    }
+                    local_dynamics_function(particle_indexes[i]);
                 }
-            },
-            ap);
+            }
+        };
+        WorkBalancedRange range(0, cell_lists.size(), work_prefixes[k], cell_loop_grain_work);
+        if (range.is_divisible())
+            numa_aware_parallel_for(range, forward_sweep, tbb::simple_partitioner());
+        else
+            forward_sweep(range);
     }
 
     // backward sweeping
     for (size_t k = split_cell_lists.size(); k != 0; --k)
     {
         const ConcurrentCellLists &cell_lists = split_cell_lists[k - 1];
-        parallel_for(
-            IndexRange(0, cell_lists.size()),
-            [&](const IndexRange &r)
+        auto backward_sweep = [&](const WorkBalancedRange &r)
+        {
+            for (size_t l = r.begin(); l < r.end(); ++l)
             {
-                for (size_t l = r.begin(); l < r.end(); ++l)
+                const ConcurrentIndexVector &particle_indexes = *cell_lists[l];
+                for (size_t i = particle_indexes.size(); i != 0; --i)
                 {
-                    const ConcurrentIndexVector &particle_indexes = *cell_lists[l];
-                    for (size_t i = particle_indexes.size(); i != 0; --i)
-                    {
-                        local_dynamics_function(particle_indexes[i - 1]);
-                    }
+                    local_dynamics_function(particle_indexes[i - 1]);
                 }
-            },
-            ap);
+            }
+        };
+        WorkBalancedRange range(0, cell_lists.size(), work_prefixes[k - 1], cell_loop_grain_work);
+        if (range.is_divisible())
+            numa_aware_parallel_for(range, backward_sweep, tbb::simple_partitioner());
+        else
+            backward_sweep(range);
     }
 }
 
@@ -267,12 +358,13 @@ inline ReturnType particle_reduce(const SequencedPolicy &seq, const size_t &all_
     return temp;
 }
 
-template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+template <class ReturnType, typename Operation, class LocalDynamicsFunction, class Partitioner = tbb::auto_partitioner>
 inline ReturnType particle_reduce(const ParallelPolicy &par, const size_t &all_real_particles,
                                   ReturnType temp, Operation &&operation,
-                                  const LocalDynamicsFunction &local_dynamics_function)
+                                  const LocalDynamicsFunction &local_dynamics_function,
+                                  Partitioner &&partitioner = Partitioner())
 {
-    return parallel_reduce(
+    return numa_aware_parallel_reduce(
         IndexRange(0, all_real_particles),
         temp, [&](const IndexRange &r, ReturnType temp0) -> ReturnType
         {
@@ -284,7 +376,8 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const size_t &all_r
         [&](const ReturnType &x, const ReturnType &y) -> ReturnType
         {
             return operation(x, y);
-        });
+        },
+        partitioner);
 };
 /**
  * BodypartByParticle-wise reduce iterators (for sequential and parallel computing).
@@ -301,12 +394,13 @@ inline ReturnType particle_reduce(const SequencedPolicy &seq, const IndexVector
     return temp;
 }
 
-template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+template <class ReturnType, typename Operation, class LocalDynamicsFunction, class Partitioner = tbb::auto_partitioner>
 inline ReturnType particle_reduce(const ParallelPolicy &par, const IndexVector &body_part_particles,
                                   ReturnType temp, Operation &&operation,
-                                  const LocalDynamicsFunction &local_dynamics_function)
+                                  const LocalDynamicsFunction &local_dynamics_function,
+                                  Partitioner &&partitioner = Partitioner())
 {
-    return parallel_reduce(
+    return numa_aware_parallel_reduce(
         IndexRange(0, body_part_particles.size()),
         temp,
         [&](const IndexRange &r, ReturnType temp0) -> ReturnType
@@ -320,7 +414,8 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const IndexVector &
         [&](const ReturnType &x, const ReturnType &y) -> ReturnType
         {
             return operation(x, y);
-        });
+        },
+        partitioner);
 };
 /**
  * BodypartByCell-wise reduce iterators (for sequential and parallel computing).
@@ -342,15 +437,19 @@ inline ReturnType particle_reduce(const SequencedPolicy &seq, const ConcurrentCe
     return temp;
 }
 
-template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+template <class ReturnType, typename Operation, class LocalDynamicsFunction, class Partitioner = tbb::simple_partitioner>
 inline ReturnType particle_reduce(const ParallelPolicy &par, const ConcurrentCellLists &body_part_cells,
                                   ReturnType temp, Operation &&operation,
-                                  const LocalDynamicsFunction &local_dynamics_function)
+                                  const LocalDynamicsFunction &local_dynamics_function,
+                                  Partitioner && = Partitioner())
 {
-    return parallel_reduce(
-        IndexRange(0, body_part_cells.size()),
+    ScratchScope scratch_scope;
+    size_t *work_prefix = scratch_scope.allocate<size_t>(body_part_cells.size() + 1);
+    computeCellWorkPrefix(body_part_cells, work_prefix);
+    return numa_aware_parallel_reduce(
+        WorkBalancedRange(0, body_part_cells.size(), work_prefix, cell_loop_grain_work),
         temp,
-        [&](const IndexRange &r, ReturnType temp0) -> ReturnType
+        [&](const WorkBalancedRange &r, ReturnType temp0) -> ReturnType
         {
             for (size_t i = r.begin(); i != r.end(); ++i)
             {
@@ -363,7 +462,26 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const ConcurrentCel
             return temp0;
         },
         [&](const ReturnType &x, const ReturnType &y) -> ReturnType
-        { return operation(x, y); });
+        { return operation(x, y); },
+        tbb::simple_partitioner());
 }
+/**
+ * The parallel iterators take an optional partitioner, e.g. the loop partitioner owned by a dynamics.
+ * The sequential iterators ignore the partitioner.
+ */
+template <typename DynamicsRange, class LocalDynamicsFunction, class Partitioner>
+inline void particle_for(const SequencedPolicy &seq, const DynamicsRange &dynamics_range,
+                         const LocalDynamicsFunction &local_dynamics_function, Partitioner &&)
+{
+    particle_for(seq, dynamics_range, local_dynamics_function);
+};
+
+template <typename DynamicsRange, class ReturnType, typename Operation, class LocalDynamicsFunction, class Partitioner>
+inline ReturnType particle_reduce(const SequencedPolicy &seq, const DynamicsRange &dynamics_range,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function, Partitioner &&)
+{
+    return particle_reduce(seq, dynamics_range, temp, operation, local_dynamics_function);
+};
 } // namespace SPH
 #endif // PARTICLE_ITERATORS_H
@@ -26,11 +26,18 @@ void RelaxationResidue<Inner<>>::interaction(size_t index_i, Real dt)
     residue_[index_i] = residue;
 };
 //=================================================================================================//
+void RelaxationResidue<Inner<LevelSetCorrection>>::setupDynamics(Real dt)
+{
+    fillIdentityIndices(probe_particles_, particles_->total_real_particles_);
+    if (kernel_gradient_integral_.size() < pos_.size())
+        kernel_gradient_integral_.resize(pos_.size());
+    level_set_shape_.probeKernelGradientIntegral(pos_, probe_particles_, kernel_gradient_integral_, h_ratios_);
+}
+//=================================================================================================//
 void RelaxationResidue<Inner<LevelSetCorrection>>::interaction(size_t index_i, Real dt)
 {
     RelaxationResidue<Inner<>>::interaction(index_i, dt);
-    residue_[index_i] -= 2.0 * level_set_shape_.computeKernelGradientIntegral(
-                                   pos_[index_i], sph_adaptation_->SmoothingLengthRatio(index_i));
+    residue_[index_i] -= 2.0 * kernel_gradient_integral_[index_i];
 }
 //=================================================================================================//
 void RelaxationResidue<Contact<>>::interaction(size_t index_i, Real dt)
@@ -63,6 +70,22 @@ Real RelaxationScaling::outputResult(Real reduced_value)
     return 0.0625 * h_ref_ / (reduced_value + TinyReal);
 }
 //=================================================================================================//
+RelaxationResidueNorm::RelaxationResidueNorm(SPHBody &sph_body)
+    : LocalDynamicsReduce<Real, ReduceSum<Real>>(sph_body, Real(0)),
+      RelaxDataDelegateSimple(sph_body),
+      residue_(*particles_->getVariableByName<Vecd>("ZeroOrderResidue")),
+      h_ref_(sph_body.sph_adaptation_->ReferenceSmoothingLength()) {}
+//=================================================================================================//
+Real RelaxationResidueNorm::reduce(size_t index_i, Real dt)
+{
+    return residue_[index_i].norm();
+}
+//=================================================================================================//
+Real RelaxationResidueNorm::outputResult(Real reduced_value)
+{
+    return reduced_value * h_ref_ / (Real(particles_->total_real_particles_) + TinyReal);
+}
+//=================================================================================================//
 PositionRelaxation::PositionRelaxation(SPHBody &sph_body)
     : LocalDynamics(sph_body), RelaxDataDelegateSimple(sph_body),
       sph_adaptation_(sph_body.sph_adaptation_), pos_(particles_->pos_),
@@ -73,6 +96,25 @@ void PositionRelaxation::update(size_t index_i, Real dt_square)
     pos_[index_i] += residue_[index_i] * dt_square * 0.5 / sph_adaptation_->SmoothingLengthRatio(index_i);
 }
 //=================================================================================================//
+RecordNeighborUpdatePosition::RecordNeighborUpdatePosition(SPHBody &sph_body)
+    : LocalDynamics(sph_body), RelaxDataDelegateSimple(sph_body), pos_(particles_->pos_),
+      pos_neighbor_update_(*particles_->registerSharedVariable<Vecd>("PositionAtNeighborUpdate")) {}
+//=================================================================================================//
+void RecordNeighborUpdatePosition::update(size_t index_i, Real dt)
+{
+    pos_neighbor_update_[index_i] = pos_[index_i];
+}
+//=================================================================================================//
+DisplacementSinceNeighborUpdate::DisplacementSinceNeighborUpdate(SPHBody &sph_body)
+    : LocalDynamicsReduce<Real, ReduceMax>(sph_body, Real(0)),
+      RelaxDataDelegateSimple(sph_body), pos_(particles_->pos_),
+      pos_neighbor_update_(*particles_->registerSharedVariable<Vecd>("PositionAtNeighborUpdate")) {}
+//=================================================================================================//
+Real DisplacementSinceNeighborUpdate::reduce(size_t index_i, Real dt)
+{
+    return (pos_[index_i] - pos_neighbor_update_[index_i]).norm();
+}
+//=================================================================================================//
 UpdateSmoothingLengthRatioByShape::
     UpdateSmoothingLengthRatioByShape(SPHBody &sph_body, Shape &target_shape)
     : LocalDynamics(sph_body), RelaxDataDelegateSimple(sph_body),
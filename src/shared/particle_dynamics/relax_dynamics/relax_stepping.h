@@ -82,11 +82,16 @@ class RelaxationResidue<Inner<LevelSetCorrection>> : public RelaxationResidue<In
     explicit RelaxationResidue(ConstructorArgs<BodyRelationType, FirstArg> parameters)
         : RelaxationResidue(parameters.body_relation_, std::get<0>(parameters.others_)){};
     virtual ~RelaxationResidue(){};
+    /** Probe the kernel gradient integrals for all particles in a batch. */
+    virtual void setupDynamics(Real dt = 0.0) override;
     void interaction(size_t index_i, Real dt = 0.0);
 
   protected:
     StdLargeVec<Vecd> &pos_;
     LevelSetShape &level_set_shape_;
+    const StdLargeVec<Real> *h_ratios_; /**< variable smoothing length ratios, nullptr if uniform. */
+    IndexVector probe_particles_;
+    StdLargeVec<Vecd> kernel_gradient_integral_;
 };
 
 template <>
@@ -118,6 +123,25 @@ class RelaxationScaling : public LocalDynamicsReduce<Real, ReduceMax>,
     Real h_ref_;
 };
 
+/**
+ * @class RelaxationResidueNorm
+ * @brief Mean residue norm scaled by the reference smoothing length,
+ * a dimensionless measure for the convergence of the relaxation.
+ */
+class RelaxationResidueNorm : public LocalDynamicsReduce<Real, ReduceSum<Real>>,
+                              public RelaxDataDelegateSimple
+{
+  public:
+    explicit RelaxationResidueNorm(SPHBody &sph_body);
+    virtual ~RelaxationResidueNorm(){};
+    Real reduce(size_t index_i, Real dt = 0.0);
+    virtual Real outputResult(Real reduced_value) override;
+
+  protected:
+    StdLargeVec<Vecd> &residue_;
+    Real h_ref_;
+};
+
 /**
  * @class PositionRelaxation
  * @brief update the particle position for a relaxation step
@@ -135,6 +159,38 @@ class PositionRelaxation : public LocalDynamics,
     void update(size_t index_i, Real scaling);
 };
 
+/**
+ * @class RecordNeighborUpdatePosition
+ * @brief Record the particle positions at an update of the neighbor lists.
+ */
+class RecordNeighborUpdatePosition : public LocalDynamics,
+                                     public RelaxDataDelegateSimple
+{
+  public:
+    explicit RecordNeighborUpdatePosition(SPHBody &sph_body);
+    virtual ~RecordNeighborUpdatePosition(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    StdLargeVec<Vecd> &pos_, &pos_neighbor_update_;
+};
+
+/**
+ * @class DisplacementSinceNeighborUpdate
+ * @brief Maximum particle displacement since the last update of the neighbor lists.
+ */
+class DisplacementSinceNeighborUpdate : public LocalDynamicsReduce<Real, ReduceMax>,
+                                        public RelaxDataDelegateSimple
+{
+  public:
+    explicit DisplacementSinceNeighborUpdate(SPHBody &sph_body);
+    virtual ~DisplacementSinceNeighborUpdate(){};
+    Real reduce(size_t index_i, Real dt = 0.0);
+
+  protected:
+    StdLargeVec<Vecd> &pos_, &pos_neighbor_update_;
+};
+
 class UpdateSmoothingLengthRatioByShape : public LocalDynamics,
                                           public RelaxDataDelegateSimple
 {
@@ -160,6 +216,17 @@ class RelaxationStep : public BaseDynamics<void>
     explicit RelaxationStep(FirstArg &&first_arg, OtherArgs &&...other_args);
     virtual ~RelaxationStep(){};
     SimpleDynamics<ShapeSurfaceBounding> &SurfaceBounding() { return surface_bounding_; };
+    RealBody &getRealBody() { return real_body_; };
+    /** The neighbor lists are reused until two particles may have approached each other by more than the skin,
+     * i.e. twice the maximum particle displacement since the last update, given as a fraction of
+     * the reference smoothing length. Meanwhile, the kernel values of the listed neighbors are re-evaluated
+     * every step, but the search radius is not enlarged by the skin, so that the neighbors entering
+     * the cut-off radius are missed until the next update. Hence, it is an approximation for
+     * the later stage of the relaxation, in which the particles move little.
+     * By default, the neighbor lists are updated every step. */
+    void setNeighborSkin(Real skin_ratio) { neighbor_skin_ = skin_ratio * real_body_.sph_adaptation_->ReferenceSmoothingLength(); };
+    /** required after particles are moved by other dynamics. */
+    void requestConfigurationUpdate() { max_displacement_ = MaxReal; };
     virtual void exec(Real dt = 0.0) override;
 
   protected:
@@ -170,6 +237,48 @@ class RelaxationStep : public BaseDynamics<void>
     SimpleDynamics<PositionRelaxation> position_relaxation_;
     NearShapeSurface near_shape_surface_;
     SimpleDynamics<ShapeSurfaceBounding> surface_bounding_;
+    SimpleDynamics<RecordNeighborUpdatePosition> record_neighbor_update_position_;
+    ReduceDynamics<DisplacementSinceNeighborUpdate> displacement_since_neighbor_update_;
+    Real neighbor_skin_;
+    Real max_displacement_; /**< maximum particle displacement since the last configuration update. */
+};
+
+/**
+ * @class RelaxationController
+ * @brief Carries out relaxation steps until the residue has converged, instead of a fixed number of steps.
+ * @details The mean residue norm is checked every check interval. The relaxation stops when it is
+ * below the tolerance or, after the minimum number of iterations, when it has decreased by less than
+ * the stagnation tolerance (relative) since the last check, i.e. it has reached the noise level of
+ * the particle distribution. The minimum number of iterations prevents stopping during the initial transient,
+ * in which the residue does not decrease monotonically.
+ * As for the relaxation step, the neighbor lists are updated every step unless a neighbor skin is set.
+ * For a large body, a warm start is obtained by relaxing a body with doubled particle spacing first
+ * and then generating the particles by ParticleGeneratorSplit from the relaxed coarse particles.
+ */
+template <class RelaxationStepType>
+class RelaxationController
+{
+  public:
+    explicit RelaxationController(RelaxationStepType &relaxation_step,
+                                  size_t max_iterations = 1000, Real tolerance = 1.0e-3);
+    virtual ~RelaxationController(){};
+    void setNeighborSkin(Real skin_ratio) { relaxation_step_.setNeighborSkin(skin_ratio); };
+    void setCheckInterval(size_t check_interval) { check_interval_ = SMAX(check_interval, size_t(1)); };
+    void setStagnationTolerance(Real stagnation_tolerance) { stagnation_tolerance_ = stagnation_tolerance; };
+    void setMinIterations(size_t min_iterations) { min_iterations_ = min_iterations; };
+    /** Returns the number of relaxation steps carried out. */
+    size_t exec();
+    Real ResidueNorm() { return residue_norm_; };
+
+  protected:
+    RelaxationStepType &relaxation_step_;
+    ReduceDynamics<RelaxationResidueNorm> relaxation_residue_norm_;
+    size_t max_iterations_;
+    size_t min_iterations_;
+    size_t check_interval_;
+    Real tolerance_;
+    Real stagnation_tolerance_;
+    Real residue_norm_; /**< obtained at the last check. */
 };
 
 using RelaxationStepInner = RelaxationStep<RelaxationResidue<Inner<>>>;
@@ -18,7 +18,12 @@ RelaxationResidue<Base, DataDelegationType>::RelaxationResidue(BaseRelationType
 template <typename... Args>
 RelaxationResidue<Inner<LevelSetCorrection>>::RelaxationResidue(Args &&...args)
     : RelaxationResidue<Inner<>>(std::forward<Args>(args)...), pos_(particles_->pos_),
-      level_set_shape_(DynamicCast<LevelSetShape>(this, this->getRelaxShape())){};
+      level_set_shape_(DynamicCast<LevelSetShape>(this, this->getRelaxShape())), h_ratios_(nullptr)
+{
+    ParticleWithLocalRefinement *local_refinement = dynamic_cast<ParticleWithLocalRefinement *>(sph_adaptation_);
+    if (local_refinement != nullptr)
+        h_ratios_ = &local_refinement->h_ratio_;
+};
 //=================================================================================================//
 template <class RelaxationResidueType>
 template <typename FirstArg, typename... OtherArgs>
@@ -30,20 +35,66 @@ RelaxationStep<RelaxationResidueType>::
       relaxation_residue_(first_arg, std::forward<OtherArgs>(other_args)...),
       relaxation_scaling_(real_body_), position_relaxation_(real_body_),
       near_shape_surface_(real_body_, DynamicCast<LevelSetShape>(this, relaxation_residue_.getRelaxShape())),
-      surface_bounding_(near_shape_surface_) {}
+      surface_bounding_(near_shape_surface_),
+      record_neighbor_update_position_(real_body_), displacement_since_neighbor_update_(real_body_),
+      neighbor_skin_(0.0), max_displacement_(MaxReal) {}
 //=================================================================================================//
 template <class RelaxationResidueType>
 void RelaxationStep<RelaxationResidueType>::exec(Real dt)
 {
-    real_body_.updateCellLinkedList();
-    for (size_t k = 0; k != body_relations_.size(); ++k)
+    if (2.0 * max_displacement_ >= neighbor_skin_)
+    {
+        real_body_.updateCellLinkedList();
+        for (size_t k = 0; k != body_relations_.size(); ++k)
+        {
+            body_relations_[k]->updateConfiguration();
+        }
+        if (neighbor_skin_ > 0.0)
+            record_neighbor_update_position_.exec();
+    }
+    else
     {
-        body_relations_[k]->updateConfiguration();
+        for (size_t k = 0; k != body_relations_.size(); ++k)
+        {
+            body_relations_[k]->refreshConfiguration();
+        }
     }
     relaxation_residue_.exec();
     Real scaling = relaxation_scaling_.exec();
     position_relaxation_.exec(scaling);
     surface_bounding_.exec();
+    max_displacement_ = neighbor_skin_ > 0.0 ? displacement_since_neighbor_update_.exec() : 0.0;
+}
+//=================================================================================================//
+template <class RelaxationStepType>
+RelaxationController<RelaxationStepType>::
+    RelaxationController(RelaxationStepType &relaxation_step, size_t max_iterations, Real tolerance)
+    : relaxation_step_(relaxation_step), relaxation_residue_norm_(relaxation_step.getRealBody()),
+      max_iterations_(max_iterations), min_iterations_(200), check_interval_(50), tolerance_(tolerance),
+      stagnation_tolerance_(0.01), residue_norm_(MaxReal) {}
+//=================================================================================================//
+template <class RelaxationStepType>
+size_t RelaxationController<RelaxationStepType>::exec()
+{
+    relaxation_step_.requestConfigurationUpdate();
+    Real previous_residue_norm = MaxReal;
+    size_t ite = 0;
+    while (ite < max_iterations_)
+    {
+        relaxation_step_.exec();
+        ite++;
+        if (ite % check_interval_ == 0)
+        {
+            residue_norm_ = relaxation_residue_norm_.exec();
+            bool is_stagnated = ite >= min_iterations_ &&
+                                previous_residue_norm - residue_norm_ < stagnation_tolerance_ * previous_residue_norm;
+            if (residue_norm_ < tolerance_ || is_stagnated)
+                break;
+            previous_residue_norm = residue_norm_;
+        }
+    }
+    relaxation_step_.requestConfigurationUpdate();
+    return ite;
 }
 //=================================================================================================//
 } // namespace relax_dynamics
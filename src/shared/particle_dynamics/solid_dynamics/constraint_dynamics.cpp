@@ -81,5 +81,29 @@ void PositionScaleSolidBody::update(size_t index_i, Real dt)
     }
 }
 //=================================================================================================//
+TransformLevelSetShapeBySimBody::
+    TransformLevelSetShapeBySimBody(SPHBody &sph_body, TransformedLevelSetShape &transformed_shape,
+                                    SimTK::MultibodySystem &MBsystem,
+                                    SimTK::MobilizedBody &mobod,
+                                    SimTK::RungeKuttaMersonIntegrator &integ)
+    : BaseDynamics<void>(sph_body), transformed_shape_(transformed_shape),
+      MBsystem_(MBsystem), mobod_(mobod), integ_(integ)
+{
+    const SimTK::State *simbody_state = &integ_.getState();
+    MBsystem_.realize(*simbody_state, SimTK::Stage::Acceleration);
+    initial_mobod_origin_location_ = mobod_.getBodyOriginLocation(*simbody_state);
+}
+//=================================================================================================//
+void TransformLevelSetShapeBySimBody::exec(Real dt)
+{
+    const SimTK::State *simbody_state = &integ_.getState();
+    MBsystem_.realize(*simbody_state, SimTK::Stage::Acceleration);
+    /** current position of a body frame point r0: p_GB + R_GB * (r0 - initial origin). */
+    Matd rotation = degradeToMatd(SimTKToEigen(SimTKMat33(mobod_.getBodyRotation(*simbody_state))));
+    Vecd origin = degradeToVecd(SimTKToEigen(mobod_.getBodyOriginLocation(*simbody_state)));
+    Vecd initial_origin = degradeToVecd(SimTKToEigen(initial_mobod_origin_location_));
+    transformed_shape_.setTransform(Transform(Rotation(rotation), origin - rotation * initial_origin));
+}
+//=================================================================================================//
 } // namespace solid_dynamics
 } // namespace SPH
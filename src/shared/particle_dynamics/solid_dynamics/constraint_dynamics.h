@@ -313,6 +313,32 @@ class ConstraintBySimBody : public BaseMotionConstraint<DynamicsIdentifier, Soli
 using ConstraintBodyBySimBody = ConstraintBySimBody<SPHBody>;
 using ConstraintBodyPartBySimBody = ConstraintBySimBody<BodyPartByParticle>;
 
+/**
+ * @class TransformLevelSetShapeBySimBody
+ * @brief Update the rigid transform of a level set shape from the motion computed by Simbody.
+ * @details The level set is built with the body at its initial position,
+ * which is taken as the body frame. The transform then follows the same rigid motion
+ * as the particles constrained by ConstraintBySimBody, without rebuilding the level set.
+ */
+class TransformLevelSetShapeBySimBody : public BaseDynamics<void>
+{
+  public:
+    TransformLevelSetShapeBySimBody(SPHBody &sph_body, TransformedLevelSetShape &transformed_shape,
+                                    SimTK::MultibodySystem &MBsystem,
+                                    SimTK::MobilizedBody &mobod,
+                                    SimTK::RungeKuttaMersonIntegrator &integ);
+    virtual ~TransformLevelSetShapeBySimBody(){};
+
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    TransformedLevelSetShape &transformed_shape_;
+    SimTK::MultibodySystem &MBsystem_;
+    SimTK::MobilizedBody &mobod_;
+    SimTK::RungeKuttaMersonIntegrator &integ_;
+    SimTKVec3 initial_mobod_origin_location_;
+};
+
 /**
  * @class TotalForceForSimBody
  * @brief Compute the force acting on the solid body part
@@ -115,15 +115,19 @@ class DeformationGradientBySummation : public LocalDynamics, public ElasticSolid
     {
         Vecd &pos_n_i = pos_[index_i];
 
-        Matd deformation = Matd::Zero();
-        Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-
-            Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            deformation -= (pos_n_i - pos_[index_j]) * gradW_ijV_j.transpose();
-        }
+        Matd deformation = onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                Matd summation = Matd::Zero();
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+
+                    Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    summation -= (pos_n_i - pos_[index_j]) * gradW_ijV_j.transpose();
+                }
+                return summation;
+            });
 
         F_[index_i] = deformation * B_[index_i];
     };
@@ -182,27 +186,29 @@ class Integration1stHalf : public BaseIntegration1stHalf
     inline void interaction(size_t index_i, Real dt = 0.0)
     {
         // including gravity and force from fluid
-        Vecd force = Vecd::Zero();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-            Vecd e_ij = inner_neighborhood.e_ij_[n];
-            Real r_ij = inner_neighborhood.r_ij_[n];
-            Real dim_r_ij_1 = Dimensions / r_ij;
-            Vecd pos_jump = pos_[index_i] - pos_[index_j];
-            Vecd vel_jump = vel_[index_i] - vel_[index_j];
-            Real strain_rate = dim_r_ij_1 * dim_r_ij_1 * pos_jump.dot(vel_jump);
-            Real weight = inner_neighborhood.W_ij_[n] * inv_W0_;
-            Matd numerical_stress_ij =
-                0.5 * (F_[index_i] + F_[index_j]) * elastic_solid_.PairNumericalDamping(strain_rate, smoothing_length_);
-            force += mass_[index_i] * inv_rho0_ * inner_neighborhood.dW_ijV_j_[n] *
-                            (stress_PK1_B_[index_i] + stress_PK1_B_[index_j] +
-                             numerical_dissipation_factor_ * weight * numerical_stress_ij) *
-                            e_ij;
-        }
-
-        force_[index_i] = force;
+        force_[index_i] = onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                Vecd force = Vecd::Zero();
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+                    Vecd e_ij = inner_neighborhood.e_ij_[n];
+                    Real r_ij = inner_neighborhood.r_ij_[n];
+                    Real dim_r_ij_1 = Dimensions / r_ij;
+                    Vecd pos_jump = pos_[index_i] - pos_[index_j];
+                    Vecd vel_jump = vel_[index_i] - vel_[index_j];
+                    Real strain_rate = dim_r_ij_1 * dim_r_ij_1 * pos_jump.dot(vel_jump);
+                    Real weight = inner_neighborhood.W_ij_[n] * inv_W0_;
+                    Matd numerical_stress_ij =
+                        0.5 * (F_[index_i] + F_[index_j]) * elastic_solid_.PairNumericalDamping(strain_rate, smoothing_length_);
+                    force += mass_[index_i] * inv_rho0_ * inner_neighborhood.dW_ijV_j_[n] *
+                             (stress_PK1_B_[index_i] + stress_PK1_B_[index_j] +
+                              numerical_dissipation_factor_ * weight * numerical_stress_ij) *
+                             e_ij;
+                }
+                return force;
+            });
     };
 
   protected:
@@ -271,18 +277,21 @@ class DecomposedIntegration1stHalf : public BaseIntegration1stHalf
     inline void interaction(size_t index_i, Real dt = 0.0)
     {
         // including gravity and force from fluid
-        Vecd force = Vecd::Zero();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-            Vecd shear_force_ij = correction_factor_ * elastic_solid_.ShearModulus() *
-                                  (J_to_minus_2_over_dimension_[index_i] + J_to_minus_2_over_dimension_[index_j]) *
-                                  (pos_[index_i] - pos_[index_j]) / inner_neighborhood.r_ij_[n];
-            force += mass_[index_i] * ((stress_on_particle_[index_i] + stress_on_particle_[index_j]) * inner_neighborhood.e_ij_[n] + shear_force_ij) *
-                            inner_neighborhood.dW_ijV_j_[n] * inv_rho0_;
-        }
-        force_[index_i] = force;
+        force_[index_i] = onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                Vecd force = Vecd::Zero();
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+                    Vecd shear_force_ij = correction_factor_ * elastic_solid_.ShearModulus() *
+                                          (J_to_minus_2_over_dimension_[index_i] + J_to_minus_2_over_dimension_[index_j]) *
+                                          (pos_[index_i] - pos_[index_j]) / inner_neighborhood.r_ij_[n];
+                    force += mass_[index_i] * ((stress_on_particle_[index_i] + stress_on_particle_[index_j]) * inner_neighborhood.e_ij_[n] + shear_force_ij) *
+                             inner_neighborhood.dW_ijV_j_[n] * inv_rho0_;
+                }
+                return force;
+            });
     };
 
   protected:
@@ -308,15 +317,19 @@ class Integration2ndHalf : public BaseElasticIntegration
     {
         const Vecd &vel_n_i = vel_[index_i];
 
-        Matd deformation_gradient_change_rate = Matd::Zero();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-
-            Vecd gradW_ij = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            deformation_gradient_change_rate -= (vel_n_i - vel_[index_j]) * gradW_ij.transpose();
-        }
+        Matd deformation_gradient_change_rate = onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                Matd summation = Matd::Zero();
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+
+                    Vecd gradW_ij = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    summation -= (vel_n_i - vel_[index_j]) * gradW_ij.transpose();
+                }
+                return summation;
+            });
 
         dF_dt_[index_i] = deformation_gradient_change_rate * B_[index_i];
     };
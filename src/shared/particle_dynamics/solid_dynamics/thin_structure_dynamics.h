@@ -114,13 +114,16 @@ class ShellCorrectConfiguration : public LocalDynamics, public ShellDataInner
     {
         /** A small number is added to diagonal to avoid dividing by zero. */
         Matd global_configuration = Eps * Matd::Identity();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            Vecd r_ji = -inner_neighborhood.r_ij_[n] * inner_neighborhood.e_ij_[n];
-            global_configuration += r_ji * gradW_ijV_j.transpose();
-        }
+        onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    Vecd r_ji = -inner_neighborhood.r_ij_[n] * inner_neighborhood.e_ij_[n];
+                    global_configuration += r_ji * gradW_ijV_j.transpose();
+                }
+            });
         Matd local_configuration =
             transformation_matrix_[index_i] * global_configuration * transformation_matrix_[index_i].transpose();
         /** correction matrix is obtained from local configuration. */
@@ -152,14 +155,17 @@ class ShellDeformationGradientTensor : public LocalDynamics, public ShellDataInn
 
         Matd deformation_part_one = Matd::Zero();
         Matd deformation_part_two = Matd::Zero();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-            Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            deformation_part_one -= (pos_n_i - pos_[index_j]) * gradW_ijV_j.transpose();
-            deformation_part_two -= ((pseudo_n_i - n0_[index_i]) - (pseudo_n_[index_j] - n0_[index_j])) * gradW_ijV_j.transpose();
-        }
+        onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+                    Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    deformation_part_one -= (pos_n_i - pos_[index_j]) * gradW_ijV_j.transpose();
+                    deformation_part_two -= ((pseudo_n_i - n0_[index_i]) - (pseudo_n_[index_j] - n0_[index_j])) * gradW_ijV_j.transpose();
+                }
+            });
         F_[index_i] = transformation_matrix_i * deformation_part_one * transformation_matrix_i.transpose() * B_[index_i];
         F_[index_i].col(Dimensions - 1) = transformation_matrix_i * pseudo_n_[index_i];
         F_bending_[index_i] = transformation_matrix_i * deformation_part_two * transformation_matrix_i.transpose() * B_[index_i];
@@ -211,38 +217,41 @@ class ShellStressRelaxationFirstHalf : public BaseShellRelaxation
 
         Vecd force = Vecd::Zero();
         Vecd pseudo_normal_acceleration = global_shear_stress_i;
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-
-            if (hourglass_control_)
+        onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
             {
-                Vecd e_ij = inner_neighborhood.e_ij_[n];
-                Real r_ij = inner_neighborhood.r_ij_[n];
-                Real weight = inner_neighborhood.W_ij_[n] * inv_W0_;
-                Vecd pos_jump = getLinearVariableJump(e_ij, r_ij, pos_[index_i],
-                                                      transformation_matrix_[index_i].transpose() * F_[index_i] * transformation_matrix_[index_i],
-                                                      pos_[index_j],
-                                                      transformation_matrix_[index_i].transpose() * F_[index_j] * transformation_matrix_[index_i]);
-                Real limiter_pos = SMIN(2.0 * pos_jump.norm() / r_ij, 1.0);
-                force += mass_[index_i] * hourglass_control_factor_ * weight * G0_ * pos_jump * Dimensions *
-                                inner_neighborhood.dW_ijV_j_[n] * limiter_pos;
-
-                Vecd pseudo_n_variation_i = pseudo_n_[index_i] - n0_[index_i];
-                Vecd pseudo_n_variation_j = pseudo_n_[index_j] - n0_[index_j];
-                Vecd pseudo_n_jump = getLinearVariableJump(e_ij, r_ij, pseudo_n_variation_i,
-                                                           transformation_matrix_[index_i].transpose() * F_bending_[index_i] * transformation_matrix_[index_i],
-                                                           pseudo_n_variation_j,
-                                                           transformation_matrix_[index_j].transpose() * F_bending_[index_j] * transformation_matrix_[index_j]);
-                Real limiter_pseudo_n = SMIN(2.0 * pseudo_n_jump.norm() / ((pseudo_n_variation_i - pseudo_n_variation_j).norm() + Eps), 1.0);
-                pseudo_normal_acceleration += hourglass_control_factor_ * weight * G0_ * pseudo_n_jump * Dimensions *
-                                              inner_neighborhood.dW_ijV_j_[n] * pow(thickness_[index_i], 2) * limiter_pseudo_n;
-            }
-
-            force += mass_[index_i] * (global_stress_i + global_stress_[index_j]) * inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            pseudo_normal_acceleration += (global_moment_i + global_moment_[index_j]) * inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-        }
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+
+                    if (hourglass_control_)
+                    {
+                        Vecd e_ij = inner_neighborhood.e_ij_[n];
+                        Real r_ij = inner_neighborhood.r_ij_[n];
+                        Real weight = inner_neighborhood.W_ij_[n] * inv_W0_;
+                        Vecd pos_jump = getLinearVariableJump(e_ij, r_ij, pos_[index_i],
+                                                              transformation_matrix_[index_i].transpose() * F_[index_i] * transformation_matrix_[index_i],
+                                                              pos_[index_j],
+                                                              transformation_matrix_[index_i].transpose() * F_[index_j] * transformation_matrix_[index_i]);
+                        Real limiter_pos = SMIN(2.0 * pos_jump.norm() / r_ij, 1.0);
+                        force += mass_[index_i] * hourglass_control_factor_ * weight * G0_ * pos_jump * Dimensions *
+                                        inner_neighborhood.dW_ijV_j_[n] * limiter_pos;
+
+                        Vecd pseudo_n_variation_i = pseudo_n_[index_i] - n0_[index_i];
+                        Vecd pseudo_n_variation_j = pseudo_n_[index_j] - n0_[index_j];
+                        Vecd pseudo_n_jump = getLinearVariableJump(e_ij, r_ij, pseudo_n_variation_i,
+                                                                   transformation_matrix_[index_i].transpose() * F_bending_[index_i] * transformation_matrix_[index_i],
+                                                                   pseudo_n_variation_j,
+                                                                   transformation_matrix_[index_j].transpose() * F_bending_[index_j] * transformation_matrix_[index_j]);
+                        Real limiter_pseudo_n = SMIN(2.0 * pseudo_n_jump.norm() / ((pseudo_n_variation_i - pseudo_n_variation_j).norm() + Eps), 1.0);
+                        pseudo_normal_acceleration += hourglass_control_factor_ * weight * G0_ * pseudo_n_jump * Dimensions *
+                                                      inner_neighborhood.dW_ijV_j_[n] * pow(thickness_[index_i], 2) * limiter_pseudo_n;
+                    }
+
+                    force += mass_[index_i] * (global_stress_i + global_stress_[index_j]) * inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    pseudo_normal_acceleration += (global_moment_i + global_moment_[index_j]) * inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                }
+            });
 
         force_[index_i] = force * inv_rho0_ / thickness_[index_i];
         dpseudo_n_d2t_[index_i] = pseudo_normal_acceleration * inv_rho0_ * 12.0 / pow(thickness_[index_i], 3);
@@ -296,15 +305,18 @@ class ShellStressRelaxationSecondHalf : public BaseShellRelaxation
 
         Matd deformation_gradient_change_rate_part_one = Matd::Zero();
         Matd deformation_gradient_change_rate_part_two = Matd::Zero();
-        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-
-            Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
-            deformation_gradient_change_rate_part_one -= (vel_n_i - vel_[index_j]) * gradW_ijV_j.transpose();
-            deformation_gradient_change_rate_part_two -= (dpseudo_n_dt_i - dpseudo_n_dt_[index_j]) * gradW_ijV_j.transpose();
-        }
+        onInnerNeighborhood(
+            index_i, [&](const auto &inner_neighborhood)
+            {
+                for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                {
+                    size_t index_j = inner_neighborhood.j_[n];
+
+                    Vecd gradW_ijV_j = inner_neighborhood.dW_ijV_j_[n] * inner_neighborhood.e_ij_[n];
+                    deformation_gradient_change_rate_part_one -= (vel_n_i - vel_[index_j]) * gradW_ijV_j.transpose();
+                    deformation_gradient_change_rate_part_two -= (dpseudo_n_dt_i - dpseudo_n_dt_[index_j]) * gradW_ijV_j.transpose();
+                }
+            });
         dF_dt_[index_i] = transformation_matrix_i * deformation_gradient_change_rate_part_one * transformation_matrix_i.transpose() * B_[index_i];
         dF_dt_[index_i].col(Dimensions - 1) = transformation_matrix_i * dpseudo_n_dt_[index_i];
         dF_bending_dt_[index_i] = transformation_matrix_i * deformation_gradient_change_rate_part_two * transformation_matrix_i.transpose() * B_[index_i];
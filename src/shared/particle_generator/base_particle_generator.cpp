@@ -1,6 +1,7 @@
 #include "base_particle_generator.h"
 
 #include "base_body.h"
+#include "base_geometry.h"
 #include "base_particles.h"
 #include "io_all.h"
 
@@ -81,4 +82,27 @@ void ParticleGenerator<Reload>::generateParticlesWithBasicVariables()
     base_particles_.real_particles_bound_ = base_particles_.total_real_particles_;
 }
 //=================================================================================================//
+ParticleGenerator<Split>::ParticleGenerator(SPHBody &sph_body, BaseParticles &coarse_particles)
+    : ParticleGenerator<Base>(sph_body), initial_shape_(*sph_body.initial_shape_),
+      coarse_particles_(coarse_particles) {}
+//=================================================================================================//
+void ParticleGenerator<Split>::initializeGeometricVariables()
+{
+    int number_of_children = 1 << Dimensions;
+    for (size_t i = 0; i != coarse_particles_.total_real_particles_; ++i)
+    {
+        Real coarse_volume = coarse_particles_.Vol_[i];
+        Real offset = 0.25 * pow(coarse_volume, 1.0 / Real(Dimensions));
+        for (int n = 0; n != number_of_children; ++n)
+        {
+            Vecd position = coarse_particles_.pos_[i];
+            for (int k = 0; k != Dimensions; ++k)
+                position[k] += (n >> k) & 1 ? offset : -offset;
+
+            if (initial_shape_.checkContain(position))
+                initializePositionAndVolumetricMeasure(position, coarse_volume / Real(number_of_children));
+        }
+    }
+}
+//=================================================================================================//
 } // namespace SPH
@@ -44,6 +44,7 @@ namespace SPH
 
 class SPHBody;
 class BaseParticles;
+class Shape;
 //---------------------------------------------------------------------------
 // Geometric types of particles. The default type is volume metric particles.
 //---------------------------------------------------------------------------
@@ -51,6 +52,7 @@ class Surface;
 class ThickSurface; // Surface thickness equal or larger than the particle spacing
 class Observer;
 class Reload;
+class Split;
 
 template <typename... Parameters>
 class ParticleGenerator;
@@ -120,5 +122,21 @@ class ParticleGenerator<Reload> : public ParticleGenerator<Base>
 };
 using ParticleGeneratorReload = ParticleGenerator<Reload>;
 
+/** Generate particles by splitting each particle of a coarser body into 2^d particles with
+ * halved spacing, only the ones within the body shape are kept. Used as warm start for
+ * the relaxation of a large body with the particles relaxed at a coarser resolution. */
+template <>
+class ParticleGenerator<Split> : public ParticleGenerator<Base>
+{
+    Shape &initial_shape_;
+    BaseParticles &coarse_particles_;
+
+  public:
+    ParticleGenerator(SPHBody &sph_body, BaseParticles &coarse_particles);
+    virtual ~ParticleGenerator(){};
+    virtual void initializeGeometricVariables() override;
+};
+using ParticleGeneratorSplit = ParticleGenerator<Split>;
+
 } // namespace SPH
 #endif // BASE_PARTICLE_GENERATOR_H
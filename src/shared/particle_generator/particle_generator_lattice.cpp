@@ -2,6 +2,7 @@
 
 #include "adaptation.h"
 #include "base_body.h"
+#include "base_mesh.h"
 #include "complex_shape.h"
 #include "solid_particles.h"
 
@@ -21,6 +22,74 @@ GeneratingMethod<Lattice>::GeneratingMethod(SPHBody &sph_body)
     }
 }
 //=================================================================================================//
+StdVec<Vecd> GeneratingMethod<Lattice>::findLatticePositionsInShape()
+{
+    BaseMesh mesh(domain_bounds_, lattice_spacing_, 0);
+    Arrayi number_of_lattices = mesh.AllCellsFromAllGridPoints(mesh.AllGridPoints());
+    /** Only the lattice points within the shape bounds with a margin are scanned. */
+    BoundingBox shape_bounds = initial_shape_.getBounds();
+    Arrayi lower = (mesh.CellIndexFromPosition(shape_bounds.first_) - Arrayi::Ones()).max(Arrayi::Zero());
+    Arrayi upper = (mesh.CellIndexFromPosition(shape_bounds.second_) + 2 * Arrayi::Ones()).min(number_of_lattices);
+    Arrayi scan_size = (upper - lower).max(Arrayi::Zero());
+    Arrayi number_of_blocks = (scan_size + (block_size_ - 1) * Arrayi::Ones()) / block_size_;
+
+    /** block state: -1 fully inside, 1 fully outside, 0 straddling the surface. */
+    StdVec<int> block_state(number_of_blocks.prod(), 0);
+    parallel_for(
+        IndexRange(0, block_state.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                Arrayi first = lower + block_size_ * mesh.transfer1DtoMeshIndex(number_of_blocks, n);
+                Arrayi last = (first + (block_size_ - 1) * Arrayi::Ones()).min(upper - Arrayi::Ones());
+                Vecd block_center = 0.5 * (mesh.CellPositionFromIndex(first) + mesh.CellPositionFromIndex(last));
+                Real block_radius = 0.5 * (last - first).cast<Real>().matrix().norm() * lattice_spacing_ + lattice_spacing_;
+                Real phi = initial_shape_.findSignedDistance(block_center);
+                block_state[n] = phi < -block_radius ? -1 : (phi > block_radius ? 1 : 0);
+            }
+        },
+        ap);
+
+    /** Slabs of one block layer along the first axis are scanned in parallel with thread-local buffers. */
+    StdVec<StdVec<Vecd>> slab_positions(number_of_blocks[0]);
+    parallel_for(
+        IndexRange(0, slab_positions.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t slab = r.begin(); slab != r.end(); ++slab)
+            {
+                Arrayi slab_size = scan_size;
+                slab_size[0] = SMIN(block_size_, scan_size[0] - int(slab) * block_size_);
+                Arrayi slab_lower = lower;
+                slab_lower[0] += int(slab) * block_size_;
+                StdVec<Vecd> &positions = slab_positions[slab];
+                for (size_t l = 0; l != size_t(slab_size.prod()); ++l)
+                {
+                    Arrayi lattice = slab_lower + mesh.transfer1DtoMeshIndex(slab_size, l);
+                    Arrayi block = (lattice - lower) / block_size_;
+                    int state = block_state[mesh.transferMeshIndexTo1D(number_of_blocks, block)];
+                    if (state == 1)
+                        continue;
+
+                    Vecd lattice_position = mesh.CellPositionFromIndex(lattice);
+                    if (state == -1 || initial_shape_.checkContain(lattice_position))
+                        positions.push_back(lattice_position);
+                }
+            }
+        },
+        ap);
+
+    size_t total_positions = 0;
+    for (size_t slab = 0; slab != slab_positions.size(); ++slab)
+        total_positions += slab_positions[slab].size();
+    StdVec<Vecd> lattice_positions;
+    lattice_positions.reserve(total_positions);
+    for (size_t slab = 0; slab != slab_positions.size(); ++slab)
+        lattice_positions.insert(lattice_positions.end(), slab_positions[slab].begin(), slab_positions[slab].end());
+    return lattice_positions;
+}
+//=================================================================================================//
 ParticleGenerator<Lattice>::ParticleGenerator(SPHBody &sph_body)
     : ParticleGenerator<Base>(sph_body), GeneratingMethod<Lattice>(sph_body) {}
 //=================================================================================================//
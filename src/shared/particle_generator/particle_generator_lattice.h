@@ -50,6 +50,14 @@ class GeneratingMethod<Lattice>
     Real lattice_spacing_;      /**< Initial particle spacing. */
     BoundingBox domain_bounds_; /**< Domain bounds. */
     Shape &initial_shape_;         /**< Geometry shape for body. */
+    /** Lattice points are classified in blocks with block_size_ points along each axis
+     * as fully inside, fully outside or straddling the surface by one signed distance query,
+     * only the points in straddling blocks are checked one by one. */
+    static constexpr int block_size_ = 8;
+
+    /** Find the lattice positions contained by the initial shape in parallel.
+     * The positions are given in the same order as a serial scan over the lattice. */
+    StdVec<Vecd> findLatticePositionsInShape();
 };
 
 template <>
@@ -0,0 +1,115 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	inner_interaction_plan.h
+ * @brief 	Compiled read-only inner neighbor data for bodies with fixed topology.
+ * @details For total Lagrangian solids, shells and trees, the inner configuration is built
+ *			once from the initial configuration and never changes afterwards.
+ *			The plan keeps the neighbor data of all particles in contiguous arrays (CSR),
+ *			with 32-bit neighbor indices and the neighbors of each particle sorted by index
+ *			so that the gathered particle data is visited in memory order.
+ *			The scalar neighbor data are stored in Real or, chosen per relation, in SingleReal,
+ *			and are read as Real in both cases.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef INNER_INTERACTION_PLAN_H
+#define INNER_INTERACTION_PLAN_H
+
+#include "neighborhood.h"
+
+#include <cstdint>
+
+namespace SPH
+{
+/** Storage type of the neighbor index in a plan. */
+using NeighborIndex = std::uint32_t;
+
+/**
+ * @struct PlannedScalars
+ * @brief Scalar neighbor data of a particle in a plan, read as Real whatever the storage type.
+ */
+template <typename ScalarType>
+struct PlannedScalars
+{
+    const ScalarType *data_;
+    Real operator[](size_t n) const { return Real(data_[n]); };
+};
+
+/**
+ * @struct PlannedNeighborhood
+ * @brief The neighbors of a particle in a plan, with the same interface
+ * for reading as Neighborhood so that the neighbor loops are shared.
+ */
+template <typename ScalarType>
+struct PlannedNeighborhood
+{
+    size_t current_size_;
+    const NeighborIndex *j_;
+    PlannedScalars<ScalarType> W_ij_;
+    PlannedScalars<ScalarType> dW_ijV_j_;
+    PlannedScalars<ScalarType> r_ij_;
+    const Vecd *e_ij_;
+};
+
+/**
+ * @class InnerInteractionPlan
+ * @brief Inner neighbor data of all particles in compressed sparse row storage.
+ */
+template <typename ScalarType>
+class InnerInteractionPlan
+{
+  public:
+    InnerInteractionPlan() : is_compiled_(false){};
+
+    /** Copy the neighbors of the first particles from the configuration. */
+    void compile(const ParticleConfiguration &configuration, size_t total_particles);
+    bool isCompiled() const { return is_compiled_; };
+    size_t NumberOfParticles() const { return is_compiled_ ? offsets_.size() - 1 : 0; };
+    size_t NumberOfPairs() const { return j_.size(); };
+    size_t MemoryBytes() const
+    {
+        return offsets_.capacity() * sizeof(size_t) + j_.capacity() * sizeof(NeighborIndex) +
+               (W_ij_.capacity() + dW_ijV_j_.capacity() + r_ij_.capacity()) * sizeof(ScalarType) +
+               e_ij_.capacity() * sizeof(Vecd);
+    };
+
+    PlannedNeighborhood<ScalarType> operator[](size_t index_i) const
+    {
+        size_t begin = offsets_[index_i];
+        return PlannedNeighborhood<ScalarType>{
+            offsets_[index_i + 1] - begin, j_.data() + begin, {W_ij_.data() + begin},
+            {dW_ijV_j_.data() + begin}, {r_ij_.data() + begin}, e_ij_.data() + begin};
+    };
+
+  protected:
+    bool is_compiled_;
+    StdLargeVec<size_t> offsets_;
+    StdLargeVec<NeighborIndex> j_;
+    StdLargeVec<ScalarType> W_ij_;
+    StdLargeVec<ScalarType> dW_ijV_j_;
+    StdLargeVec<ScalarType> r_ij_;
+    StdLargeVec<Vecd> e_ij_;
+};
+} // namespace SPH
+#endif // INNER_INTERACTION_PLAN_H
@@ -0,0 +1,73 @@
+/**
+ * @file 	inner_interaction_plan.hpp
+ * @brief 	Implementation of the template inner interaction plan.
+ * @author	Xiangyu Hu
+ */
+
+#pragma once
+
+#include "inner_interaction_plan.h"
+#include "scratch_arena.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace SPH
+{
+//=================================================================================================//
+template <typename ScalarType>
+void InnerInteractionPlan<ScalarType>::compile(const ParticleConfiguration &configuration, size_t total_particles)
+{
+    if (total_particles > size_t(std::numeric_limits<NeighborIndex>::max()))
+    {
+        std::cout << "\n Error: " << total_particles
+                  << " particles exceed the neighbor index range of an interaction plan!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    offsets_.resize(total_particles + 1);
+    offsets_[0] = 0;
+    for (size_t i = 0; i != total_particles; ++i)
+        offsets_[i + 1] = offsets_[i] + configuration[i].current_size_;
+
+    /** exact sizes, as the plan is not changed anymore */
+    size_t number_of_pairs = offsets_[total_particles];
+    StdLargeVec<NeighborIndex>(number_of_pairs).swap(j_);
+    StdLargeVec<ScalarType>(number_of_pairs).swap(W_ij_);
+    StdLargeVec<ScalarType>(number_of_pairs).swap(dW_ijV_j_);
+    StdLargeVec<ScalarType>(number_of_pairs).swap(r_ij_);
+    StdLargeVec<Vecd>(number_of_pairs).swap(e_ij_);
+
+    parallel_for(
+        IndexRange(0, total_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                const Neighborhood &neighborhood = configuration[i];
+                size_t size = neighborhood.current_size_;
+                ScratchScope scratch_scope;
+                size_t *order = scratch_scope.allocate<size_t>(size);
+                std::iota(order, order + size, 0);
+                std::sort(order, order + size, [&](size_t a, size_t b)
+                          { return neighborhood.j_[a] < neighborhood.j_[b]; });
+
+                size_t begin = offsets_[i];
+                for (size_t k = 0; k != size; ++k)
+                {
+                    size_t n = order[k];
+                    j_[begin + k] = NeighborIndex(neighborhood.j_[n]);
+                    W_ij_[begin + k] = neighborhood.W_ij_[n];
+                    dW_ijV_j_[begin + k] = neighborhood.dW_ijV_j_[n];
+                    r_ij_[begin + k] = neighborhood.r_ij_[n];
+                    e_ij_[begin + k] = neighborhood.e_ij_[n];
+                }
+            }
+        },
+        ap);
+    is_compiled_ = true;
+}
+//=================================================================================================//
+} // namespace SPH
@@ -32,6 +32,7 @@
 #include "base_particles.hpp"
 #include "diffusion_reaction_particles.h"
 #include "observer_particles.h"
+#include "particle_data_view.h"
 #include "solid_particles.h"
 #include "solid_particles_variable.h"
 #include "continuum_particles.h"
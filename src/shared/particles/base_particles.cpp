@@ -4,8 +4,11 @@
 #include "base_body_part.h"
 #include "base_material.h"
 #include "base_particle_generator.h"
+#include "scratch_arena.h"
 #include "xml_parser.h"
 
+#include "tbb/parallel_sort.h"
+
 //=====================================================================================================//
 namespace SPH
 {
@@ -16,7 +19,8 @@ BaseParticles::BaseParticles(SPHBody &sph_body, BaseMaterial *base_material)
       sph_body_(sph_body), body_name_(sph_body.getName()),
       base_material_(*base_material),
       restart_xml_parser_("xml_restart", "particles"),
-      reload_xml_parser_("xml_particle_reload", "particles")
+      reload_xml_parser_("xml_particle_reload", "particles"),
+      total_created_particles_(0), data_allocation_version_(0)
 {
     //----------------------------------------------------------------------
     //		register geometric data only
@@ -72,6 +76,7 @@ void BaseParticles::addAParticleEntry()
     sequence_.push_back(0);
 
     add_particle_data_with_default_value_(all_particle_data_);
+    data_allocation_version_++;
 }
 //=================================================================================================//
 void BaseParticles::addBufferParticles(size_t buffer_size)
@@ -114,6 +119,26 @@ size_t BaseParticles::insertAGhostParticle(size_t index)
     return expected_particle_index;
 }
 //=================================================================================================//
+size_t BaseParticles::reserveGhostParticles(size_t number_of_ghosts)
+{
+    size_t first_ghost_index = real_particles_bound_ + total_ghost_particles_;
+    total_ghost_particles_ += number_of_ghosts;
+    size_t expected_size = real_particles_bound_ + total_ghost_particles_;
+    while (pos_.size() < expected_size)
+    {
+        addAParticleEntry();
+    }
+    return first_ghost_index;
+}
+//=================================================================================================//
+void BaseParticles::updateGhostParticle(size_t ghost_index, size_t index)
+{
+    bool is_ghost_data_selected = !std::get<DataTypeIndex<Vecd>::value>(ghost_data_).empty();
+    copy_particle_data_(is_ghost_data_selected ? ghost_data_ : all_particle_data_, ghost_index, index);
+    /** For a ghost particle, its sorted id is that of corresponding real particle. */
+    sorted_id_[ghost_index] = index;
+}
+//=================================================================================================//
 void BaseParticles::switchToBufferParticle(size_t index)
 {
     size_t last_real_particle_index = total_real_particles_ - 1;
@@ -127,6 +152,65 @@ void BaseParticles::switchToBufferParticle(size_t index)
     total_real_particles_ -= 1;
 }
 //=================================================================================================//
+size_t BaseParticles::createParticleFrom(size_t index)
+{
+    size_t new_index = total_real_particles_ + total_created_particles_.fetch_add(1, std::memory_order_relaxed);
+    if (new_index >= real_particles_bound_)
+    {
+        std::cout << "\n Error: not enough body buffer particles for " << body_name_ << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    copyFromAnotherParticle(new_index, index);
+    return new_index;
+}
+//=================================================================================================//
+void BaseParticles::commitParticleCreationAndDeletion()
+{
+    total_real_particles_ += total_created_particles_.exchange(0);
+
+    size_t total_deleted = particles_to_delete_.size();
+    if (total_deleted == 0)
+        return;
+
+    ScratchScope scratch_scope;
+    size_t *deleted = scratch_scope.allocate<size_t>(total_deleted);
+    std::copy(particles_to_delete_.begin(), particles_to_delete_.end(), deleted);
+    particles_to_delete_.clear();
+    tbb::parallel_sort(deleted, deleted + total_deleted);
+    size_t remaining_real_particles = total_real_particles_ - total_deleted;
+    /** Deleted particles before the new bound are gaps, which are filled by the
+     * remaining particles behind the bound. Both are equally many and are paired in order. */
+    size_t total_gaps = std::lower_bound(deleted, deleted + total_deleted, remaining_real_particles) - deleted;
+    size_t *movers = scratch_scope.allocate<size_t>(total_gaps);
+    size_t deleted_behind = total_gaps;
+    size_t total_movers = 0;
+    for (size_t index = remaining_real_particles; index != total_real_particles_; ++index)
+    {
+        if (deleted_behind != total_deleted && deleted[deleted_behind] == index)
+            ++deleted_behind;
+        else
+            movers[total_movers++] = index;
+    }
+
+    parallel_for(
+        IndexRange(0, total_gaps),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+            {
+                size_t gap = deleted[k];
+                size_t mover = movers[k];
+                updateFromAnotherParticle(gap, mover);
+                std::swap(unsorted_id_[gap], unsorted_id_[mover]);
+                sorted_id_[unsorted_id_[gap]] = gap;
+                sorted_id_[unsorted_id_[mover]] = mover;
+            }
+        },
+        ap);
+    total_real_particles_ = remaining_real_particles;
+}
+//=================================================================================================//
 void BaseParticles::writePltFileHeader(std::ofstream &output_file)
 {
     output_file << " VARIABLES = \"x\",\"y\",\"z\",\"ID\"";
@@ -151,6 +235,11 @@ void BaseParticles::writePltFileHeader(std::ofstream &output_file)
     {
         output_file << ",\"" << variable->Name() << "\"";
     };
+    constexpr int type_index_SingleReal = DataTypeIndex<SingleReal>::value;
+    for (DiscreteVariable<SingleReal> *variable : std::get<type_index_SingleReal>(variables_to_write_))
+    {
+        output_file << ",\"" << variable->Name() << "\"";
+    };
 }
 //=================================================================================================//
 void BaseParticles::computeDerivedVariables()
@@ -189,6 +278,12 @@ void BaseParticles::writePltFileParticleData(std::ofstream &output_file, size_t
         StdLargeVec<Real> &variable_data = *(std::get<type_index_Real>(all_particle_data_)[variable->IndexInContainer()]);
         output_file << variable_data[index] << " ";
     };
+    constexpr int type_index_SingleReal = DataTypeIndex<SingleReal>::value;
+    for (DiscreteVariable<SingleReal> *variable : std::get<type_index_SingleReal>(variables_to_write_))
+    {
+        StdLargeVec<SingleReal> &variable_data = *(std::get<type_index_SingleReal>(all_particle_data_)[variable->IndexInContainer()]);
+        output_file << variable_data[index] << " ";
+    };
 }
 //=================================================================================================//
 void BaseParticles::writeParticlesToPltFile(std::ofstream &output_file)
@@ -301,6 +396,22 @@ void BaseParticles::writeSurfaceParticlesToVtuFile(std::ostream &output_file, Bo
         output_file << "    </DataArray>\n";
     }
 
+    // write scalars stored in single precision
+    constexpr int type_index_SingleReal = DataTypeIndex<SingleReal>::value;
+    for (DiscreteVariable<SingleReal> *variable : std::get<type_index_SingleReal>(variables_to_write_))
+    {
+        StdLargeVec<SingleReal> &variable_data = *(std::get<type_index_SingleReal>(all_particle_data_)[variable->IndexInContainer()]);
+        output_file << "    <DataArray Name=\"" << variable->Name() << "\" type=\"Float32\" Format=\"ascii\">\n";
+        output_file << "    ";
+        for (size_t i = 0; i != total_surface_particles; ++i)
+        {
+            size_t particle_i = surface_particles.body_part_particles_[i];
+            output_file << std::fixed << std::setprecision(9) << variable_data[particle_i] << " ";
+        }
+        output_file << std::endl;
+        output_file << "    </DataArray>\n";
+    }
+
     // write integers
     constexpr int type_index_int = DataTypeIndex<int>::value;
     for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables_to_write_))
@@ -363,6 +474,7 @@ void BaseParticles::readFromXmlForReloadParticle(std::string &filefullpath)
         unsorted_id_.push_back(i);
     };
     resize_particle_data_(all_particle_data_, total_real_particles_);
+    data_allocation_version_++;
     ReadAParticleVariableFromXml read_variable_from_xml(reload_xml_parser_, total_real_particles_);
     DataAssembleOperation<loopParticleVariables> loop_variable_namelist;
     loop_variable_namelist(all_particle_data_, variables_to_reload_, read_variable_from_xml);
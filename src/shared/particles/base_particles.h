@@ -38,6 +38,7 @@
 #include "sph_data_containers.h"
 #include "xml_parser.h"
 
+#include <atomic>
 #include <fstream>
 
 namespace SPH
@@ -106,6 +107,9 @@ class BaseParticles
     size_t total_real_particles_;
     size_t real_particles_bound_; /**< Maximum possible number of real particles. Also start index of ghost particles. */
     size_t total_ghost_particles_;
+    /** Increased whenever the particle data are extended, which may reallocate them,
+     * so that addresses of the particle data taken before are invalid. */
+    size_t DataAllocationVersion() { return data_allocation_version_; };
 
     SPHBody &getSPHBody() { return sph_body_; };
     BaseMaterial &getBaseMaterial() { return base_material_; };
@@ -119,8 +123,27 @@ class BaseParticles
     void copyFromAnotherParticle(size_t index, size_t another_index);
     void updateFromAnotherParticle(size_t index, size_t another_index);
     size_t insertAGhostParticle(size_t index);
+    /** Reserve continuous ghost particles, the particle data are extended only if the capacity is exceeded.
+     * Return the index of the first reserved ghost particle. Not thread safe. */
+    size_t reserveGhostParticles(size_t number_of_ghosts);
+    /** Copy the ghost-visible data of a real particle to a ghost particle, thread safe for distinct ghosts. */
+    void updateGhostParticle(size_t ghost_index, size_t index);
     void switchToBufferParticle(size_t index);
     //----------------------------------------------------------------------
+    //		Bulk particle creation and deletion
+    //		Particle dynamics may create and delete particles concurrently within a loop.
+    //		A created particle is a copy in a reserved buffer particle and
+    //		a deleted particle is only marked, so that the real particles stay unchanged
+    //		until all changes are committed together after the loop.
+    //----------------------------------------------------------------------
+    /** Copy the particle into a reserved buffer particle, thread safe. Return the new index. */
+    size_t createParticleFrom(size_t index);
+    /** Mark a real particle for deletion, thread safe. A particle should be marked once. */
+    void markParticleForDeletion(size_t index) { particles_to_delete_.push_back(index); };
+    /** Realize the created particles and move the deleted ones into the buffer,
+     * the remaining real particles are kept continuous by moving the last ones into the gaps. */
+    void commitParticleCreationAndDeletion();
+    //----------------------------------------------------------------------
     //		Parameterized management on generalized particle data
     //----------------------------------------------------------------------
     template <typename DataType>
@@ -170,6 +193,18 @@ class BaseParticles
 
     template <typename DataType>
     void registerSortableVariable(const std::string &variable_name);
+    //----------------------------------------------------------------------
+    //		Particle data visible through ghost particles
+    //		By default, ghost particles carry all particle data.
+    //		Once ghost variables are registered, only these and the geometric data,
+    //		i.e. position, volume and smoothing length ratio, are copied to ghost particles.
+    //		The variables read from neighbors by all interactions with ghost particles should be registered.
+    //----------------------------------------------------------------------
+    ParticleData ghost_data_;
+    ParticleVariables ghost_variables_;
+
+    template <typename DataType>
+    void registerGhostVariable(const std::string &variable_name);
     template <typename SequenceMethod>
     void sortParticles(SequenceMethod &sequence_method);
     //----------------------------------------------------------------------
@@ -205,6 +240,9 @@ class BaseParticles
     ParticleVariables variables_to_restart_;
     ParticleVariables variables_to_reload_;
     StdVec<BaseDynamics<void> *> derived_variables_;
+    std::atomic<size_t> total_created_particles_; /**< created but not yet committed */
+    ConcurrentIndexVector particles_to_delete_;   /**< marked but not yet committed */
+    size_t data_allocation_version_;
 
     void addAParticleEntry(); /**< Add a particle entry to the particle array. */
     virtual void writePltFileHeader(std::ofstream &output_file);
@@ -194,6 +194,48 @@ void BaseParticles::registerSortableVariable(const std::string &variable_name)
     }
 }
 //=================================================================================================//
+template <typename DataType>
+void BaseParticles::registerGhostVariable(const std::string &variable_name)
+{
+    DiscreteVariable<DataType> *variable = findVariableByName<DataType>(all_discrete_variables_, variable_name);
+
+    if (variable != nullptr)
+    {
+        if (findVariableByName<Vecd>(ghost_variables_, "Position") == nullptr)
+        {
+            DiscreteVariable<Vecd> *position = findVariableByName<Vecd>(all_discrete_variables_, "Position");
+            std::get<DataTypeIndex<Vecd>::value>(ghost_variables_).push_back(position);
+            std::get<DataTypeIndex<Vecd>::value>(ghost_data_).push_back(&pos_);
+            for (const std::string &name : {"VolumetricMeasure", "SmoothingLengthRatio"})
+            {
+                DiscreteVariable<Real> *geometric_data = findVariableByName<Real>(all_discrete_variables_, name);
+                if (geometric_data != nullptr)
+                {
+                    std::get<DataTypeIndex<Real>::value>(ghost_variables_).push_back(geometric_data);
+                    std::get<DataTypeIndex<Real>::value>(ghost_data_)
+                        .push_back(std::get<DataTypeIndex<Real>::value>(all_particle_data_)[geometric_data->IndexInContainer()]);
+                }
+            }
+        }
+
+        DiscreteVariable<DataType> *listed_variable = findVariableByName<DataType>(ghost_variables_, variable_name);
+
+        if (listed_variable == nullptr)
+        {
+            constexpr int type_index = DataTypeIndex<DataType>::value;
+            std::get<type_index>(ghost_variables_).push_back(variable);
+            StdLargeVec<DataType> *variable_data = std::get<type_index>(all_particle_data_)[variable->IndexInContainer()];
+            std::get<type_index>(ghost_data_).push_back(variable_data);
+        }
+    }
+    else
+    {
+        std::cout << "\n Error: the ghost variable '" << variable_name << "' is not particle data!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
 template <typename SequenceMethod>
 void BaseParticles::sortParticles(SequenceMethod &sequence_method)
 {
@@ -287,6 +329,21 @@ void BaseParticles::writeParticlesToVtk(StreamType &output_stream)
         output_stream << "    </DataArray>\n";
     }
 
+    // write scalars stored in single precision
+    constexpr int type_index_SingleReal = DataTypeIndex<SingleReal>::value;
+    for (DiscreteVariable<SingleReal> *variable : std::get<type_index_SingleReal>(variables_to_write_))
+    {
+        StdLargeVec<SingleReal> &variable_data = *(std::get<type_index_SingleReal>(all_particle_data_)[variable->IndexInContainer()]);
+        output_stream << "    <DataArray Name=\"" << variable->Name() << "\" type=\"Float32\" Format=\"ascii\">\n";
+        output_stream << "    ";
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            output_stream << std::fixed << std::setprecision(9) << variable_data[i] << " ";
+        }
+        output_stream << std::endl;
+        output_stream << "    </DataArray>\n";
+    }
+
     // write vectors
     constexpr int type_index_Vecd = DataTypeIndex<Vecd>::value;
     for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables_to_write_))
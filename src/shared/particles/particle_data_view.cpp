@@ -0,0 +1,58 @@
+#include "particle_data_view.h"
+
+#include "base_body.h"
+
+namespace SPH
+{
+//=================================================================================================//
+ParticleDataView::ParticleDataView(BaseParticles &base_particles)
+    : base_particles_(base_particles) {}
+//=================================================================================================//
+std::string ParticleDataView::BodyName()
+{
+    return base_particles_.getSPHBody().getName();
+}
+//=================================================================================================//
+StdVec<ParticleVariableView> ParticleDataView::AllVariableViews()
+{
+    StdVec<ParticleVariableView> views;
+    collect_variable_views_(base_particles_.getAllParticleData(), base_particles_.AllDiscreteVariables(),
+                            base_particles_.total_real_particles_, base_particles_.DataAllocationVersion(), views);
+    return views;
+}
+//=================================================================================================//
+StdVec<std::string> ParticleDataView::VariableNames()
+{
+    StdVec<std::string> variable_names;
+    for (ParticleVariableView &view : AllVariableViews())
+        variable_names.push_back(view.name_);
+    return variable_names;
+}
+//=================================================================================================//
+bool ParticleDataView::hasVariable(const std::string &variable_name)
+{
+    for (ParticleVariableView &view : AllVariableViews())
+        if (view.name_ == variable_name)
+            return true;
+    return false;
+}
+//=================================================================================================//
+ParticleVariableView ParticleDataView::getVariableView(const std::string &variable_name)
+{
+    for (ParticleVariableView &view : AllVariableViews())
+        if (view.name_ == variable_name)
+            return view;
+
+    std::cout << "\n Error: the variable '" << variable_name << "' is not registered for "
+              << BodyName() << "!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+ParticleVariableView ParticleDataView::OriginalParticleIds()
+{
+    return makeParticleVariableView("OriginalParticleIds", base_particles_.unsorted_id_.data(),
+                                    base_particles_.total_real_particles_, base_particles_.DataAllocationVersion());
+}
+//=================================================================================================//
+} // namespace SPH
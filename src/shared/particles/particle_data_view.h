@@ -0,0 +1,217 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	particle_data_view.h
+ * @brief 	Zero-copy views on the real particles of particle variables for in-situ analysis.
+ * @details The views give the address, the scalar type, the shape and the strides of
+ *          the registered particle variables, so that the live data can be read or modified
+ *          by analysis code, e.g. through the Python buffer protocol, without writing files.
+ *          A view is only valid until the particle data are extended, e.g. for buffer or ghost particles,
+ *          which may reallocate them, or the number of real particles is changed.
+ *          This is checked by ParticleDataView::isValid, and an invalid view is taken anew,
+ *          which is cheap as no data are copied.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef PARTICLE_DATA_VIEW_H
+#define PARTICLE_DATA_VIEW_H
+
+#include "base_particles.hpp"
+
+namespace SPH
+{
+/**
+ * @class ParticleVariableSpan
+ * @brief Typed view on the real particles of a particle variable.
+ */
+template <typename DataType>
+class ParticleVariableSpan
+{
+  public:
+    ParticleVariableSpan(DataType *data, size_t size, size_t data_version)
+        : data_(data), size_(size), data_version_(data_version){};
+
+    DataType *data() const { return data_; };
+    size_t size() const { return size_; };
+    size_t DataVersion() const { return data_version_; };
+    DataType *begin() const { return data_; };
+    DataType *end() const { return data_ + size_; };
+    DataType &operator[](size_t index) const { return data_[index]; };
+
+  private:
+    DataType *data_;
+    size_t size_;
+    size_t data_version_; /**< the allocation version of the particle data when taken. */
+};
+
+/**
+ * @class ParticleVariableView
+ * @brief Type-erased view on the real particles of a particle variable.
+ * @details The component (i, r, c) of particle i is located at
+ * data_ + i * strides_[0] + r * strides_[1] + c * strides_[2] in bytes,
+ * i.e. the column-major layout of the Eigen matrices.
+ * The shape is the number of real particles, followed by the number of rows for vectors
+ * and the number of rows and columns for matrices.
+ */
+struct ParticleVariableView
+{
+    enum class ScalarType
+    {
+        Real,
+        Single,
+        Integer,
+        Index
+    };
+
+    std::string name_;
+    void *data_;
+    ScalarType scalar_type_;
+    size_t item_size_; /**< size of a scalar component in bytes. */
+    StdVec<size_t> shape_;
+    StdVec<size_t> strides_;
+    size_t data_version_; /**< the allocation version of the particle data when taken. */
+
+    size_t Dimensions() const { return shape_.size(); };
+};
+
+template <typename DataType>
+ParticleVariableView makeParticleVariableView(const std::string &name, DataType *data, size_t size, size_t data_version)
+{
+    ParticleVariableView view;
+    view.name_ = name;
+    view.data_ = data;
+    view.data_version_ = data_version;
+    if constexpr (std::is_arithmetic<DataType>::value)
+    {
+        view.scalar_type_ = std::is_floating_point<DataType>::value
+                                ? ParticleVariableView::ScalarType::Real
+                                : (std::is_same<DataType, int>::value ? ParticleVariableView::ScalarType::Integer
+                                                                      : ParticleVariableView::ScalarType::Index);
+        view.item_size_ = sizeof(DataType);
+        view.shape_ = {size};
+        view.strides_ = {sizeof(DataType)};
+    }
+    else if constexpr (std::is_same<DataType, SingleReal>::value)
+    {
+        static_assert(sizeof(SingleReal) == sizeof(float), "Padded data type can not be viewed.");
+        view.scalar_type_ = ParticleVariableView::ScalarType::Single;
+        view.item_size_ = sizeof(float);
+        view.shape_ = {size};
+        view.strides_ = {sizeof(SingleReal)};
+    }
+    else
+    {
+        using ScalarType = typename DataType::Scalar;
+        constexpr size_t rows = DataType::RowsAtCompileTime;
+        constexpr size_t cols = DataType::ColsAtCompileTime;
+        static_assert(sizeof(DataType) == rows * cols * sizeof(ScalarType), "Padded data type can not be viewed.");
+        view.scalar_type_ = ParticleVariableView::ScalarType::Real;
+        view.item_size_ = sizeof(ScalarType);
+        view.shape_ = {size, rows};
+        view.strides_ = {sizeof(DataType), sizeof(ScalarType)};
+        if (cols != 1)
+        {
+            view.shape_.push_back(cols);
+            view.strides_.push_back(rows * sizeof(ScalarType));
+        }
+    }
+    return view;
+};
+
+/**
+ * @class ParticleDataView
+ * @brief Views on all registered variables of the particles of a body.
+ * @details Note that the order of the particles changes after particle sorting,
+ * the original particle ids are given by OriginalParticleIds.
+ */
+class ParticleDataView
+{
+  public:
+    explicit ParticleDataView(BaseParticles &base_particles);
+    virtual ~ParticleDataView(){};
+
+    std::string BodyName();
+    size_t TotalRealParticles() { return base_particles_.total_real_particles_; };
+    StdVec<std::string> VariableNames();
+    bool hasVariable(const std::string &variable_name);
+    ParticleVariableView getVariableView(const std::string &variable_name);
+    /** The ids of the particles at generation, unchanged by sorting. */
+    ParticleVariableView OriginalParticleIds();
+    /** Whether a view is still on the current particle data, otherwise it should be taken anew. */
+    bool isValid(const ParticleVariableView &view)
+    {
+        return isCurrent(view.data_version_, view.shape_[0]);
+    };
+    template <typename DataType>
+    bool isValid(const ParticleVariableSpan<DataType> &span)
+    {
+        return isCurrent(span.DataVersion(), span.size());
+    };
+
+    template <typename DataType>
+    ParticleVariableSpan<DataType> getVariableSpan(const std::string &variable_name)
+    {
+        DiscreteVariable<DataType> *variable =
+            findVariableByName<DataType>(base_particles_.AllDiscreteVariables(), variable_name);
+        if (variable == nullptr)
+        {
+            std::cout << "\n Error: the variable '" << variable_name << "' is not registered for "
+                      << BodyName() << "!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        constexpr int type_index = DataTypeIndex<DataType>::value;
+        StdLargeVec<DataType> *data = std::get<type_index>(base_particles_.getAllParticleData())[variable->IndexInContainer()];
+        return ParticleVariableSpan<DataType>(data->data(), base_particles_.total_real_particles_,
+                                              base_particles_.DataAllocationVersion());
+    };
+
+  protected:
+    BaseParticles &base_particles_;
+
+    bool isCurrent(size_t data_version, size_t size)
+    {
+        return data_version == base_particles_.DataAllocationVersion() &&
+               size == base_particles_.total_real_particles_;
+    };
+
+    template <typename DataType>
+    struct collectVariableViews
+    {
+        void operator()(ParticleData &particle_data, ParticleVariables &particle_variables,
+                        size_t total_real_particles, size_t data_version, StdVec<ParticleVariableView> &views) const
+        {
+            constexpr int type_index = DataTypeIndex<DataType>::value;
+            for (DiscreteVariable<DataType> *variable : std::get<type_index>(particle_variables))
+            {
+                StdLargeVec<DataType> &variable_data = *(std::get<type_index>(particle_data)[variable->IndexInContainer()]);
+                views.push_back(makeParticleVariableView(variable->Name(), variable_data.data(), total_real_particles, data_version));
+            }
+        };
+    };
+    DataAssembleOperation<collectVariableViews> collect_variable_views_;
+
+    StdVec<ParticleVariableView> AllVariableViews();
+};
+} // namespace SPH
+#endif // PARTICLE_DATA_VIEW_H
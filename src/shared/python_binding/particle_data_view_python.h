@@ -0,0 +1,96 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	particle_data_view_python.h
+ * @brief 	Python binding of the particle data views with the buffer protocol.
+ * @details Header only and not included by sphinxsys.h, so that the library does not depend on pybind11.
+ *          A pybind11 module calls exposeParticleDataView(m) and returns the ParticleDataView of a body,
+ *          with which numpy.asarray(data_view.Variable("Position")) is a writable array
+ *          sharing the memory of the particle variable.
+ *          After the particle data are extended or the number of real particles is changed,
+ *          data_view.IsValid(view) is false and the array must be taken anew.
+ *          The types are module local, so that several modules can expose them.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef PARTICLE_DATA_VIEW_PYTHON_H
+#define PARTICLE_DATA_VIEW_PYTHON_H
+
+#include "particle_data_view.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace SPH
+{
+inline std::string pythonBufferFormat(ParticleVariableView::ScalarType scalar_type)
+{
+    switch (scalar_type)
+    {
+    case ParticleVariableView::ScalarType::Real:
+        return pybind11::format_descriptor<Real>::format();
+    case ParticleVariableView::ScalarType::Single:
+        return pybind11::format_descriptor<float>::format();
+    case ParticleVariableView::ScalarType::Integer:
+        return pybind11::format_descriptor<int>::format();
+    default:
+        return pybind11::format_descriptor<size_t>::format();
+    }
+}
+
+inline pybind11::buffer_info toPythonBuffer(ParticleVariableView &view)
+{
+    StdVec<pybind11::ssize_t> shape(view.shape_.begin(), view.shape_.end());
+    StdVec<pybind11::ssize_t> strides(view.strides_.begin(), view.strides_.end());
+    return pybind11::buffer_info(view.data_, (pybind11::ssize_t)view.item_size_,
+                                 pythonBufferFormat(view.scalar_type_),
+                                 (pybind11::ssize_t)view.Dimensions(), shape, strides);
+}
+
+inline void exposeParticleDataView(pybind11::module_ &m)
+{
+    pybind11::class_<ParticleVariableView>(m, "ParticleVariableView", pybind11::buffer_protocol(), pybind11::module_local())
+        .def_buffer(&toPythonBuffer)
+        .def_readonly("Name", &ParticleVariableView::name_)
+        .def_readonly("Shape", &ParticleVariableView::shape_);
+
+    /** An unknown variable raises KeyError instead of exiting the interpreter.
+     * The views keep the data view alive. */
+    pybind11::class_<ParticleDataView>(m, "ParticleDataView", pybind11::module_local())
+        .def("BodyName", &ParticleDataView::BodyName)
+        .def("TotalRealParticles", &ParticleDataView::TotalRealParticles)
+        .def("VariableNames", &ParticleDataView::VariableNames)
+        .def("HasVariable", &ParticleDataView::hasVariable)
+        .def("IsValid", [](ParticleDataView &data_view, const ParticleVariableView &view)
+             { return data_view.isValid(view); })
+        .def(
+            "Variable", [](ParticleDataView &data_view, const std::string &variable_name)
+            {
+                if (!data_view.hasVariable(variable_name))
+                    throw pybind11::key_error("the variable '" + variable_name + "' is not registered");
+                return data_view.getVariableView(variable_name); },
+            pybind11::keep_alive<0, 1>())
+        .def("OriginalParticleIds", &ParticleDataView::OriginalParticleIds, pybind11::keep_alive<0, 1>());
+}
+} // namespace SPH
+#endif // PARTICLE_DATA_VIEW_PYTHON_H
@@ -0,0 +1,109 @@
+#include "multi_rate_time_stepping.h"
+
+namespace SPH
+{
+//=================================================================================================//
+MultiRateBody::MultiRateBody(BaseDynamics<Real> &time_step_size, std::function<void(Real)> sub_step)
+    : time_step_size_(time_step_size), sub_step_(sub_step), total_sub_steps_(0) {}
+//=================================================================================================//
+MultiRateBody &MultiRateBody::addCouplingDynamics(std::function<void(Real)> coupling_dynamics)
+{
+    coupling_dynamics_.push_back(coupling_dynamics);
+    return *this;
+}
+//=================================================================================================//
+MultiRateBody &MultiRateBody::addCouplingDynamics(BaseDynamics<void> &coupling_dynamics)
+{
+    coupling_dynamics_.push_back([&](Real dt)
+                                 { coupling_dynamics.exec(dt); });
+    return *this;
+}
+//=================================================================================================//
+void MultiRateBody::integrateCouplingInterval(Real start_time, Real coupling_interval, Real first_time_step)
+{
+    for (size_t k = 0; k != coupling_dynamics_.size(); ++k)
+        coupling_dynamics_[k](coupling_interval);
+
+    Real integration_time = 0.0;
+    Real time_step = first_time_step;
+    while (true)
+    {
+        if (time_step <= 0.0)
+        {
+            std::cout << "\n Error: non-positive time step size in multi-rate time stepping!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        /** The remaining interval is divided into equal steps not larger than the stable one,
+         * so that the last sub-step hits the coupling point without a tiny remainder.
+         * Round-off in the ratio does not add a sub-step. */
+        Real remaining_time = coupling_interval - integration_time;
+        size_t number_of_sub_steps =
+            SMAX(size_t(1), size_t(std::ceil((1.0 - SqrtEps) * remaining_time / time_step)));
+        Real dt = remaining_time / Real(number_of_sub_steps);
+
+        GlobalStaticVariables::physical_time_ = start_time + integration_time;
+        sub_step_(dt);
+        total_sub_steps_++;
+        if (number_of_sub_steps == 1)
+            break;
+
+        integration_time += dt;
+        time_step = time_step_size_.exec();
+    }
+}
+//=================================================================================================//
+MultiRateTimeStepping::MultiRateTimeStepping(size_t max_step_ratio)
+    : max_step_ratio_(Real(max_step_ratio)), coupling_interval_max_(MaxReal), total_coupling_steps_(0) {}
+//=================================================================================================//
+MultiRateBody &MultiRateTimeStepping::addBody(BaseDynamics<Real> &time_step_size, std::function<void(Real)> sub_step)
+{
+    MultiRateBody *multi_rate_body = multi_rate_body_keeper_.createPtr<MultiRateBody>(time_step_size, sub_step);
+    multi_rate_bodies_.push_back(multi_rate_body);
+    return *multi_rate_body;
+}
+//=================================================================================================//
+size_t MultiRateTimeStepping::integrateTo(Real end_time)
+{
+    if (multi_rate_bodies_.empty())
+    {
+        std::cout << "\n Error: no body registered for multi-rate time stepping!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    size_t coupling_steps = 0;
+    StdVec<Real> time_steps(multi_rate_bodies_.size());
+    while (GlobalStaticVariables::physical_time_ < end_time)
+    {
+        Real start_time = GlobalStaticVariables::physical_time_;
+        Real time_step_min = MaxReal;
+        Real time_step_max = 0.0;
+        for (size_t k = 0; k != multi_rate_bodies_.size(); ++k)
+        {
+            time_steps[k] = multi_rate_bodies_[k]->time_step_size_.exec();
+            time_step_min = SMIN(time_step_min, time_steps[k]);
+            time_step_max = SMAX(time_step_max, time_steps[k]);
+        }
+        Real remaining_time = end_time - start_time;
+        Real coupling_interval = SMIN(time_step_max, max_step_ratio_ * time_step_min,
+                                      coupling_interval_max_, remaining_time);
+        /** no tiny last coupling interval from round-off */
+        if (remaining_time - coupling_interval < SqrtEps * remaining_time)
+            coupling_interval = remaining_time;
+
+        for (size_t k = 0; k != multi_rate_bodies_.size(); ++k)
+        {
+            multi_rate_bodies_[k]->integrateCouplingInterval(
+                start_time, coupling_interval, SMIN(time_steps[k], coupling_interval));
+        }
+
+        GlobalStaticVariables::physical_time_ =
+            coupling_interval == remaining_time ? end_time : start_time + coupling_interval;
+        coupling_steps++;
+    }
+    total_coupling_steps_ += coupling_steps;
+    return coupling_steps;
+}
+//=================================================================================================//
+} // namespace SPH
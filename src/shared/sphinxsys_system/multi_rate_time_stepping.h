@@ -0,0 +1,98 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	multi_rate_time_stepping.h
+ * @brief 	Multi-rate time integration of bodies with different stable time steps.
+ * @details Each body, or each group of tightly coupled bodies, is registered with its time step size
+ * 			reduce dynamics, the sequence of dynamics for one sub-step and the dynamics coupling it to others.
+ * 			The bodies are synchronized only at coupling points. Between two coupling points,
+ * 			each body is sub-cycled with its own stable time step, one body after the other,
+ * 			so that the later bodies see the coupling data of the earlier ones at the end of the interval.
+ * 			The coupling interval is the largest stable time step among the bodies,
+ * 			bounded by the maximum step ratio to the smallest one.
+ * @author	Xiangyu Hu
+ */
+#ifndef MULTI_RATE_TIME_STEPPING_H
+#define MULTI_RATE_TIME_STEPPING_H
+
+#include "base_particle_dynamics.h"
+
+#include <functional>
+
+namespace SPH
+{
+/**
+ * @class MultiRateBody
+ * @brief A body, or a group of bodies, integrated with its own stable time step.
+ */
+class MultiRateBody
+{
+  public:
+    MultiRateBody(BaseDynamics<Real> &time_step_size, std::function<void(Real)> sub_step);
+    virtual ~MultiRateBody(){};
+    /** The coupling dynamics is executed once at each coupling point before sub-cycling,
+     * with the coupling interval as time step, e.g. to update contact configurations and interface forces. */
+    MultiRateBody &addCouplingDynamics(std::function<void(Real)> coupling_dynamics);
+    MultiRateBody &addCouplingDynamics(BaseDynamics<void> &coupling_dynamics);
+    size_t TotalSubSteps() { return total_sub_steps_; };
+
+  protected:
+    friend class MultiRateTimeStepping;
+    BaseDynamics<Real> &time_step_size_;
+    std::function<void(Real)> sub_step_;
+    StdVec<std::function<void(Real)>> coupling_dynamics_;
+    size_t total_sub_steps_;
+
+    /** Integrate over the coupling interval from the start time,
+     * the time step size computed at the coupling point is used for the first sub-step. */
+    void integrateCouplingInterval(Real start_time, Real coupling_interval, Real first_time_step);
+};
+
+/**
+ * @class MultiRateTimeStepping
+ * @brief The driver integrating all registered bodies with multi-rate sub-stepping.
+ */
+class MultiRateTimeStepping
+{
+    UniquePtrsKeeper<MultiRateBody> multi_rate_body_keeper_;
+
+  public:
+    explicit MultiRateTimeStepping(size_t max_step_ratio = 100);
+    virtual ~MultiRateTimeStepping(){};
+
+    MultiRateBody &addBody(BaseDynamics<Real> &time_step_size, std::function<void(Real)> sub_step);
+    /** The coupling interval is further limited, e.g. by the physics of the coupling. */
+    void setMaximumCouplingInterval(Real coupling_interval_max) { coupling_interval_max_ = coupling_interval_max; };
+    /** Integrate all bodies from the current physical time to the end time.
+     * Returns the number of coupling steps. */
+    size_t integrateTo(Real end_time);
+    size_t TotalCouplingSteps() { return total_coupling_steps_; };
+
+  protected:
+    Real max_step_ratio_;
+    Real coupling_interval_max_;
+    size_t total_coupling_steps_;
+    StdVec<MultiRateBody *> multi_rate_bodies_;
+};
+} // namespace SPH
+#endif // MULTI_RATE_TIME_STEPPING_H
@@ -25,6 +25,18 @@ IOEnvironment &SPHSystem::getIOEnvironment()
     return *io_environment_;
 }
 //=================================================================================================//
+void SPHSystem::setNumaAwareness(bool numa_awareness)
+{
+    if (!sph_bodies_.empty())
+    {
+        std::cout << "\n Error: NUMA awareness should be set before any SPH body is created! \n";
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    NumaAwareness::first_touch_ = numa_awareness;
+    thread_pinning_.observe(numa_awareness);
+}
+//=================================================================================================//
 
 void SPHSystem::initializeSystemCellLinkedLists()
 {
@@ -71,6 +83,7 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
         desc.add_options()("regression", po::value<bool>(), "Regression test.");
         desc.add_options()("state_recording", po::value<bool>(), "State recording in output folder.");
         desc.add_options()("restart_step", po::value<int>(), "Run form a restart file.");
+        desc.add_options()("numa", po::value<bool>(), "NUMA-aware data placement and thread pinning.");
 
         po::variables_map vm;
         po::store(po::parse_command_line(ac, av, desc), vm);
@@ -141,6 +154,18 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
             std::cout << "Restart inactivated, i.e. restart_step ("
                       << restart_step_ << ").\n";
         }
+
+        if (vm.count("numa"))
+        {
+            setNumaAwareness(vm["numa"].as<bool>());
+            std::cout << "NUMA awareness was set to "
+                      << vm["numa"].as<bool>() << ".\n";
+        }
+        else
+        {
+            std::cout << "NUMA awareness was set to default ("
+                      << NumaAware() << ").\n";
+        }
     }
     catch (std::exception &e)
     {
@@ -89,6 +89,10 @@ class SPHSystem
     bool StateRecording() { return state_recording_; };
     void setStateRecording(bool state_recording) { state_recording_ = state_recording; };
     void setRestartStep(size_t restart_step) { restart_step_ = restart_step; };
+    /** NUMA-aware first-touch placement of particle data and thread pinning,
+     * to be set before any body is created. */
+    void setNumaAwareness(bool numa_awareness);
+    bool NumaAware() { return NumaAwareness::first_touch_; };
     size_t RestartStep() { return restart_step_; };
     /** Initialize cell linked list for the SPH system. */
     void initializeSystemCellLinkedLists();
@@ -105,6 +109,7 @@ class SPHSystem
     size_t restart_step_;           /**< restart step */
     bool generate_regression_data_; /**< run and generate or enhance the regression test data set. */
     bool state_recording_;          /**< Record state in output folder. */
+    ThreadPinning thread_pinning_;  /**< pin threads to cores in NUMA-aware mode. */
 };
 } // namespace SPH
 #endif // SPH_SYSTEM_H
@@ -5,8 +5,10 @@
  * 			understanding SPH method for fluid simulation.
  * @author	Luhui Han, Chi Zhang and Xiangyu Hu
  */
-#include "sphinxsys.h"         //SPHinXsys Library.
-#include <pybind11/pybind11.h> //pybind11 Library.
+#include "sphinxsys.h"                  //SPHinXsys Library.
+#include "particle_data_view_python.h" //Zero-copy particle data for python.
+#include <pybind11/functional.h>       //pybind11 Library.
+#include <pybind11/pybind11.h>
 namespace py = pybind11;
 using namespace SPH; // Namespace cite here.
 //----------------------------------------------------------------------
@@ -129,6 +131,11 @@ class Environment : public PreSettingCase
     RegressionTestDynamicTimeWarping<ObservedQuantityRecording<Real>>
         write_recorded_water_pressure;
     //----------------------------------------------------------------------
+    //	Live particle data and the in-situ analysis called at each output time.
+    //----------------------------------------------------------------------
+    ParticleDataView water_block_data;
+    std::function<void(Real)> in_situ_analysis;
+    //----------------------------------------------------------------------
     //	Setup for time-stepping control
     //----------------------------------------------------------------------
     int screen_output_interval = 100;
@@ -163,7 +170,8 @@ class Environment : public PreSettingCase
           body_states_recording(sph_system.real_bodies_),
           restart_io(sph_system.real_bodies_),
           write_water_mechanical_energy(water_block, gravity),
-          write_recorded_water_pressure("Pressure", fluid_observer_contact)
+          write_recorded_water_pressure("Pressure", fluid_observer_contact),
+          water_block_data(water_block.getBaseParticles())
     {
         //----------------------------------------------------------------------
         //	Prepare the simulation with cell linked list, configuration
@@ -202,6 +210,11 @@ class Environment : public PreSettingCase
         return 1;
     }
     //----------------------------------------------------------------------
+    //	For in-situ analysis.
+    //----------------------------------------------------------------------
+    ParticleDataView &waterBlockData() { return water_block_data; }
+    void setInSituAnalysis(const std::function<void(Real)> &analysis) { in_situ_analysis = analysis; }
+    //----------------------------------------------------------------------
     //	Main loop starts here.
     //----------------------------------------------------------------------
     void runCase(Real End_time)
@@ -261,6 +274,8 @@ class Environment : public PreSettingCase
             }
 
             body_states_recording.writeToFile();
+            if (in_situ_analysis)
+                in_situ_analysis(GlobalStaticVariables::physical_time_);
             TickCount t2 = TickCount::now();
             TickCount t3 = TickCount::now();
             interval += t3 - t2;
@@ -297,8 +312,11 @@ class Environment : public PreSettingCase
 /** test_2d_dambreak_python should be same with the project name */
 PYBIND11_MODULE(test_2d_dambreak_python, m)
 {
+    exposeParticleDataView(m);
     py::class_<Environment>(m, "dambreak_from_sph_cpp")
         .def(py::init<const int &>())
         .def("CmakeTest", &Environment::cmakeTest)
+        .def("WaterBlockData", &Environment::waterBlockData, py::return_value_policy::reference_internal)
+        .def("SetInSituAnalysis", &Environment::setInSituAnalysis)
         .def("RunCase", &Environment::runCase);
 }
@@ -32,6 +32,16 @@ def run_case():
     
     # set project from class, which is set in cpp pybind module
     project = test_2d.dambreak_from_sph_cpp(case.restart_step)
+    # in-situ analysis on the live particle data through a zero-copy memoryview,
+    # numpy.asarray on the variable gives the same view as an array without a copy
+    water_block_data = project.WaterBlockData()
+
+    def runout_distance(physical_time):
+        positions = memoryview(water_block_data.Variable("Position"))
+        runout = max(positions[n, 0] for n in range(positions.shape[0]))
+        print("Time = %.6f, runout distance = %.6f" % (physical_time, runout))
+
+    project.SetInSituAnalysis(runout_distance)
     if project.CmakeTest() == 1:
         project.RunCase(case.end_time)
     else:
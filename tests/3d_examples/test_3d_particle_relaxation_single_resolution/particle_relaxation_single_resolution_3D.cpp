@@ -91,6 +91,8 @@ int main(int ac, char *av[])
     SimpleDynamics<RandomizeParticlePosition> random_imported_model_particles(imported_model);
     /** A  Physics relaxation step. */
     RelaxationStepLevelSetCorrectionInner relaxation_step_inner(imported_model_inner);
+    /** Carry out relaxation steps until the residue has converged. */
+    RelaxationController<RelaxationStepLevelSetCorrectionInner> relaxation_controller(relaxation_step_inner, 1000);
     //----------------------------------------------------------------------
     //	Particle relaxation starts here.
     //----------------------------------------------------------------------
@@ -102,17 +104,10 @@ int main(int ac, char *av[])
     //----------------------------------------------------------------------
     //	Particle relaxation time stepping start here.
     //----------------------------------------------------------------------
-    int ite_p = 0;
-    while (ite_p < 1000)
-    {
-        relaxation_step_inner.exec();
-        ite_p += 1;
-        if (ite_p % 100 == 0)
-        {
-            std::cout << std::fixed << std::setprecision(9) << "Relaxation steps for the imported model N = " << ite_p << "\n";
-            write_imported_model_to_vtp.writeToFile(ite_p);
-        }
-    }
+    size_t ite_p = relaxation_controller.exec();
+    std::cout << std::fixed << std::setprecision(9) << "Relaxation steps for the imported model N = " << ite_p
+              << " with the residue norm " << relaxation_controller.ResidueNorm() << "\n";
+    write_imported_model_to_vtp.writeToFile(ite_p);
     std::cout << "The physics relaxation process of imported model finish !" << std::endl;
 
     return 0;
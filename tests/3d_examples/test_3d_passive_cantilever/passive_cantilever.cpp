@@ -114,6 +114,8 @@ int main(int ac, char *av[])
     GlobalStaticVariables::physical_time_ = 0.0;
     sph_system.initializeSystemCellLinkedLists();
     sph_system.initializeSystemConfigurations();
+    /** the neighbors of the total Lagrangian solid do not change anymore */
+    cantilever_body_inner.freezeTopology();
     /** apply initial condition */
     initialization.exec();
     corrected_configuration.exec();
@@ -108,7 +108,6 @@ class BidirectionalBuffer
         };
         virtual ~Injection(){};
 
-        /** This class is only implemented in sequential due to memory conflicts. */
         virtual void update(size_t index_i, Real dt = 0.0);
 
         virtual void exec(Real dt = 0.0) override
@@ -119,11 +118,11 @@ class BidirectionalBuffer
                          [&](size_t index_i)
                          { update(index_i, dt); });
 
+            particles_->commitParticleCreationAndDeletion();
             buffer_particle_list_.clear();
         };
 
       protected:
-        std::mutex mutex_switch_to_real_;
         ConcurrentIndexVector &buffer_particle_list_;
         AlignedBoxShape &aligned_box_;
         Fluid &fluid_;
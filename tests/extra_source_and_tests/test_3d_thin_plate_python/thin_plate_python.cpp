@@ -6,6 +6,7 @@
  * @ref 	doi.org/10.1016/j.ijnonlinmec.2014.04.009, doi.org/10.1201/9780849384165
  */
 #include "sphinxsys.h"
+#include "particle_data_view_python.h"
 #include <gtest/gtest.h>
 #include <pybind11/pybind11.h>
 #include <string>
@@ -252,6 +253,8 @@ class Environment : public PreSettingCase
     {
         return 1;
     }
+    /** Zero-copy access to the plate particle data. */
+    ParticleDataView plateData() { return ParticleDataView(plate_body.getBaseParticles()); }
 
     /**
      *  The main program
@@ -320,8 +323,10 @@ class Environment : public PreSettingCase
 
 PYBIND11_MODULE(test_3d_thin_plate_python, m)
 {
+    exposeParticleDataView(m);
     py::class_<Environment>(m, "thin_plate_from_sph_cpp")
         .def(py::init<const float &>())
         .def("CmakeTest", &Environment::cmakeTest)
+        .def("PlateData", &Environment::plateData, py::keep_alive<0, 1>())
         .def("RunCase", &Environment::runCase);
 }
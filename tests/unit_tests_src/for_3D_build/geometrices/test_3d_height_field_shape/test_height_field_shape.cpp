@@ -0,0 +1,62 @@
+#include "height_field_shape.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** A tilted plane z = 0.5 * x + 1.0 over [0, 10] x [0, 5] with unit raster spacing. */
+std::string writeTiltedPlaneGrid()
+{
+    std::string file_name = "./tilted_plane.asc";
+    std::ofstream out_file(file_name);
+    out_file << "ncols 11\nnrows 6\nxllcenter 0.0\nyllcenter 0.0\ncellsize 1.0\nNODATA_value -9999\n";
+    for (int row = 0; row != 6; ++row)
+    {
+        for (int i = 0; i != 11; ++i)
+            out_file << 0.5 * (Real)i + 1.0 << " ";
+        out_file << "\n";
+    }
+    out_file.close();
+    return file_name;
+}
+
+TEST(test_HeightFieldShape, test_findBounds)
+{
+    HeightFieldShapeASCII terrain(writeTiltedPlaneGrid(), 0.0);
+    BoundingBox box = terrain.getBounds();
+    EXPECT_EQ(BoundingBox(Vec3d(0.0, 0.0, 0.0), Vec3d(10.0, 5.0, 6.0)), box);
+}
+
+TEST(test_HeightFieldShape, test_checkContain)
+{
+    HeightFieldShapeASCII terrain(writeTiltedPlaneGrid(), 0.0);
+    EXPECT_NEAR(terrain.getElevation(3.3, 2.7), 2.65, 1.0e-6);
+    EXPECT_TRUE(terrain.checkContain(Vec3d(3.3, 2.7, 2.6)));
+    EXPECT_FALSE(terrain.checkContain(Vec3d(3.3, 2.7, 2.7)));
+    EXPECT_FALSE(terrain.checkContain(Vec3d(3.3, 2.7, -0.1)));
+    EXPECT_FALSE(terrain.checkContain(Vec3d(-0.1, 2.7, 0.5)));
+}
+
+TEST(test_HeightFieldShape, test_findClosestPoint)
+{
+    HeightFieldShapeASCII terrain(writeTiltedPlaneGrid(), 0.0);
+    Vec3d normal = Vec3d(-0.5, 0.0, 1.0).normalized();
+    Vec3d surface_point(4.2, 2.5, 3.1);
+    for (Real distance : {0.05, 0.3, 1.0})
+    {
+        Vec3d above = surface_point + distance * normal;
+        EXPECT_NEAR((terrain.findClosestPoint(above) - surface_point).norm(), 0.0, 1.0e-6);
+        EXPECT_NEAR(terrain.findSignedDistance(above), distance, 1.0e-6);
+
+        Vec3d below = surface_point - distance * normal;
+        EXPECT_NEAR((terrain.findClosestPoint(below) - surface_point).norm(), 0.0, 1.0e-6);
+        EXPECT_NEAR(terrain.findSignedDistance(below), -distance, 1.0e-6);
+    }
+    /** close to the base the bottom face is the closest. */
+    EXPECT_NEAR((terrain.findClosestPoint(Vec3d(5.0, 2.5, 0.2)) - Vec3d(5.0, 2.5, 0.0)).norm(), 0.0, 1.0e-6);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+#include "image_shape.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** A sphere of radius 5 at the origin as a binary mask of 48^3 voxels with spacing 0.5. */
+std::string writeSphereMask(const std::string &element_type, bool is_byte_order_msb)
+{
+    std::string raw_name = "sphere_mask_" + element_type + ".raw";
+    std::string header_name = "./sphere_mask_" + element_type + ".mhd";
+    std::ofstream raw_file(raw_name, std::ios::binary);
+    for (int k = 0; k != 48; ++k)
+        for (int j = 0; j != 48; ++j)
+            for (int i = 0; i != 48; ++i)
+            {
+                Vec3d position = Vec3d(-12.0, -12.0, -12.0) + 0.5 * Vec3d(i, j, k);
+                unsigned short value = position.norm() < 5.0 ? 100 : 0;
+                if (element_type == "MET_UCHAR")
+                    raw_file.put((char)value);
+                else // two bytes in the given order
+                {
+                    char low = (char)(value & 0xFF), high = (char)(value >> 8);
+                    raw_file.put(is_byte_order_msb ? high : low);
+                    raw_file.put(is_byte_order_msb ? low : high);
+                }
+            }
+    raw_file.close();
+    std::ofstream header_file(header_name);
+    header_file << "ObjectType = Image\nNDims = 3\nBinaryData = True\n"
+                << "BinaryDataByteOrderMSB = " << (is_byte_order_msb ? "True" : "False") << "\n"
+                << "CompressedData = False\nTransformMatrix = 1 0 0 0 1 0 0 0 1\n"
+                << "Offset = -12 -12 -12\nElementSpacing = 0.5 0.5 0.5\nDimSize = 48 48 48\n"
+                << "ElementType = " << element_type << "\nElementDataFile = " << raw_name << "\n";
+    header_file.close();
+    return header_name;
+}
+
+/** The signed distance to a sphere of radius 5 at the origin of 24^3 voxels with spacing 1. */
+std::string writeSphereDistanceMap()
+{
+    std::ofstream raw_file("sphere_distance.raw", std::ios::binary);
+    for (int k = 0; k != 24; ++k)
+        for (int j = 0; j != 24; ++j)
+            for (int i = 0; i != 24; ++i)
+            {
+                float value = (Vec3d(-12.0, -12.0, -12.0) + Vec3d(i, j, k)).norm() - 5.0;
+                raw_file.write(reinterpret_cast<const char *>(&value), sizeof(float));
+            }
+    raw_file.close();
+    std::ofstream header_file("./sphere_distance.mhd");
+    header_file << "ObjectType = Image\nNDims = 3\nBinaryData = True\nBinaryDataByteOrderMSB = False\n"
+                << "CompressedData = False\nTransformMatrix = 1 0 0 0 1 0 0 0 1\n"
+                << "Offset = -12 -12 -12\nElementSpacing = 1 1 1\nDimSize = 24 24 24\n"
+                << "ElementType = MET_FLOAT\nElementDataFile = sphere_distance.raw\n";
+    header_file.close();
+    return "./sphere_distance.mhd";
+}
+
+TEST(test_ImageShape, test_signed_distance)
+{
+    ImageShapeFromFile sphere(writeSphereMask("MET_UCHAR", false), 50.0, true);
+    EXPECT_EQ(BoundingBox(Vec3d(-12.0, -12.0, -12.0), Vec3d(11.5, 11.5, 11.5)), sphere.getBounds());
+    EXPECT_TRUE(sphere.checkContain(Vec3d(0.0, 0.0, 0.0)));
+    EXPECT_FALSE(sphere.checkContain(Vec3d(6.0, 0.0, 0.0)));
+    /** the mask resolves the surface within half of the spacing. */
+    for (int n = 0; n != 200; ++n)
+    {
+        Vec3d probe_point(rand_uniform(-8.0, 8.0), rand_uniform(-8.0, 8.0), rand_uniform(-8.0, 8.0));
+        EXPECT_NEAR(sphere.findSignedDistance(probe_point), probe_point.norm() - 5.0, 0.3);
+    }
+    Vec3d normal = sphere.findNormalDirection(Vec3d(4.0, 3.0, 0.0));
+    EXPECT_GT(normal.dot(Vec3d(0.8, 0.6, 0.0)), 0.99);
+    EXPECT_NEAR(sphere.findClosestPoint(Vec3d(6.0, 0.0, 0.0)).norm(), 5.0, 0.3);
+}
+
+TEST(test_ImageShape, test_byte_order)
+{
+    ImageShapeFromFile little_endian(writeSphereMask("MET_USHORT", false), 50.0, true);
+    ImageShapeFromFile big_endian(writeSphereMask("MET_USHORT", true), 50.0, true);
+    for (Vec3d probe_point : {Vec3d(0.0, 0.0, 0.0), Vec3d(4.7, 1.1, 0.3), Vec3d(7.0, -2.0, 1.0)})
+        EXPECT_EQ(little_endian.findSignedDistance(probe_point), big_endian.findSignedDistance(probe_point));
+}
+
+TEST(test_ImageShape, test_distance_map)
+{
+    ImageShapeFromFile sphere(writeSphereDistanceMap());
+    /** the surface is resolved within the voxels, not only halfway between them. */
+    for (int n = 0; n != 200; ++n)
+    {
+        Vec3d probe_point(rand_uniform(-8.0, 8.0), rand_uniform(-8.0, 8.0), rand_uniform(-8.0, 8.0));
+        EXPECT_NEAR(sphere.findSignedDistance(probe_point), probe_point.norm() - 5.0, 0.1);
+    }
+    /** outside of the volume, the distance is not overestimated. */
+    for (Vec3d probe_point : {Vec3d(20.0, 0.0, 0.0), Vec3d(15.0, 15.0, 0.0), Vec3d(-20.0, 18.0, 16.0)})
+    {
+        Real distance = sphere.findSignedDistance(probe_point);
+        EXPECT_GT(distance, 0.0);
+        EXPECT_LE(distance, probe_point.norm() - 5.0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,59 @@
+#include "adaptation.h"
+#include "geometric_shape.h"
+#include "level_set_shape.h"
+#include "transform_shape.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+TEST(test_LevelSetBatchedProbes, test_same_as_scalar_probes)
+{
+    Real resolution_ref = 0.025;
+    Vec3d halfsize(0.5, 0.3, 0.2);
+    TransformShape<GeometricShapeBox> box(Transform(Vec3d::Zero()), halfsize, "Box");
+    LevelSetShape level_set_shape(box, makeShared<SPHAdaptation>(resolution_ref));
+
+    /** points near the surface are in inner packages, those deep inside and far outside in singular packages. */
+    StdLargeVec<Vecd> positions;
+    for (int i = 0; i != 2000; ++i)
+        positions.push_back(Vec3d::Random().cwiseProduct(halfsize + 0.1 * Vec3d::Ones()));
+    for (int i = 0; i != 200; ++i)
+        positions.push_back(0.2 * Vec3d::Random().cwiseProduct(halfsize));
+    for (int i = 0; i != 200; ++i)
+        positions.push_back(Vec3d(0.8, 0.0, 0.0) + 0.1 * Vec3d::Random());
+    /** every second particle is probed. */
+    IndexVector indices;
+    for (size_t i = 0; i < positions.size(); i += 2)
+        indices.push_back(i);
+
+    StdLargeVec<Real> signed_distances(positions.size(), 0.0);
+    StdLargeVec<Vecd> normal_directions(positions.size(), Vecd::Zero());
+    StdLargeVec<Vecd> kernel_gradient_integrals(positions.size(), Vecd::Zero());
+    level_set_shape.probeSignedDistance(positions, indices, signed_distances);
+    level_set_shape.probeNormalDirection(positions, indices, normal_directions);
+    level_set_shape.probeKernelGradientIntegral(positions, indices, kernel_gradient_integrals);
+
+    size_t singular_probes = 0;
+    for (size_t i : indices)
+    {
+        EXPECT_EQ(signed_distances[i], level_set_shape.findSignedDistance(positions[i]));
+        EXPECT_EQ(kernel_gradient_integrals[i], level_set_shape.computeKernelGradientIntegral(positions[i]));
+        /** the scalar probe jitters the point randomly where the gradient vanishes. */
+        if (level_set_shape.findLevelSetGradient(positions[i]).norm() > 1.0e-2 * resolution_ref)
+            EXPECT_EQ(normal_directions[i], level_set_shape.findNormalDirection(positions[i]));
+        singular_probes += ABS(signed_distances[i]) > 0.1 ? 1 : 0;
+    }
+    EXPECT_GT(singular_probes, size_t(100));
+    /** the other particles are not touched. */
+    for (size_t i = 1; i < positions.size(); i += 2)
+    {
+        EXPECT_EQ(signed_distances[i], 0.0);
+        EXPECT_EQ(kernel_gradient_integrals[i], Vecd::Zero());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
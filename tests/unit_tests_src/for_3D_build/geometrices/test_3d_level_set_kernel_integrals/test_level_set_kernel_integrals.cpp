@@ -0,0 +1,56 @@
+#include "adaptation.h"
+#include "geometric_shape.h"
+#include "level_set_shape.h"
+#include "transform_shape.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+TEST(test_LevelSetKernelIntegrals, test_concurrent_probes)
+{
+    Real resolution_ref = 0.025;
+    Vec3d halfsize(0.5, 0.3, 0.2);
+    TransformShape<GeometricShapeBox> box(Transform(Vec3d::Zero()), halfsize, "Box");
+    /** the integrals of one level set are computed eagerly, those of the other when first probed. */
+    LevelSetShape eager_shape(box, makeShared<SPHAdaptation>(resolution_ref));
+    eager_shape.prepareKernelIntegralsNearInterface();
+    LevelSetShape lazy_shape(box, makeShared<SPHAdaptation>(resolution_ref));
+
+    /** points on a face, which fall into a few packages only. */
+    StdVec<Vec3d> points;
+    for (int i = 0; i != 8; ++i)
+        for (int j = 0; j != 8; ++j)
+            points.push_back(Vec3d(0.5, -0.05 + 0.0125 * i, -0.05 + 0.0125 * j));
+
+    /** each point is probed by many threads at the same time. */
+    size_t repeats = 64;
+    StdVec<Real> kernel_integrals(points.size() * repeats);
+    StdVec<Vec3d> kernel_gradient_integrals(points.size() * repeats);
+    parallel_for(
+        IndexRange(0, points.size() * repeats),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                const Vec3d &point = points[n % points.size()];
+                kernel_integrals[n] = lazy_shape.computeKernelIntegral(point);
+                kernel_gradient_integrals[n] = lazy_shape.computeKernelGradientIntegral(point);
+            }
+        },
+        tbb::simple_partitioner());
+
+    for (size_t n = 0; n != points.size() * repeats; ++n)
+    {
+        const Vec3d &point = points[n % points.size()];
+        EXPECT_EQ(kernel_integrals[n], eager_shape.computeKernelIntegral(point));
+        EXPECT_EQ(kernel_gradient_integrals[n], eager_shape.computeKernelGradientIntegral(point));
+    }
+    /** a point on the face has about the half of the kernel support inside. */
+    EXPECT_NEAR(kernel_integrals[0], 0.5, 0.05);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
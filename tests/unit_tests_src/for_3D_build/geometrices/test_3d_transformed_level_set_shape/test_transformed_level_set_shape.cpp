@@ -0,0 +1,129 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real resolution_ref = 0.025;
+Vec3d halfsize(0.5, 0.3, 0.2);
+BoundingBox system_domain_bounds(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0));
+/** points near the centers of the faces, inside and outside, given in the box frame. */
+StdVec<Vec3d> points_in_box = {Vec3d(0.52, 0.05, 0.0), Vec3d(0.1, -0.27, 0.05),
+                               Vec3d(0.0, 0.1, 0.16), Vec3d(-0.53, 0.0, -0.05)};
+
+/** exact signed distance to the box centered at the origin of the box frame */
+Real boxSignedDistance(const Vec3d &point_in_box)
+{
+    Vec3d excess = point_in_box.cwiseAbs() - halfsize;
+    return excess.cwiseMax(0.0).norm() + std::min(excess.maxCoeff(), Real(0.0));
+}
+/** outward normal of the face nearest to a point near a face center */
+Vec3d boxFaceNormal(const Vec3d &point_in_box)
+{
+    int axis = 0;
+    (point_in_box.cwiseAbs() - halfsize).maxCoeff(&axis);
+    Vec3d normal = Vec3d::Zero();
+    normal[axis] = point_in_box[axis] > 0.0 ? 1.0 : -1.0;
+    return normal;
+}
+
+TEST(test_TransformedLevelSetShape, test_signed_distance_and_normal)
+{
+    TransformShape<GeometricShapeBox> box(Transform(Vec3d::Zero()), halfsize, "Box");
+    LevelSetShape level_set_shape(box, makeShared<SPHAdaptation>(resolution_ref));
+
+    Transform transform(Rotation3d(0.3, Vec3d(1.0, 1.0, 0.0).normalized()), Vec3d(0.2, -0.1, 0.3));
+    TransformedLevelSetShape transformed_shape(level_set_shape, transform);
+
+    for (const Vec3d &point_in_box : points_in_box)
+    {
+        Vec3d point = transform.shiftFrameStationToBase(point_in_box);
+        Real distance = transformed_shape.findSignedDistance(point);
+        EXPECT_NEAR(distance, boxSignedDistance(point_in_box), 0.25 * resolution_ref);
+        EXPECT_GT(transformed_shape.findNormalDirection(point).dot(
+                      transform.xformFrameVecToBase(boxFaceNormal(point_in_box))),
+                  0.99);
+        EXPECT_EQ(transformed_shape.checkContain(point), boxSignedDistance(point_in_box) < 0.0);
+        /** the untransformed level set does not describe the moved box. */
+        EXPECT_GT(std::abs(level_set_shape.findSignedDistance(point) - boxSignedDistance(point_in_box)),
+                  0.25 * resolution_ref);
+    }
+}
+
+TEST(test_TransformedLevelSetShape, test_used_as_level_set_shape)
+{
+    TransformShape<GeometricShapeBox> box(Transform(Vec3d::Zero()), halfsize, "Box");
+    LevelSetShape level_set_shape(box, makeShared<SPHAdaptation>(resolution_ref));
+
+    Transform transform(Rotation3d(-0.5, Vec3d(0.0, 1.0, 1.0).normalized()), Vec3d(-0.1, 0.2, 0.1));
+    TransformedLevelSetShape transformed_shape(level_set_shape, transform);
+    /** level set consumers cast the shape of a body to a level set shape. */
+    Shape *shape = &transformed_shape;
+    LevelSetShape *level_set_consumer = dynamic_cast<LevelSetShape *>(shape);
+    ASSERT_NE(level_set_consumer, nullptr);
+
+    StdLargeVec<Vecd> positions;
+    IndexVector indices;
+    for (const Vec3d &point_in_box : points_in_box)
+    {
+        indices.push_back(positions.size());
+        positions.push_back(transform.shiftFrameStationToBase(point_in_box));
+    }
+    StdLargeVec<Real> signed_distances(positions.size(), 0.0);
+    StdLargeVec<Vecd> normal_directions(positions.size(), Vecd::Zero());
+    level_set_consumer->probeSignedDistance(positions, indices, signed_distances);
+    level_set_consumer->probeNormalDirection(positions, indices, normal_directions);
+    for (size_t i = 0; i != positions.size(); ++i)
+    {
+        EXPECT_NEAR(signed_distances[i], boxSignedDistance(points_in_box[i]), 0.25 * resolution_ref);
+        EXPECT_GT(normal_directions[i].dot(transform.xformFrameVecToBase(boxFaceNormal(points_in_box[i]))), 0.99);
+        EXPECT_NEAR(level_set_consumer->findSignedDistance(positions[i]), signed_distances[i], 1.0e-10);
+    }
+}
+
+TEST(test_TransformedLevelSetShape, test_transform_by_simbody)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    /** the box is built at its initial position, which is the origin of the free body. */
+    Vec3d initial_center(0.2, -0.1, 0.3);
+    TransformShape<GeometricShapeBox> box(Transform(initial_center), halfsize, "Box");
+    SolidBody box_body(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(initial_center), halfsize, "BoxBody"));
+    LevelSetShape level_set_shape(box, makeShared<SPHAdaptation>(resolution_ref));
+    TransformedLevelSetShape transformed_shape(level_set_shape);
+
+    SimTK::MultibodySystem MBsystem;
+    SimTK::SimbodyMatterSubsystem matter(MBsystem);
+    SimTK::GeneralForceSubsystem forces(MBsystem);
+    SimTK::Body::Rigid box_info(SimTK::MassProperties(1.0, SimTK::Vec3(0), SimTK::UnitInertia(1)));
+    SimTK::MobilizedBody::Free box_mobod(matter.Ground(), SimTK::Transform(EigenToSimTK(initial_center)),
+                                         box_info, SimTK::Transform(SimTK::Vec3(0)));
+    SimTK::State state = MBsystem.realizeTopology();
+    box_mobod.setUToFitAngularVelocity(state, SimTK::Vec3(0.3, 0.0, 1.0));
+    box_mobod.setUToFitLinearVelocity(state, SimTK::Vec3(0.1, 0.2, -0.1));
+    SimTK::RungeKuttaMersonIntegrator integ(MBsystem);
+    integ.setAccuracy(1e-3);
+    integ.setAllowInterpolation(false);
+    integ.initialize(state);
+
+    solid_dynamics::TransformLevelSetShapeBySimBody
+        transform_level_set_shape(box_body, transformed_shape, MBsystem, box_mobod, integ);
+    integ.stepTo(0.5);
+    transform_level_set_shape.exec();
+
+    const SimTK::State &current_state = integ.getState();
+    for (const Vec3d &point_in_box : points_in_box)
+    {
+        /** body-frame stations are the points in the box frame. */
+        Vec3d point = SimTKToEigen(box_mobod.findStationLocationInGround(current_state, EigenToSimTK(point_in_box)));
+        Vec3d normal = SimTKToEigen(box_mobod.expressVectorInGroundFrame(current_state, EigenToSimTK(boxFaceNormal(point_in_box))));
+        EXPECT_NEAR((transformed_shape.getTransform().shiftFrameStationToBase(initial_center + point_in_box) - point).norm(),
+                    0.0, 1.0e-10);
+        EXPECT_NEAR(transformed_shape.findSignedDistance(point), boxSignedDistance(point_in_box), 0.25 * resolution_ref);
+        EXPECT_GT(transformed_shape.findNormalDirection(point).dot(normal), 0.99);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+#include "triangle_mesh_bvh.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** A closed torus surface with major radius 1.0 and minor radius 0.3, its faces are consistently oriented. */
+void buildTorusMesh(StdVec<Vec3d> &vertices, StdVec<Array3i> &faces, int resolution)
+{
+    int major_resolution = 2 * resolution;
+    for (int i = 0; i != major_resolution; ++i)
+        for (int j = 0; j != resolution; ++j)
+        {
+            Real phi = 2.0 * Pi * (Real)i / (Real)major_resolution;
+            Real theta = 2.0 * Pi * (Real)j / (Real)resolution;
+            Real radius = 1.0 + 0.3 * cos(theta);
+            vertices.push_back(Vec3d(radius * cos(phi), radius * sin(phi), 0.3 * sin(theta)));
+        }
+    for (int i = 0; i != major_resolution; ++i)
+        for (int j = 0; j != resolution; ++j)
+        {
+            int a = i * resolution + j;
+            int b = ((i + 1) % major_resolution) * resolution + j;
+            int c = ((i + 1) % major_resolution) * resolution + (j + 1) % resolution;
+            int d = i * resolution + (j + 1) % resolution;
+            faces.push_back(Array3i(a, b, c));
+            faces.push_back(Array3i(a, c, d));
+        }
+}
+
+Vec3d findClosestPointByBruteForce(const Vec3d &probe_point, const StdVec<Vec3d> &vertices,
+                                   const StdVec<Array3i> &faces)
+{
+    Vec3d closest_point = vertices[0];
+    for (const Array3i &face : faces)
+    {
+        Vec3d face_point = findClosestPointOnTriangle(probe_point, vertices[face[0]], vertices[face[1]], vertices[face[2]]);
+        if ((face_point - probe_point).norm() < (closest_point - probe_point).norm())
+            closest_point = face_point;
+    }
+    return closest_point;
+}
+
+TEST(test_TriangleMeshBVH, test_findClosestPoint)
+{
+    StdVec<Vec3d> vertices;
+    StdVec<Array3i> faces;
+    buildTorusMesh(vertices, faces, 24);
+    TriangleMeshBVH bvh;
+    bvh.build(vertices, faces);
+
+    StdLargeVec<Vec3d> probe_points;
+    for (int n = 0; n != 200; ++n)
+        probe_points.push_back(Vec3d(rand_uniform(-2.0, 2.0), rand_uniform(-2.0, 2.0), rand_uniform(-1.0, 1.0)));
+    StdLargeVec<Vec3d> closest_points;
+    bvh.findClosestPoints(probe_points, closest_points);
+    for (size_t n = 0; n != probe_points.size(); ++n)
+    {
+        Vec3d expected = findClosestPointByBruteForce(probe_points[n], vertices, faces);
+        EXPECT_NEAR((closest_points[n] - probe_points[n]).norm(), (expected - probe_points[n]).norm(), 1.0e-12);
+    }
+}
+
+TEST(test_TriangleMeshBVH, test_checkContain)
+{
+    StdVec<Vec3d> vertices;
+    StdVec<Array3i> faces;
+    buildTorusMesh(vertices, faces, 24);
+    TriangleMeshBVH bvh;
+    bvh.build(vertices, faces);
+
+    EXPECT_TRUE(bvh.checkContain(Vec3d(1.0, 0.0, 0.0)));
+    EXPECT_TRUE(bvh.checkContain(Vec3d(0.0, -1.2, 0.1)));
+    EXPECT_FALSE(bvh.checkContain(Vec3d(0.0, 0.0, 0.0)));
+    EXPECT_FALSE(bvh.checkContain(Vec3d(1.0, 0.0, 0.5)));
+    EXPECT_FALSE(bvh.checkContain(Vec3d(3.0, 0.0, 0.0)));
+
+    StdLargeVec<Vec3d> probe_points;
+    for (int n = 0; n != 2000; ++n)
+        probe_points.push_back(Vec3d(rand_uniform(-1.5, 1.5), rand_uniform(-1.5, 1.5), rand_uniform(-0.5, 0.5)));
+    StdLargeVec<int> is_contained;
+    bvh.checkContain(probe_points, is_contained);
+    for (size_t n = 0; n != probe_points.size(); ++n)
+    {
+        Vec3d p = probe_points[n];
+        int face_id;
+        Real distance = (bvh.findClosestPoint(p, face_id) - p).norm();
+        Real torus_distance = Vec2d(Vec2d(p[0], p[1]).norm() - 1.0, p[2]).norm() - 0.3;
+        if (distance > 0.02) // away from the faceted surface, compare with the exact torus
+            EXPECT_EQ(is_contained[n] == 1, torus_distance < 0.0);
+    }
+}
+
+TEST(test_TriangleMeshBVH, test_checkContain_open_mesh)
+{
+    StdVec<Vec3d> vertices;
+    StdVec<Array3i> torus_faces;
+    buildTorusMesh(vertices, torus_faces, 24);
+    /** the faces of the first ring around the minor circle are removed, leaving a gap at phi = 0. */
+    StdVec<Array3i> faces(torus_faces.begin() + 2 * 24, torus_faces.end());
+    TriangleMeshBVH bvh;
+    bvh.build(vertices, faces);
+    TriangleMeshBVH closed_bvh;
+    closed_bvh.build(vertices, torus_faces);
+    EXPECT_TRUE(closed_bvh.isWatertight());
+    EXPECT_FALSE(bvh.isWatertight());
+
+    StdLargeVec<Vec3d> probe_points;
+    for (int n = 0; n != 2000; ++n)
+        probe_points.push_back(Vec3d(rand_uniform(-1.5, 0.0), rand_uniform(-1.5, 1.5), rand_uniform(-0.5, 0.5)));
+    StdLargeVec<int> is_contained;
+    bvh.checkContain(probe_points, is_contained);
+    for (size_t n = 0; n != probe_points.size(); ++n)
+    {
+        Vec3d p = probe_points[n];
+        int face_id;
+        Real distance = (bvh.findClosestPoint(p, face_id) - p).norm();
+        Real torus_distance = Vec2d(Vec2d(p[0], p[1]).norm() - 1.0, p[2]).norm() - 0.3;
+        if (distance > 0.02) // away from the faceted surface and the gap, compare with the exact torus
+            EXPECT_EQ(is_contained[n] == 1, torus_distance < 0.0);
+    }
+}
+
+TEST(test_TriangleMeshBVH, test_checkContain_boundary)
+{
+    StdVec<Vec3d> vertices;
+    StdVec<Array3i> torus_faces;
+    buildTorusMesh(vertices, torus_faces, 24);
+    StdVec<Array3i> open_faces(torus_faces.begin() + 2 * 24, torus_faces.end());
+    TriangleMeshBVH closed_bvh;
+    closed_bvh.build(vertices, torus_faces);
+    TriangleMeshBVH open_bvh;
+    open_bvh.build(vertices, open_faces);
+
+    /** the centroids of faces away from the gap are on the surface of both meshes. */
+    for (size_t n = torus_faces.size() / 2; n < torus_faces.size(); n += 37)
+    {
+        const Array3i &face = torus_faces[n];
+        Vec3d centroid = (vertices[face[0]] + vertices[face[1]] + vertices[face[2]]) / 3.0;
+        EXPECT_TRUE(closed_bvh.checkContain(centroid, true));
+        EXPECT_FALSE(closed_bvh.checkContain(centroid, false));
+        EXPECT_TRUE(open_bvh.checkContain(centroid, true));
+        EXPECT_FALSE(open_bvh.checkContain(centroid, false));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+#include "mapped_file.h"
+#include "triangle_mesh_loader.h"
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** The unit cube [0, 1]^3 with its 8 corners and 12 triangles. */
+StdVec<Vec3d> cubeCorners()
+{
+    StdVec<Vec3d> corners;
+    for (int k = 0; k != 2; ++k)
+        for (int j = 0; j != 2; ++j)
+            for (int i = 0; i != 2; ++i)
+                corners.push_back(Vec3d(i, j, k));
+    return corners;
+}
+
+StdVec<Array3i> cubeFaces()
+{
+    return {Array3i(0, 2, 3), Array3i(0, 3, 1), Array3i(4, 5, 7), Array3i(4, 7, 6),
+            Array3i(0, 1, 5), Array3i(0, 5, 4), Array3i(2, 6, 7), Array3i(2, 7, 3),
+            Array3i(0, 4, 6), Array3i(0, 6, 2), Array3i(1, 3, 7), Array3i(1, 7, 5)};
+}
+
+void writeBinarySTL(const std::string &file_name)
+{
+    StdVec<Vec3d> corners = cubeCorners();
+    std::ofstream out_file(file_name, std::ios::binary);
+    char header[80] = "solid but binary";
+    out_file.write(header, 80);
+    uint32_t number_of_faces = 12;
+    out_file.write(reinterpret_cast<char *>(&number_of_faces), 4);
+    for (const Array3i &face : cubeFaces())
+    {
+        float values[12] = {0.0f, 0.0f, 0.0f};
+        for (int k = 0; k != 3; ++k)
+            for (int d = 0; d != 3; ++d)
+                values[3 + 3 * k + d] = (float)corners[face[k]][d];
+        out_file.write(reinterpret_cast<char *>(values), sizeof(values));
+        uint16_t attribute = 0;
+        out_file.write(reinterpret_cast<char *>(&attribute), 2);
+    }
+}
+
+void writeAsciiSTL(const std::string &file_name)
+{
+    StdVec<Vec3d> corners = cubeCorners();
+    std::ofstream out_file(file_name);
+    out_file << "solid cube\n";
+    for (const Array3i &face : cubeFaces())
+    {
+        out_file << " facet normal 0 0 0\n  outer loop\n";
+        for (int k = 0; k != 3; ++k)
+            out_file << "   vertex " << corners[face[k]][0] << " " << corners[face[k]][1] << " " << corners[face[k]][2] << "\n";
+        out_file << "  endloop\n endfacet\n";
+    }
+    out_file << "endsolid cube";
+}
+
+/** Quadrilateral faces, relative indices and texture/normal indices are used. */
+void writeOBJ(const std::string &file_name)
+{
+    std::ofstream out_file(file_name);
+    out_file << "# unit cube\n";
+    for (const Vec3d &corner : cubeCorners())
+        out_file << "v " << corner[0] << " " << corner[1] << " " << corner[2] << "\n";
+    out_file << "f 1/1 3/2 4/3 2/4\nf 5//1 6//1 8//1 7//1\nf 1 2 6 5\nf -6 -2 -1 -5\nf 1 5 7 3\nf 2 4 8 6";
+}
+
+void checkCube(TriangleMeshLoader &loader)
+{
+    EXPECT_EQ(loader.getVertices().size(), 8);
+    ASSERT_EQ(loader.getFaces().size(), 12);
+    /** the signed volume of the closed surface. */
+    Real volume = 0.0;
+    for (const Array3i &face : loader.getFaces())
+    {
+        const Vec3d &a = loader.getVertices()[face[0]];
+        const Vec3d &b = loader.getVertices()[face[1]];
+        const Vec3d &c = loader.getVertices()[face[2]];
+        volume += a.dot(b.cross(c)) / 6.0;
+    }
+    EXPECT_NEAR(std::abs(volume), 1.0, 1.0e-12);
+}
+
+TEST(test_TriangleMeshLoader, test_binarySTL)
+{
+    writeBinarySTL("./cube_binary.stl");
+    TriangleMeshLoader loader("./cube_binary.stl");
+    checkCube(loader);
+}
+
+TEST(test_TriangleMeshLoader, test_asciiSTL)
+{
+    writeAsciiSTL("./cube_ascii.stl");
+    TriangleMeshLoader loader("./cube_ascii.stl");
+    checkCube(loader);
+}
+
+TEST(test_TriangleMeshLoader, test_OBJ)
+{
+    writeOBJ("./cube.obj");
+    TriangleMeshLoader loader("./cube.obj");
+    checkCube(loader);
+
+    loader.transform(Mat3d::Identity(), Vec3d(1.0, 0.0, 0.0), 2.0);
+    for (const Vec3d &vertex : loader.getVertices())
+    {
+        EXPECT_TRUE(vertex[0] == 1.0 || vertex[0] == 3.0);
+        EXPECT_TRUE(vertex[2] == 0.0 || vertex[2] == 2.0);
+    }
+}
+
+TEST(test_MappedFile, test_move)
+{
+    writeAsciiSTL("./cube_mapped.stl");
+    MappedFile file("./cube_mapped.stl");
+    const char *data = file.Data();
+    size_t size = file.Size();
+    MappedFile moved_file(std::move(file));
+    EXPECT_EQ(moved_file.Data(), data);
+    EXPECT_EQ(moved_file.Size(), size);
+    EXPECT_EQ(file.Size(), 0);
+    EXPECT_EQ(std::string(moved_file.Data(), 5), "solid");
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,124 @@
+#include "loop_partitioner.hpp"
+#include "particle_iterators.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** Exposes the candidate selection so that it can be tested with given timings. */
+class TestLoopPartitioner : public LoopPartitioner
+{
+  public:
+    explicit TestLoopPartitioner(size_t samples_per_candidate)
+        : LoopPartitioner(samples_per_candidate){};
+    size_t NumberOfCandidates() { return candidates_.size(); };
+    size_t NextCandidate() { return nextCandidate(); };
+    void RecordTime(size_t candidate, size_t size, Real seconds)
+    {
+        recordTime(candidate, size, TimeInterval(seconds));
+    };
+};
+
+TEST(test_LoopPartitioner, test_fastest_candidate_chosen)
+{
+    TestLoopPartitioner loop_partitioner(2);
+    size_t number_of_candidates = loop_partitioner.NumberOfCandidates();
+    /** each candidate is sampled in turn, the fastest sample of a candidate counts */
+    for (size_t sample = 0; sample != 2; ++sample)
+    {
+        for (size_t k = 0; k != number_of_candidates; ++k)
+        {
+            EXPECT_FALSE(loop_partitioner.isTuned());
+            size_t candidate = loop_partitioner.NextCandidate();
+            EXPECT_EQ(candidate, k);
+            Real seconds = candidate == 4 && sample == 1 ? 0.5 : 1.0 + Real(k);
+            loop_partitioner.RecordTime(candidate, 1000, seconds);
+        }
+    }
+    EXPECT_TRUE(loop_partitioner.isTuned());
+    EXPECT_EQ(loop_partitioner.NextCandidate(), 4u);
+    EXPECT_EQ(loop_partitioner.ChosenPartitioner(), "simple partitioner with grain size 64");
+
+    /** timings after tuning do not change the choice */
+    loop_partitioner.RecordTime(0, 1000, 0.0);
+    EXPECT_EQ(loop_partitioner.NextCandidate(), 4u);
+}
+
+TEST(test_LoopPartitioner, test_time_per_index)
+{
+    TestLoopPartitioner loop_partitioner(1);
+    size_t number_of_candidates = loop_partitioner.NumberOfCandidates();
+    /** a candidate sampled on a larger loop is compared by its time per index */
+    for (size_t k = 0; k != number_of_candidates; ++k)
+    {
+        size_t size = k == 2 ? 10000 : 100;
+        loop_partitioner.RecordTime(loop_partitioner.NextCandidate(), size, 1.0);
+    }
+    EXPECT_TRUE(loop_partitioner.isTuned());
+    EXPECT_EQ(loop_partitioner.ChosenPartitioner(), "affinity partitioner with grain size 256");
+}
+
+TEST(test_LoopPartitioner, test_tuning_switched_off)
+{
+    LoopPartitioner::autotuning_ = false;
+    TestLoopPartitioner default_partitioner(2);
+    LoopPartitioner::autotuning_ = true;
+    EXPECT_TRUE(default_partitioner.isTuned());
+    EXPECT_EQ(default_partitioner.ChosenPartitioner(), "affinity partitioner with grain size 1");
+
+    NumaAwareness::first_touch_ = true;
+    TestLoopPartitioner numa_aware_partitioner(2);
+    NumaAwareness::first_touch_ = false;
+    EXPECT_TRUE(numa_aware_partitioner.isTuned());
+    EXPECT_EQ(numa_aware_partitioner.ChosenPartitioner(), "static partitioner with grain size 1");
+}
+
+TEST(test_LoopPartitioner, test_particle_loops)
+{
+    size_t total_particles = 5000;
+    IndexVector body_part_particles;
+    for (size_t i = 0; i < total_particles; i += 3)
+        body_part_particles.push_back(i);
+
+    LoopPartitioner for_partitioner(1);
+    LoopPartitioner reduce_partitioner(1);
+    StdLargeVec<int> visits(total_particles, 0);
+    size_t number_of_loops = 0;
+    /** the results are the same with each candidate during tuning and after it */
+    while (!for_partitioner.isTuned() || number_of_loops < 20)
+    {
+        particle_for(
+            execution::ParallelPolicy(), total_particles,
+            [&](size_t index_i)
+            { visits[index_i]++; },
+            for_partitioner);
+        particle_for(
+            execution::ParallelPolicy(), body_part_particles,
+            [&](size_t index_i)
+            { visits[index_i]++; },
+            for_partitioner);
+        size_t sum = particle_reduce(
+            execution::ParallelPolicy(), body_part_particles, size_t(0), std::plus<size_t>(),
+            [&](size_t index_i) -> size_t
+            { return index_i; },
+            reduce_partitioner);
+        EXPECT_EQ(sum, 3 * (body_part_particles.size() - 1) * body_part_particles.size() / 2);
+        number_of_loops++;
+    }
+    EXPECT_TRUE(reduce_partitioner.isTuned());
+    for (size_t i = 0; i != total_particles; ++i)
+        EXPECT_EQ(visits[i], i % 3 == 0 ? 2 * number_of_loops : number_of_loops);
+
+    /** the sequenced loops ignore the partitioner */
+    size_t count = particle_reduce(
+        execution::SequencedPolicy(), total_particles, size_t(0), std::plus<size_t>(),
+        [&](size_t index_i) -> size_t
+        { return 1; },
+        reduce_partitioner);
+    EXPECT_EQ(count, total_particles);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,91 @@
+#include "allocation_counter.h"
+#include "particle_iterators.h"
+#include "scratch_arena.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+TEST(test_ScratchArena, test_nested_scopes)
+{
+    ScratchArena &arena = ScratchArena::local();
+    ScratchScope outer_scope;
+    double *outer = outer_scope.allocate<double>(3);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(outer) % alignof(double), 0u);
+
+    char *inner_first = nullptr;
+    {
+        ScratchScope inner_scope;
+        inner_first = inner_scope.allocate<char>(5);
+        size_t *inner_second = inner_scope.allocate<size_t>(2);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(inner_second) % alignof(size_t), 0u);
+        EXPECT_GE(reinterpret_cast<char *>(inner_second), inner_first + 5);
+    }
+    /** the memory of the inner scope is given out again */
+    EXPECT_EQ(outer_scope.allocate<char>(1), inner_first);
+    EXPECT_EQ(arena.NumberOfBlocks(), 1u);
+}
+
+TEST(test_ScratchArena, test_blocks_merged_after_use)
+{
+    ScratchArena &arena = ScratchArena::local();
+    size_t capacity = arena.Capacity();
+    {
+        ScratchScope scratch_scope;
+        for (size_t k = 0; k != 4; ++k)
+            scratch_scope.allocate<char>(capacity + 1);
+        EXPECT_GT(arena.NumberOfBlocks(), 1u);
+    }
+    EXPECT_EQ(arena.NumberOfBlocks(), 1u);
+    EXPECT_GE(arena.Capacity(), 4 * (capacity + 1));
+    /** now the same temporaries fit without allocation */
+    AllocationScope allocation_scope;
+    {
+        ScratchScope scratch_scope;
+        for (size_t k = 0; k != 4; ++k)
+            scratch_scope.allocate<char>(capacity + 1);
+    }
+    EXPECT_EQ(allocation_scope.Allocations(), 0u);
+}
+
+TEST(test_ScratchArena, test_cell_loops_without_allocation)
+{
+    if (!AllocationCounter::isCounting())
+        GTEST_SKIP() << "Allocations are only counted with SPHINXSYS_COUNT_ALLOCATIONS.";
+
+    size_t number_of_cells = 5000;
+    StdVec<ConcurrentIndexVector> cells(number_of_cells);
+    ConcurrentCellLists cell_lists;
+    size_t total_particles = 0;
+    for (size_t i = 0; i != number_of_cells; ++i)
+    {
+        for (size_t k = 0; k != i % 7; ++k)
+            cells[i].push_back(total_particles++);
+        cell_lists.push_back(&cells[i]);
+    }
+    StdLargeVec<int> visits(total_particles, 0);
+    auto visit = [&](size_t index_i)
+    { visits[index_i]++; };
+    auto count = [&](size_t index_i) -> size_t
+    { return 1; };
+
+    /** the first loops take the scratch memory */
+    particle_for(execution::ParallelPolicy(), cell_lists, visit);
+    particle_reduce(execution::ParallelPolicy(), cell_lists, size_t(0), std::plus<size_t>(), count);
+
+    AllocationScope allocation_scope;
+    for (size_t n = 0; n != 10; ++n)
+    {
+        particle_for(execution::ParallelPolicy(), cell_lists, visit);
+        EXPECT_EQ(particle_reduce(execution::ParallelPolicy(), cell_lists, size_t(0), std::plus<size_t>(), count),
+                  total_particles);
+    }
+    EXPECT_TRUE(allocation_scope.checkNoAllocation("the cell loops"));
+    for (size_t i = 0; i != total_particles; ++i)
+        EXPECT_EQ(visits[i], 11);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
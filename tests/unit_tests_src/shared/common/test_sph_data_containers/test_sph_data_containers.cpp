@@ -11,6 +11,89 @@ TEST(sph_data_containers, getIntersectionOfBoundingBoxes)
     EXPECT_EQ(bb_ref, getIntersectionOfBoundingBoxes(bb_1, bb_2));
 }
 
+TEST(sph_data_containers, SingleRealStorage)
+{
+    EXPECT_EQ(sizeof(SingleReal), sizeof(float));
+    StdLargeVec<SingleReal> stored(3, ZeroData<SingleReal>::value);
+    stored[0] = Real(1.0) / Real(3.0);
+    Real loaded = stored[0];
+    EXPECT_EQ(loaded, Real(float(1.0 / 3.0)));
+
+    stored[1] += 4.0;
+    stored[1] -= 1.0;
+    stored[1] *= 0.5;
+    EXPECT_EQ(Real(stored[1]), 1.5);
+
+    std::ostringstream out;
+    out << stored[1];
+    SingleReal read_back;
+    std::istringstream(out.str()) >> read_back;
+    EXPECT_EQ(Real(read_back), 1.5);
+}
+
+/** sums the values of all scalar variables, promoted to Real */
+struct SumParticleVariables
+{
+    std::map<std::string, Real> sums_;
+
+    template <typename DataType>
+    void operator()(const std::string &name, StdLargeVec<DataType> &variable)
+    {
+        if constexpr (std::is_convertible<DataType, Real>::value)
+        {
+            Real sum = 0.0;
+            for (const DataType &value : variable)
+                sum += value;
+            sums_[name] = sum;
+        }
+    }
+};
+
+TEST(sph_data_containers, SingleRealInParticleData)
+{
+    ParticleData particle_data;
+    ParticleVariables particle_variables;
+    DataContainerUniquePtrAssemble<DiscreteVariable> variable_ptrs;
+
+    StdLargeVec<Real> real_variable(4, 0.25);
+    StdLargeVec<SingleReal> single_variable(4, SingleReal(0.5));
+    std::get<DataTypeIndex<Real>::value>(particle_data).push_back(&real_variable);
+    addVariableToAssemble<Real>(particle_variables, variable_ptrs, "RealVariable", 0);
+    std::get<DataTypeIndex<SingleReal>::value>(particle_data).push_back(&single_variable);
+    addVariableToAssemble<SingleReal>(particle_variables, variable_ptrs, "SingleVariable", 0);
+
+    EXPECT_NE(findVariableByName<SingleReal>(particle_variables, "SingleVariable"), nullptr);
+    EXPECT_EQ(findVariableByName<Real>(particle_variables, "SingleVariable"), nullptr);
+
+    SumParticleVariables sum_variables;
+    DataAssembleOperation<loopParticleVariables> loop_variables;
+    loop_variables(particle_data, particle_variables, sum_variables);
+    EXPECT_EQ(sum_variables.sums_["RealVariable"], 1.0);
+    EXPECT_EQ(sum_variables.sums_["SingleVariable"], 2.0);
+}
+
+TEST(sph_data_containers, gatherIndices)
+{
+    IndexVector indices;
+    for (size_t i = 0; i != 20000; ++i)
+        indices.push_back(3 * i);
+
+    /** the selected indices are in order, also when the gathered vector is reused */
+    IndexVector gathered;
+    for (size_t selected_every : {7, 2, 5})
+    {
+        gatherIndices(indices, gathered, [&](size_t n)
+                      { return n % selected_every == 0; });
+        ASSERT_EQ(gathered.size(), (indices.size() + selected_every - 1) / selected_every);
+        for (size_t k = 0; k != gathered.size(); ++k)
+            EXPECT_EQ(gathered[k], 3 * selected_every * k);
+    }
+
+    gatherIndices(indices, gathered, [&](size_t n)
+                  { return false; });
+    EXPECT_TRUE(gathered.empty());
+}
+
 //=================================================================================================//
 //=================================================================================================//
 int main(int argc, char *argv[])
@@ -0,0 +1,90 @@
+#include "particle_iterators.h"
+#include "work_balanced_range.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** cells with uneven numbers of particles, as near free surfaces and walls. */
+class CellListsForTest
+{
+  public:
+    explicit CellListsForTest(size_t number_of_cells) : cells_(number_of_cells)
+    {
+        size_t total_particles = 0;
+        for (size_t i = 0; i != number_of_cells; ++i)
+        {
+            size_t particles_in_cell = i % 100 == 0 ? 50 : (i * 7) % 13;
+            for (size_t n = 0; n != particles_in_cell; ++n)
+                cells_[i].push_back(total_particles++);
+            cell_lists_.push_back(&cells_[i]);
+        }
+    };
+    StdVec<ConcurrentIndexVector> cells_;
+    ConcurrentCellLists cell_lists_;
+};
+
+TEST(test_WorkBalancedRange, test_cell_work_prefix)
+{
+    for (size_t number_of_cells : {size_t(0), size_t(1), size_t(1000), size_t(100000)})
+    {
+        CellListsForTest test_cells(number_of_cells);
+        StdVec<size_t> work_prefix(number_of_cells + 1, 1);
+        computeCellWorkPrefix(test_cells.cell_lists_, work_prefix.data());
+
+        size_t expected_prefix = 0;
+        EXPECT_EQ(work_prefix[0], 0u);
+        for (size_t i = 0; i != number_of_cells; ++i)
+        {
+            expected_prefix += test_cells.cells_[i].size() + 1;
+            ASSERT_EQ(work_prefix[i + 1], expected_prefix);
+        }
+    }
+}
+
+TEST(test_WorkBalancedRange, test_split_by_work)
+{
+    size_t number_of_cells = 20000;
+    CellListsForTest test_cells(number_of_cells);
+    StdVec<size_t> work_prefix(number_of_cells + 1);
+    computeCellWorkPrefix(test_cells.cell_lists_, work_prefix.data());
+
+    size_t grain_work = 256;
+    WorkBalancedRange range(0, number_of_cells, work_prefix.data(), grain_work);
+    StdVec<WorkBalancedRange> leaves;
+    StdVec<WorkBalancedRange> to_split(1, range);
+    while (!to_split.empty())
+    {
+        WorkBalancedRange lower = to_split.back();
+        to_split.pop_back();
+        if (!lower.is_divisible())
+        {
+            leaves.push_back(lower);
+            continue;
+        }
+        WorkBalancedRange upper(lower, tbb::split());
+        EXPECT_FALSE(lower.empty());
+        EXPECT_FALSE(upper.empty());
+        EXPECT_EQ(lower.end(), upper.begin());
+        /** the halves differ in work by at most the work of one cell */
+        size_t difference = lower.Work() > upper.Work() ? lower.Work() - upper.Work() : upper.Work() - lower.Work();
+        EXPECT_LE(difference, 2 * (50 + 1));
+        to_split.push_back(lower);
+        to_split.push_back(upper);
+    }
+
+    StdVec<int> visits(number_of_cells, 0);
+    for (const WorkBalancedRange &leaf : leaves)
+    {
+        EXPECT_TRUE(leaf.size() == 1 || leaf.Work() <= grain_work);
+        for (size_t i = leaf.begin(); i != leaf.end(); ++i)
+            visits[i]++;
+    }
+    for (size_t i = 0; i != number_of_cells; ++i)
+        EXPECT_EQ(visits[i], 1);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file 	test_domain_decomposition.cpp
+ * @brief 	Partition, migration, halo exchange and global reduction of a block of particles,
+ *			generated on all processes or distributed over the processes.
+ * @details Run with several processes if the library is built with MPI, e.g. mpirun -np 4.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real resolution_ref = 0.05;
+Vec3d halfsize(0.5, 0.25, 0.25);
+BoundingBox system_domain_bounds(Vec3d(-0.6, -0.6, -0.6), Vec3d(0.6, 0.6, 0.6));
+
+TEST(test_DomainDecomposition, test_partition_migration_and_halo)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "Block"));
+    block.defineParticlesAndMaterial<SolidParticles, Solid>();
+    block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = block.getBaseParticles();
+    size_t total_particles = particles.total_real_particles_;
+    Real total_volume = 0.0;
+    for (size_t i = 0; i != total_particles; ++i)
+        total_volume += particles.Vol_[i];
+
+    /** All processes generate the same particles and keep their own ones. */
+    RecursiveBisection recursive_bisection;
+    recursive_bisection.partition({&block});
+    DomainDecomposition domain_decomposition(block, recursive_bisection);
+    domain_decomposition.removeParticlesOfOtherProcesses();
+
+    size_t local_particles = particles.total_real_particles_;
+    size_t global_particles = local_particles;
+    MPIEnvironment::allReduce(&global_particles, 1, MPIEnvironment::ReduceOperation::Sum);
+    EXPECT_EQ(global_particles, total_particles);
+    /** balanced to within a layer of particles */
+    Real layer_particles = 4.0 * halfsize[1] * halfsize[2] / resolution_ref / resolution_ref;
+    EXPECT_NEAR((Real)local_particles, (Real)total_particles / (Real)MPIEnvironment::Size(), layer_particles);
+
+    /** Shift all particles, so that some migrate to the neighboring process. */
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        particles.pos_[i][0] += 2.5 * resolution_ref;
+    domain_decomposition.updateCellLinkedList();
+
+    global_particles = particles.total_real_particles_;
+    MPIEnvironment::allReduce(&global_particles, 1, MPIEnvironment::ReduceOperation::Sum);
+    EXPECT_EQ(global_particles, total_particles);
+    int rank = MPIEnvironment::Rank();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        EXPECT_EQ(recursive_bisection.OwnerRank(particles.pos_[i]), rank);
+
+    /** Halo particles are those of other processes within the cut-off radius of this subdomain. */
+    Real cut_off_radius = block.sph_adaptation_->getKernel()->CutOffRadius();
+    BoundingBox &subdomain = recursive_bisection.Subdomain(rank);
+    size_t first_halo = particles.real_particles_bound_;
+    for (size_t i = first_halo; i != first_halo + domain_decomposition.TotalHaloParticles(); ++i)
+    {
+        Vecd gap = (subdomain.first_ - particles.pos_[i]).cwiseMax(particles.pos_[i] - subdomain.second_);
+        EXPECT_GE(gap.maxCoeff(), 0.0);
+        EXPECT_LT(gap.cwiseMax(Vecd::Zero()).norm(), cut_off_radius);
+    }
+    if (MPIEnvironment::Size() > 1)
+        EXPECT_GT(domain_decomposition.TotalHaloParticles(), 0u);
+
+    /** The global ids of the real particles are a permutation of the initial indices. */
+    StdLargeVec<int> &global_id = *particles.getVariableByName<int>("GlobalParticleId");
+    StdVec<int> id_counts(total_particles, 0);
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        id_counts[global_id[i]]++;
+    MPIEnvironment::allReduce(id_counts.data(), id_counts.size(), MPIEnvironment::ReduceOperation::Sum);
+    EXPECT_EQ(*std::min_element(id_counts.begin(), id_counts.end()), 1);
+    EXPECT_EQ(*std::max_element(id_counts.begin(), id_counts.end()), 1);
+    for (size_t i = first_halo; i != first_halo + domain_decomposition.TotalHaloParticles(); ++i)
+        EXPECT_LT((size_t)global_id[i], total_particles);
+
+    DistributedReduceDynamics<QuantitySummation<Real>> global_volume(block, "VolumetricMeasure");
+    EXPECT_NEAR(global_volume.exec(), total_volume, 1.0e-6 * total_volume);
+}
+
+TEST(test_DomainDecomposition, test_distributed_generation)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "Block"));
+    block.defineParticlesAndMaterial<SolidParticles, Solid>();
+    /** Each process generates only a share of the particles. */
+    block.generateParticles<DistributedParticleGenerator<ParticleGeneratorLattice>>();
+    BaseParticles &particles = block.getBaseParticles();
+    size_t generated_particles = particles.total_real_particles_;
+    size_t total_particles = generated_particles;
+    MPIEnvironment::allReduce(&total_particles, 1, MPIEnvironment::ReduceOperation::Sum);
+    EXPECT_NEAR((Real)generated_particles, (Real)total_particles / (Real)MPIEnvironment::Size(), 1.0);
+
+    RecursiveBisection recursive_bisection;
+    recursive_bisection.partition({&block});
+    DomainDecomposition domain_decomposition(block, recursive_bisection);
+    domain_decomposition.updateCellLinkedList();
+
+    size_t global_particles = particles.total_real_particles_;
+    MPIEnvironment::allReduce(&global_particles, 1, MPIEnvironment::ReduceOperation::Sum);
+    EXPECT_EQ(global_particles, total_particles);
+    int rank = MPIEnvironment::Rank();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        EXPECT_EQ(recursive_bisection.OwnerRank(particles.pos_[i]), rank);
+    EXPECT_GE(particles.real_particles_bound_, particles.total_real_particles_);
+
+    StdLargeVec<int> &global_id = *particles.getVariableByName<int>("GlobalParticleId");
+    StdVec<int> id_counts(total_particles, 0);
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        id_counts[global_id[i]]++;
+    MPIEnvironment::allReduce(id_counts.data(), id_counts.size(), MPIEnvironment::ReduceOperation::Sum);
+    EXPECT_EQ(*std::min_element(id_counts.begin(), id_counts.end()), 1);
+    EXPECT_EQ(*std::max_element(id_counts.begin(), id_counts.end()), 1);
+}
+
+int main(int argc, char *argv[])
+{
+    MPIEnvironment mpi_environment(argc, argv);
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+#include "mesh_with_data_packages.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+TEST(test_SparseBlockAddresses, test_concurrent_assign_and_lookup)
+{
+    Arrayi all_cells = 24 * Arrayi::Ones();
+    size_t number_of_cells = all_cells.prod();
+    StdVec<int> packages(number_of_cells + 1);
+    int *far_field_pkg = &packages[number_of_cells];
+    auto cellIndex = [&](size_t n)
+    {
+        Arrayi cell_index;
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            cell_index[d] = n % all_cells[d];
+            n /= all_cells[d];
+        }
+        return cell_index;
+    };
+    /** the cells near a plane have their own packages, the others share the far-field one. */
+    auto isNearPlane = [&](const Arrayi &cell_index)
+    { return cell_index[0] == 11 || cell_index[0] == 12; };
+
+    for (size_t repeat = 0; repeat != 10; ++repeat)
+    {
+        SparseBlockAddresses<int> addresses(all_cells);
+        /** the blocks become uniform first and are expanded while their cells are looked up. */
+        parallel_for(
+            IndexRange(0, 2 * number_of_cells),
+            [&](const IndexRange &r)
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                {
+                    size_t n = i % number_of_cells;
+                    Arrayi cell_index = cellIndex(n);
+                    if (i < number_of_cells)
+                    {
+                        addresses.assignPackage(cell_index, isNearPlane(cell_index) ? &packages[n] : far_field_pkg);
+                    }
+                    else
+                    {
+                        /** a cell not assigned yet may give the package of another cell in the block. */
+                        int *data_pkg = addresses.PackageFromCellIndex(cell_index);
+                        EXPECT_TRUE(data_pkg == nullptr || (data_pkg >= &packages[0] && data_pkg <= far_field_pkg));
+                    }
+                }
+            },
+            tbb::simple_partitioner());
+
+        for (size_t n = 0; n != number_of_cells; ++n)
+        {
+            Arrayi cell_index = cellIndex(n);
+            EXPECT_EQ(addresses.PackageFromCellIndex(cell_index),
+                      isNearPlane(cell_index) ? &packages[n] : far_field_pkg);
+        }
+        /** only the blocks crossed by the plane are expanded. */
+        Arrayi number_of_blocks = all_cells / 8;
+        EXPECT_EQ(addresses.NumberOfExpandedBlocks(), (size_t)(number_of_blocks.prod() / number_of_blocks[0]));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
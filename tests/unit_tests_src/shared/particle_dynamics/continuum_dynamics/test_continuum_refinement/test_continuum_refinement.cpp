@@ -0,0 +1,103 @@
+/**
+ * @file 	test_continuum_refinement.cpp
+ * @brief 	Conservation of mass and momentum over a split and merge cycle of a plastic continuum body.
+ * @author 	Shuaihao Zhang and Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real resolution_ref = 0.1;
+Vec3d halfsize(0.4, 0.4, 0.2);
+BoundingBox system_domain_bounds(Vec3d(-0.8, -0.8, -0.6), Vec3d(0.8, 0.8, 0.6));
+Real rho0_s = 2600.0;
+Real Youngs_modulus = 5.98e6;
+Real poisson = 0.3;
+Real c_s = sqrt(Youngs_modulus / (rho0_s * 3.0 * (1.0 - 2.0 * poisson)));
+Real friction_angle = 30.0 * Pi / 180.0;
+
+/** Total mass, momentum and mass moment of the real particles. */
+struct ConservedQuantities
+{
+    Real mass_ = 0.0;
+    Vec3d momentum_ = Vec3d::Zero();
+    Vec3d mass_moment_ = Vec3d::Zero();
+
+    explicit ConservedQuantities(BaseParticles &particles)
+    {
+        for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        {
+            mass_ += particles.mass_[i];
+            momentum_ += particles.mass_[i] * particles.vel_[i];
+            mass_moment_ += particles.mass_[i] * particles.pos_[i];
+        }
+    };
+
+    void checkEqual(const ConservedQuantities &other)
+    {
+        EXPECT_NEAR(mass_, other.mass_, 1.0e-10 * other.mass_);
+        for (int k = 0; k != 3; ++k)
+        {
+            EXPECT_NEAR(momentum_[k], other.momentum_[k], 1.0e-10 * other.mass_);
+            EXPECT_NEAR(mass_moment_[k], other.mass_moment_[k], 1.0e-10 * other.mass_);
+        }
+    };
+};
+
+TEST(test_ContinuumRefinement, test_split_and_merge_conservation)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    RealBody soil_block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "SoilBlock"));
+    soil_block.defineAdaptation<ParticleSplitAndMerge>(1.3, 1.0, 1);
+    soil_block.defineParticlesAndMaterial<PlasticContinuumParticles, PlasticContinuum>(
+        rho0_s, c_s, Youngs_modulus, poisson, friction_angle);
+    soil_block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = soil_block.getBaseParticles();
+    size_t initial_particles = particles.total_real_particles_;
+    /** a sheared and rotating velocity field so that merged particles have different velocities */
+    for (size_t i = 0; i != initial_particles; ++i)
+    {
+        Vec3d &position = particles.pos_[i];
+        particles.vel_[i] = Vec3d(position[1], -position[0] + position[2], 0.1 + position[0] * position[1]);
+    }
+    AdaptiveInnerRelation soil_block_inner(soil_block);
+
+    /** all particles are split inside the split region, and are merged outside of the merge region */
+    TransformShape<GeometricShapeBox> split_region(Transform(Vec3d::Zero()), 1.5 * halfsize, "SplitRegion");
+    TransformShape<GeometricShapeBox> merge_region(Transform(Vec3d(2.0, 2.0, 2.0)), halfsize, "MergeRegion");
+    InteractionWithUpdate<continuum_dynamics::PlasticSplitWithMinimumDensityErrorInner, SequencedPolicy>
+        particle_split(soil_block_inner, split_region, 2 * initial_particles, 1.0);
+    InteractionDynamics<continuum_dynamics::PlasticMergeWithMinimumDensityErrorInner, SequencedPolicy>
+        particle_merge(soil_block_inner, merge_region, 1.0);
+
+    soil_block.updateCellLinkedList();
+    soil_block_inner.updateConfiguration();
+    ConservedQuantities initial_quantities(particles);
+
+    particle_split.exec();
+    EXPECT_EQ(particles.total_real_particles_, 2 * initial_particles);
+    ConservedQuantities split_quantities(particles);
+    split_quantities.checkEqual(initial_quantities);
+
+    soil_block.updateCellLinkedList();
+    soil_block_inner.updateConfiguration();
+    particle_merge.exec();
+    size_t merged_particles = particles.total_real_particles_;
+    EXPECT_LT(merged_particles, 2 * initial_particles);
+    ConservedQuantities merge_quantities(particles);
+    merge_quantities.checkEqual(initial_quantities);
+
+    /** each merge removes one particle and keeps the density of the continuum */
+    for (size_t i = 0; i != merged_particles; ++i)
+    {
+        EXPECT_GT(particles.mass_[i], 0.0);
+        EXPECT_NEAR(particles.Vol_[i], particles.mass_[i] / particles.rho_[i], 1.0e-12);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
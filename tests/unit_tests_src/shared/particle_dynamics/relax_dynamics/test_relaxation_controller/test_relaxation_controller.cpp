@@ -0,0 +1,104 @@
+/**
+ * @file 	test_relaxation_controller.cpp
+ * @brief 	Neighbor reuse and convergence control of the particle relaxation.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real resolution_ref = 0.05;
+Vec3d halfsize(0.25, 0.25, 0.25);
+BoundingBox system_domain_bounds(Vec3d(-0.4, -0.4, -0.4), Vec3d(0.4, 0.4, 0.4));
+
+class Block : public ComplexShape
+{
+  public:
+    explicit Block(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize);
+    }
+};
+
+TEST(test_RelaxationStep, test_refreshed_neighbors)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    RealBody block(sph_system, makeShared<Block>("Block"));
+    block.defineParticlesAndMaterial();
+    block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = block.getBaseParticles();
+    InnerRelation block_inner(block);
+    block.updateCellLinkedList();
+    block_inner.updateConfiguration();
+
+    /** Particles move by the displacement in random directions, and the neighbor lists are refreshed. */
+    Real displacement = 0.1 * resolution_ref;
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+        particles.pos_[i] += displacement * Vecd::Random().normalized();
+    block_inner.refreshConfiguration();
+    ParticleConfiguration refreshed_configuration = block_inner.inner_configuration_;
+
+    block.updateCellLinkedList();
+    block_inner.updateConfiguration();
+    Real cut_off_radius = block.sph_adaptation_->getKernel()->CutOffRadius();
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        Neighborhood &refreshed = refreshed_configuration[i];
+        Neighborhood &updated = block_inner.inner_configuration_[i];
+        EXPECT_LE(refreshed.current_size_, updated.current_size_);
+        for (size_t m = 0; m != updated.current_size_; ++m)
+        {
+            size_t n = 0;
+            while (n != refreshed.current_size_ && refreshed.j_[n] != updated.j_[m])
+                ++n;
+            if (n == refreshed.current_size_)
+            {
+                /** only the neighbors which have entered the cut-off radius are missed */
+                EXPECT_GT(updated.r_ij_[m], cut_off_radius - 2.0 * displacement);
+                continue;
+            }
+            EXPECT_NEAR(refreshed.W_ij_[n], updated.W_ij_[m], 1.0e-9);
+            EXPECT_NEAR(refreshed.dW_ijV_j_[n], updated.dW_ijV_j_[m], 1.0e-9);
+            EXPECT_NEAR(refreshed.r_ij_[n], updated.r_ij_[m], 1.0e-12);
+            EXPECT_NEAR((refreshed.e_ij_[n] - updated.e_ij_[m]).norm(), 0.0, 1.0e-9);
+        }
+    }
+}
+
+TEST(test_RelaxationController, test_converged_relaxation)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    RealBody block(sph_system, makeShared<Block>("Block"));
+    block.defineBodyLevelSetShape();
+    block.defineParticlesAndMaterial();
+    block.generateParticles<ParticleGeneratorLattice>();
+    InnerRelation block_inner(block);
+
+    using namespace relax_dynamics;
+    SimpleDynamics<RandomizeParticlePosition> random_block_particles(block);
+    /** the level set correction accounts for the missing neighbors of the surface particles. */
+    RelaxationStepLevelSetCorrectionInner relaxation_step_inner(block_inner);
+    RelaxationController<RelaxationStepLevelSetCorrectionInner> relaxation_controller(relaxation_step_inner, 2000);
+    relaxation_controller.setNeighborSkin(0.1);
+    ReduceDynamics<RelaxationResidueNorm> relaxation_residue_norm(block);
+
+    random_block_particles.exec(0.25);
+    relaxation_step_inner.SurfaceBounding().exec();
+    relaxation_step_inner.requestConfigurationUpdate();
+    relaxation_step_inner.exec();
+    Real initial_residue_norm = relaxation_residue_norm.exec();
+
+    size_t relaxation_steps = relaxation_controller.exec();
+    /** not stopped by stagnation before the minimum number of iterations */
+    if (relaxation_steps < 200)
+        EXPECT_LT(relaxation_controller.ResidueNorm(), 1.0e-3);
+    EXPECT_LT(relaxation_steps, size_t(2000));
+    EXPECT_LT(relaxation_controller.ResidueNorm(), 0.5 * initial_residue_norm);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file 	test_dynamics_task_graph.cpp
+ * @brief 	Dependencies and results of dynamics of two bodies executed by a task graph.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real resolution_ref = 0.1;
+Vec3d halfsize(0.5, 0.3, 0.2);
+BoundingBox system_domain_bounds(Vec3d(-0.6, -0.6, -0.6), Vec3d(0.6, 0.6, 0.6));
+
+/** shift the particles along x by the time step. */
+class ShiftAlongX : public LocalDynamics, public GeneralDataDelegateSimple
+{
+  public:
+    explicit ShiftAlongX(SPHBody &sph_body)
+        : LocalDynamics(sph_body), GeneralDataDelegateSimple(sph_body), pos_(particles_->pos_){};
+    virtual ~ShiftAlongX(){};
+    void update(size_t index_i, Real dt = 0.0) { pos_[index_i][0] += dt; };
+
+  protected:
+    StdLargeVec<Vecd> &pos_;
+};
+
+/** copy the x coordinates of the particles of another body with the same particles to the y coordinates. */
+class CopyXToY : public LocalDynamics, public GeneralDataDelegateSimple
+{
+  public:
+    CopyXToY(SPHBody &sph_body, SPHBody &source_body)
+        : LocalDynamics(sph_body), GeneralDataDelegateSimple(sph_body), pos_(particles_->pos_),
+          source_pos_(source_body.getBaseParticles().pos_){};
+    virtual ~CopyXToY(){};
+    void update(size_t index_i, Real dt = 0.0) { pos_[index_i][1] = source_pos_[index_i][0]; };
+
+  protected:
+    StdLargeVec<Vecd> &pos_;
+    StdLargeVec<Vecd> &source_pos_;
+};
+
+/** scale the volumetric measure of the particles. */
+class ScaleVolume : public LocalDynamics, public GeneralDataDelegateSimple
+{
+  public:
+    explicit ScaleVolume(SPHBody &sph_body)
+        : LocalDynamics(sph_body), GeneralDataDelegateSimple(sph_body), Vol_(particles_->Vol_){};
+    virtual ~ScaleVolume(){};
+    void update(size_t index_i, Real dt = 0.0) { Vol_[index_i] *= 2.0; };
+
+  protected:
+    StdLargeVec<Real> &Vol_;
+};
+
+TEST(test_DynamicsTaskGraph, test_two_bodies)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody body_a(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "BodyA"));
+    body_a.defineParticlesAndMaterial<BaseParticles, Solid>();
+    body_a.generateParticles<ParticleGeneratorLattice>();
+    SolidBody body_b(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "BodyB"));
+    body_b.defineParticlesAndMaterial<BaseParticles, Solid>();
+    body_b.generateParticles<ParticleGeneratorLattice>();
+    StdLargeVec<Vecd> &pos_a = body_a.getBaseParticles().pos_;
+    StdLargeVec<Vecd> &pos_b = body_b.getBaseParticles().pos_;
+    StdLargeVec<Vecd> initial_pos_a = pos_a;
+    StdLargeVec<Vecd> initial_pos_b = pos_b;
+    StdLargeVec<Real> initial_Vol_a = body_a.getBaseParticles().Vol_;
+    size_t total_particles = body_a.getBaseParticles().total_real_particles_;
+    ASSERT_EQ(body_b.getBaseParticles().total_real_particles_, total_particles);
+
+    SimpleDynamics<ShiftAlongX> first_shift_a(body_a);
+    SimpleDynamics<ShiftAlongX> first_shift_b(body_b);
+    SimpleDynamics<ShiftAlongX> second_shift_b(body_b);
+    SimpleDynamics<ShiftAlongX> second_shift_a(body_a);
+    SimpleDynamics<CopyXToY> copy_a_to_b(body_b, body_a);
+    SimpleDynamics<ScaleVolume> scale_volume_a(body_a);
+
+    Real dt_a = 0.1;
+    Real dt = 0.2;
+    DynamicsTaskGraph task_graph;
+    task_graph.addDynamics(first_shift_a, {},
+                           {VariableAccess(body_a, "Position"),
+                            VariableAccess(body_a, VariableAccess::DataType::CellLinkedList)},
+                           &dt_a);
+    task_graph.addDynamics(first_shift_b, {}, {VariableAccess(body_b, "Position")});
+    task_graph.addDynamics(second_shift_b, {VariableAccess(body_a, VariableAccess::DataType::CellLinkedList)},
+                           {VariableAccess(body_b, "Position")});
+    task_graph.addDynamics(second_shift_a, {}, {VariableAccess(body_a, "Position")});
+    task_graph.addDynamics(copy_a_to_b, {VariableAccess(body_a, "Position")}, {VariableAccess(body_b, "Position")});
+    task_graph.addDynamics(scale_volume_a, {}, {VariableAccess(body_a, "VolumetricMeasure")});
+
+    size_t number_of_executions = 3;
+    for (size_t n = 0; n != number_of_executions; ++n)
+        task_graph.exec(dt);
+
+    /** a dynamics waits for the earlier ones which write the data it reads or writes, also of the same body. */
+    EXPECT_EQ(task_graph.NumberOfPredecessors(0), 0u);
+    EXPECT_EQ(task_graph.NumberOfPredecessors(1), 0u);
+    EXPECT_EQ(task_graph.NumberOfPredecessors(2), 2u);
+    EXPECT_EQ(task_graph.NumberOfPredecessors(3), 1u);
+    EXPECT_EQ(task_graph.NumberOfPredecessors(4), 4u);
+    EXPECT_EQ(task_graph.NumberOfPredecessors(5), 0u);
+
+    /** each dynamics uses its own time step, and the copy sees both shifts of body A. */
+    Real shift_a = Real(number_of_executions) * (dt_a + dt);
+    Real shift_b = Real(number_of_executions) * 2.0 * dt;
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        EXPECT_NEAR(pos_a[i][0], initial_pos_a[i][0] + shift_a, 1.0e-6);
+        EXPECT_NEAR(pos_b[i][0], initial_pos_b[i][0] + shift_b, 1.0e-6);
+        EXPECT_NEAR(pos_b[i][1], pos_a[i][0], 1.0e-6);
+        EXPECT_NEAR(body_a.getBaseParticles().Vol_[i], initial_Vol_a[i] * 8.0, 1.0e-12);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,192 @@
+#include "inner_interaction_plan.hpp"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** a hand-made configuration, with neighbors of particle i at i + 1, i + 3 and i - 2 (if exist) */
+ParticleConfiguration buildConfiguration(size_t total_particles)
+{
+    ParticleConfiguration configuration(total_particles);
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        Neighborhood &neighborhood = configuration[i];
+        for (int offset : {3, 1, -2})
+        {
+            int j = int(i) + offset;
+            if (j < 0 || j >= int(total_particles))
+                continue;
+            Real distance = Real(std::abs(offset));
+            neighborhood.j_.push_back(j);
+            neighborhood.W_ij_.push_back(1.0 / distance);
+            neighborhood.dW_ijV_j_.push_back(-2.0 / distance);
+            neighborhood.r_ij_.push_back(distance);
+            neighborhood.e_ij_.push_back(Real(offset > 0 ? -1 : 1) * Vecd::UnitX());
+            neighborhood.allocated_size_++;
+            neighborhood.current_size_++;
+        }
+    }
+    /** a stale neighbor beyond the current size is not compiled */
+    configuration[0].j_.push_back(7);
+    return configuration;
+}
+
+template <class NeighborhoodType>
+Vecd gradientOfIndex(size_t index_i, const NeighborhoodType &neighborhood)
+{
+    Vecd gradient = Vecd::Zero();
+    for (size_t n = 0; n != neighborhood.current_size_; ++n)
+    {
+        size_t index_j = neighborhood.j_[n];
+        gradient += (Real(index_i) - Real(index_j)) * neighborhood.dW_ijV_j_[n] * neighborhood.e_ij_[n];
+    }
+    return gradient;
+}
+
+TEST(test_InnerInteractionPlan, test_compiled_neighbors)
+{
+    size_t total_particles = 100;
+    ParticleConfiguration configuration = buildConfiguration(total_particles);
+    InnerInteractionPlan<Real> plan;
+    EXPECT_FALSE(plan.isCompiled());
+    plan.compile(configuration, total_particles);
+    EXPECT_TRUE(plan.isCompiled());
+    EXPECT_EQ(plan.NumberOfParticles(), total_particles);
+
+    size_t number_of_pairs = 0;
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        const Neighborhood &neighborhood = configuration[i];
+        PlannedNeighborhood<Real> planned = plan[i];
+        ASSERT_EQ(planned.current_size_, neighborhood.current_size_);
+        number_of_pairs += planned.current_size_;
+        for (size_t n = 1; n < planned.current_size_; ++n)
+            EXPECT_LT(planned.j_[n - 1], planned.j_[n]);
+        for (size_t n = 0; n != planned.current_size_; ++n)
+        {
+            Real distance = std::abs(Real(planned.j_[n]) - Real(i));
+            EXPECT_EQ(planned.r_ij_[n], Real(distance));
+            EXPECT_EQ(planned.W_ij_[n], Real(1.0 / distance));
+        }
+        EXPECT_NEAR((gradientOfIndex(i, planned) - gradientOfIndex(i, neighborhood)).norm(), 0.0, 1.0e-6);
+    }
+    EXPECT_EQ(plan.NumberOfPairs(), number_of_pairs);
+}
+
+TEST(test_InnerInteractionPlan, test_single_precision)
+{
+    size_t total_particles = 100;
+    ParticleConfiguration configuration = buildConfiguration(total_particles);
+    InnerInteractionPlan<Real> plan;
+    plan.compile(configuration, total_particles);
+    InnerInteractionPlan<SingleReal> single_precision_plan;
+    single_precision_plan.compile(configuration, total_particles);
+    EXPECT_LT(single_precision_plan.MemoryBytes(), plan.MemoryBytes());
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        PlannedNeighborhood<SingleReal> planned = single_precision_plan[i];
+        ASSERT_EQ(planned.current_size_, plan[i].current_size_);
+        for (size_t n = 0; n != planned.current_size_; ++n)
+        {
+            EXPECT_EQ(planned.j_[n], plan[i].j_[n]);
+            EXPECT_NEAR(planned.W_ij_[n], plan[i].W_ij_[n], 1.0e-6);
+        }
+        EXPECT_NEAR((gradientOfIndex(i, planned) - gradientOfIndex(i, configuration[i])).norm(), 0.0, 1.0e-4);
+    }
+}
+
+/** A block in total Lagrangian formulation, identical for each name. */
+class Block : public ComplexShape
+{
+  public:
+    explicit Block(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), Vec3d(0.3, 0.2, 0.1));
+    }
+};
+
+/** A smooth deformation of the initial positions. */
+void deform(BaseParticles &particles)
+{
+    for (size_t i = 0; i != particles.total_real_particles_; ++i)
+    {
+        Vecd &position = particles.pos_[i];
+        position += 0.05 * Vecd(sin(3.0 * position[1]), position[0] * position[2], cos(2.0 * position[0]));
+    }
+}
+
+TEST(test_InnerInteractionPlan, test_frozen_topology)
+{
+    BoundingBox system_domain_bounds(Vec3d(-0.5, -0.5, -0.5), Vec3d(0.5, 0.5, 0.5));
+    SPHSystem sph_system(system_domain_bounds, 0.025);
+    StdVec<SharedPtr<SolidBody>> blocks;
+    StdVec<SharedPtr<InnerRelation>> inner_relations;
+    for (const std::string &name : {"Unfrozen", "Frozen", "SinglePrecision"})
+    {
+        blocks.push_back(makeShared<SolidBody>(sph_system, makeShared<Block>(name)));
+        blocks.back()->defineParticlesAndMaterial<ElasticSolidParticles, SaintVenantKirchhoffSolid>(1.0, 1.0, 0.3);
+        blocks.back()->generateParticles<ParticleGeneratorLattice>();
+        inner_relations.push_back(makeShared<InnerRelation>(*blocks.back()));
+    }
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    size_t total_particles = blocks[0]->getBaseParticles().total_real_particles_;
+    size_t total_pairs = 0;
+    for (size_t i = 0; i != total_particles; ++i)
+        total_pairs += inner_relations[1]->inner_configuration_[i].current_size_;
+    inner_relations[1]->freezeTopology();
+    inner_relations[2]->freezeTopology(true);
+    EXPECT_FALSE(inner_relations[0]->isFrozen());
+    EXPECT_TRUE(inner_relations[1]->isFrozen());
+    EXPECT_TRUE(inner_relations[2]->isFrozen());
+    EXPECT_EQ(inner_relations[1]->inner_plan_.NumberOfPairs(), total_pairs);
+    /** the configuration of a frozen relation is kept for the dynamics reading it directly. */
+    StdVec<size_t> frozen_sizes(total_particles);
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        frozen_sizes[i] = inner_relations[1]->inner_configuration_[i].current_size_;
+        ASSERT_EQ(frozen_sizes[i], inner_relations[1]->inner_plan_[i].current_size_);
+    }
+
+    StdVec<SharedPtr<InteractionWithUpdate<KernelCorrectionMatrixInner>>> corrections;
+    StdVec<SharedPtr<InteractionDynamics<solid_dynamics::DeformationGradientBySummation>>> deformation_gradients;
+    for (size_t k = 0; k != blocks.size(); ++k)
+    {
+        corrections.push_back(makeShared<InteractionWithUpdate<KernelCorrectionMatrixInner>>(*inner_relations[k]));
+        deformation_gradients.push_back(
+            makeShared<InteractionDynamics<solid_dynamics::DeformationGradientBySummation>>(*inner_relations[k]));
+        corrections[k]->exec();
+        deform(blocks[k]->getBaseParticles());
+        /** updates of a frozen relation are skipped, so that it keeps the initial configuration. */
+        if (inner_relations[k]->isFrozen())
+        {
+            blocks[k]->updateCellLinkedList();
+            inner_relations[k]->updateConfiguration();
+        }
+        deformation_gradients[k]->exec();
+    }
+    EXPECT_EQ(inner_relations[1]->inner_plan_.NumberOfPairs(), total_pairs);
+    for (size_t i = 0; i != total_particles; ++i)
+        ASSERT_EQ(inner_relations[1]->inner_configuration_[i].current_size_, frozen_sizes[i]);
+
+    /** same results up to the summation order, or the single precision. */
+    StdLargeVec<Matd> &B = *blocks[0]->getBaseParticles().getVariableByName<Matd>("KernelCorrectionMatrix");
+    StdLargeVec<Matd> &F = *blocks[0]->getBaseParticles().getVariableByName<Matd>("DeformationGradient");
+    for (size_t k = 1; k != blocks.size(); ++k)
+    {
+        Real tolerance = k == 1 ? 1.0e-10 : 1.0e-4;
+        StdLargeVec<Matd> &frozen_B = *blocks[k]->getBaseParticles().getVariableByName<Matd>("KernelCorrectionMatrix");
+        StdLargeVec<Matd> &frozen_F = *blocks[k]->getBaseParticles().getVariableByName<Matd>("DeformationGradient");
+        for (size_t i = 0; i != total_particles; ++i)
+        {
+            ASSERT_NEAR((frozen_B[i] - B[i]).norm(), 0.0, tolerance * B[i].norm());
+            ASSERT_NEAR((frozen_F[i] - F[i]).norm(), 0.0, tolerance * F[i].norm());
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,59 @@
+/**
+ * @file 	test_particle_creation_deletion.cpp
+ * @brief 	Bulk creation and deletion of particles, which keeps the real particles continuous.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real resolution_ref = 0.1;
+Vec3d halfsize(0.5, 0.3, 0.2);
+BoundingBox system_domain_bounds(Vec3d(-0.6, -0.6, -0.6), Vec3d(0.6, 0.6, 0.6));
+
+TEST(test_BaseParticles, test_commit_creation_and_deletion)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "Block"));
+    block.defineParticlesAndMaterial<BaseParticles, Solid>();
+    block.generateParticles<ParticleGeneratorLattice>();
+    BaseParticles &particles = block.getBaseParticles();
+    size_t total_particles = particles.total_real_particles_;
+    size_t total_created = 5;
+    particles.addBufferParticles(total_created);
+
+    /** the generated particles are labelled by their original ids in the volume. */
+    for (size_t i = 0; i != total_particles; ++i)
+        particles.Vol_[i] = Real(particles.unsorted_id_[i]);
+    StdVec<size_t> sources = {0, 7, total_particles - 1, total_particles - 3, 11};
+    for (size_t source : sources)
+        particles.createParticleFrom(source);
+    /** gaps at the front and deleted particles behind the new bound, created ones become movers. */
+    StdVec<size_t> deleted = {total_particles - 2, 3, 1, total_particles - 1, total_particles / 2, 4, 2, 9};
+    for (size_t index : deleted)
+        particles.markParticleForDeletion(index);
+    particles.commitParticleCreationAndDeletion();
+
+    size_t total_remaining = total_particles + total_created - deleted.size();
+    ASSERT_EQ(particles.total_real_particles_, total_remaining);
+    /** each remaining generated particle once, each source once more for its copy. */
+    StdVec<int> counts(total_particles, 0);
+    for (size_t i = 0; i != total_remaining; ++i)
+        counts[(size_t)particles.Vol_[i]]++;
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        int expected = std::count(deleted.begin(), deleted.end(), i) ? 0 : 1;
+        expected += std::count(sources.begin(), sources.end(), i) ? 1 : 0;
+        EXPECT_EQ(counts[i], expected) << "original particle " << i;
+    }
+    /** the sorted ids are the inverse of the unsorted ids. */
+    for (size_t i = 0; i != particles.real_particles_bound_; ++i)
+        EXPECT_EQ(particles.sorted_id_[particles.unsorted_id_[i]], i);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file 	test_particle_data_view.cpp
+ * @brief 	Layout and zero-copy access of the particle data views.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real resolution_ref = 0.1;
+Vec3d halfsize(0.5, 0.3, 0.2);
+BoundingBox system_domain_bounds(Vec3d(-0.6, -0.6, -0.6), Vec3d(0.6, 0.6, 0.6));
+
+/** component (i, r, c) of a view following its strides */
+template <typename ScalarType>
+ScalarType &viewComponent(ParticleVariableView &view, size_t i, size_t r = 0, size_t c = 0)
+{
+    size_t offset = i * view.strides_[0];
+    offset += view.Dimensions() > 1 ? r * view.strides_[1] : 0;
+    offset += view.Dimensions() > 2 ? c * view.strides_[2] : 0;
+    return *reinterpret_cast<ScalarType *>(static_cast<char *>(view.data_) + offset);
+}
+
+TEST(test_ParticleDataView, test_layout_and_zero_copy)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody block(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "Block"));
+    block.defineParticlesAndMaterial<ElasticSolidParticles, SaintVenantKirchhoffSolid>(1.0, 1.0, 0.3);
+    block.generateParticles<ParticleGeneratorLattice>();
+    ElasticSolidParticles &particles = *DynamicCast<ElasticSolidParticles>(this, &block.getBaseParticles());
+    size_t total_particles = particles.total_real_particles_;
+    /** non-symmetric matrices to check the column-major layout */
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        particles.F_[i] = Mat3d::Identity() + Real(i) * Mat3d::Ones();
+        particles.F_[i](1, 2) += Real(2 * i + 1);
+    }
+
+    ParticleDataView data_view(particles);
+    EXPECT_EQ(data_view.BodyName(), "Block");
+    EXPECT_EQ(data_view.TotalRealParticles(), total_particles);
+    EXPECT_TRUE(data_view.hasVariable("DeformationGradient"));
+    EXPECT_FALSE(data_view.hasVariable("NotAVariable"));
+
+    ParticleVariableView volume = data_view.getVariableView("VolumetricMeasure");
+    EXPECT_EQ(volume.scalar_type_, ParticleVariableView::ScalarType::Real);
+    EXPECT_EQ(volume.shape_, StdVec<size_t>({total_particles}));
+
+    ParticleVariableView position = data_view.getVariableView("Position");
+    EXPECT_EQ(position.shape_, StdVec<size_t>({total_particles, 3}));
+    EXPECT_EQ(position.strides_, StdVec<size_t>({sizeof(Vec3d), sizeof(Real)}));
+
+    ParticleVariableView deformation = data_view.getVariableView("DeformationGradient");
+    EXPECT_EQ(deformation.shape_, StdVec<size_t>({total_particles, 3, 3}));
+
+    ParticleVariableView indicator = data_view.getVariableView("Indicator");
+    EXPECT_EQ(indicator.scalar_type_, ParticleVariableView::ScalarType::Integer);
+
+    ParticleVariableView original_ids = data_view.OriginalParticleIds();
+    EXPECT_EQ(original_ids.scalar_type_, ParticleVariableView::ScalarType::Index);
+    EXPECT_EQ(original_ids.item_size_, sizeof(size_t));
+
+    for (size_t i = 0; i != total_particles; ++i)
+    {
+        EXPECT_EQ(viewComponent<Real>(volume, i), particles.Vol_[i]);
+        for (size_t r = 0; r != 3; ++r)
+        {
+            EXPECT_EQ(viewComponent<Real>(position, i, r), particles.pos_[i][r]);
+            for (size_t c = 0; c != 3; ++c)
+                EXPECT_EQ(viewComponent<Real>(deformation, i, r, c), particles.F_[i](r, c));
+        }
+        EXPECT_EQ(viewComponent<size_t>(original_ids, i), particles.unsorted_id_[i]);
+    }
+
+    /** modification through a view goes into the particle data */
+    viewComponent<Real>(position, total_particles - 1, 2) = 10.0;
+    EXPECT_EQ(particles.pos_[total_particles - 1][2], 10.0);
+
+    ParticleVariableSpan<Vecd> position_span = data_view.getVariableSpan<Vecd>("Position");
+    EXPECT_EQ(position_span.size(), total_particles);
+    EXPECT_EQ(position_span.data(), particles.pos_.data());
+    EXPECT_TRUE(data_view.isValid(position));
+    EXPECT_TRUE(data_view.isValid(position_span));
+
+    /** ghost particles within the capacity keep the views valid */
+    particles.reserveGhostParticles(particles.pos_.size() - particles.real_particles_bound_);
+    EXPECT_TRUE(data_view.isValid(position));
+    particles.total_ghost_particles_ = 0;
+
+    /** extending the particle data invalidates the views, which are taken anew */
+    particles.addBufferParticles(total_particles);
+    EXPECT_FALSE(data_view.isValid(position));
+    EXPECT_FALSE(data_view.isValid(position_span));
+    position_span = data_view.getVariableSpan<Vecd>("Position");
+    EXPECT_TRUE(data_view.isValid(position_span));
+    EXPECT_EQ(position_span.data(), particles.pos_.data());
+    EXPECT_EQ(position_span[total_particles - 1][2], 10.0);
+
+    /** so does a change of the number of real particles */
+    position = data_view.getVariableView("Position");
+    particles.total_real_particles_ -= 1;
+    EXPECT_FALSE(data_view.isValid(position));
+    particles.total_real_particles_ += 1;
+}
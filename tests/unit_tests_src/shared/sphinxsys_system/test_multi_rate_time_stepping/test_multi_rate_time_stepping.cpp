@@ -0,0 +1,122 @@
+/**
+ * @file 	test_multi_rate_time_stepping.cpp
+ * @brief 	Sub-step scheduling of bodies with different stable time steps.
+ * @author 	Xiangyu Hu
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real resolution_ref = 0.1;
+Vec3d halfsize(0.5, 0.3, 0.2);
+BoundingBox system_domain_bounds(Vec3d(-0.6, -0.6, -0.6), Vec3d(0.6, 0.6, 0.6));
+
+/** A stable time step size given as constant. */
+class FixedTimeStepSize : public BaseDynamics<Real>
+{
+  public:
+    FixedTimeStepSize(SPHBody &sph_body, Real time_step)
+        : BaseDynamics<Real>(sph_body), time_step_(time_step){};
+    virtual ~FixedTimeStepSize(){};
+    virtual Real exec(Real dt = 0.0) override { return time_step_; };
+
+  protected:
+    Real time_step_;
+};
+
+/** The sub-steps of a body, with the physical time at which each starts. */
+struct SubStepRecord
+{
+    StdVec<Real> start_times_;
+    StdVec<Real> time_steps_;
+    std::function<void(Real)> subStep()
+    {
+        return [&](Real dt)
+        {
+            start_times_.push_back(GlobalStaticVariables::physical_time_);
+            time_steps_.push_back(dt);
+        };
+    };
+    /** the sub-steps are contiguous from the start time and end at the end time. */
+    void checkContiguous(Real start_time, Real end_time, Real stable_time_step)
+    {
+        Real time = start_time;
+        for (size_t n = 0; n != time_steps_.size(); ++n)
+        {
+            EXPECT_NEAR(start_times_[n], time, 1.0e-12);
+            EXPECT_GT(time_steps_[n], 0.0);
+            EXPECT_LE(time_steps_[n], stable_time_step * (1.0 + 1.0e-8));
+            time += time_steps_[n];
+        }
+        EXPECT_NEAR(time, end_time, 1.0e-12);
+    };
+};
+
+TEST(test_MultiRateTimeStepping, test_sub_step_scheduling)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody slow_body(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "SlowBody"));
+    SolidBody fast_body(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "FastBody"));
+    FixedTimeStepSize slow_time_step(slow_body, 0.01);
+    FixedTimeStepSize fast_time_step(fast_body, 0.003);
+
+    SubStepRecord slow_record, fast_record;
+    StdVec<Real> coupling_intervals;
+    MultiRateTimeStepping multi_rate_time_stepping;
+    multi_rate_time_stepping.addBody(slow_time_step, slow_record.subStep())
+        .addCouplingDynamics([&](Real dt)
+                             { coupling_intervals.push_back(dt); });
+    MultiRateBody &fast = multi_rate_time_stepping.addBody(fast_time_step, fast_record.subStep());
+
+    GlobalStaticVariables::physical_time_ = 0.0;
+    Real end_time = 0.1;
+    size_t coupling_steps = multi_rate_time_stepping.integrateTo(end_time);
+    EXPECT_EQ(GlobalStaticVariables::physical_time_, end_time);
+
+    /** the coupling interval is the larger stable step, each split into equal fast sub-steps */
+    EXPECT_EQ(coupling_steps, 10u);
+    ASSERT_EQ(coupling_intervals.size(), 10u);
+    for (Real coupling_interval : coupling_intervals)
+        EXPECT_NEAR(coupling_interval, 0.01, 1.0e-12);
+    EXPECT_EQ(slow_record.time_steps_.size(), 10u);
+    EXPECT_EQ(fast.TotalSubSteps(), 40u);
+    for (Real dt : fast_record.time_steps_)
+        EXPECT_NEAR(dt, 0.0025, 1.0e-12);
+    slow_record.checkContiguous(0.0, end_time, 0.01);
+    fast_record.checkContiguous(0.0, end_time, 0.003);
+}
+
+TEST(test_MultiRateTimeStepping, test_coupling_interval_bounds)
+{
+    SPHSystem sph_system(system_domain_bounds, resolution_ref);
+    SolidBody slow_body(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "SlowBody"));
+    SolidBody fast_body(sph_system, makeShared<TransformShape<GeometricShapeBox>>(Transform(Vec3d::Zero()), halfsize, "FastBody"));
+    FixedTimeStepSize slow_time_step(slow_body, 0.05);
+    FixedTimeStepSize fast_time_step(fast_body, 0.001);
+
+    /** the coupling interval is limited by the step ratio, then by the given maximum */
+    SubStepRecord slow_record, fast_record;
+    MultiRateTimeStepping multi_rate_time_stepping(10);
+    MultiRateBody &slow = multi_rate_time_stepping.addBody(slow_time_step, slow_record.subStep());
+    MultiRateBody &fast = multi_rate_time_stepping.addBody(fast_time_step, fast_record.subStep());
+    GlobalStaticVariables::physical_time_ = 0.0;
+    EXPECT_EQ(multi_rate_time_stepping.integrateTo(0.1), 10u);
+    EXPECT_EQ(slow.TotalSubSteps(), 10u);
+    EXPECT_EQ(fast.TotalSubSteps(), 100u);
+
+    multi_rate_time_stepping.setMaximumCouplingInterval(0.004);
+    Real end_time = 0.12;
+    EXPECT_EQ(multi_rate_time_stepping.integrateTo(end_time), 5u);
+    EXPECT_EQ(multi_rate_time_stepping.TotalCouplingSteps(), 15u);
+    EXPECT_EQ(slow.TotalSubSteps(), 15u);
+    EXPECT_EQ(fast.TotalSubSteps(), 120u);
+    slow_record.checkContiguous(0.0, end_time, 0.05);
+    fast_record.checkContiguous(0.0, end_time, 0.001);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}